@@ -0,0 +1,84 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - async_overlap                                                  *
+ *  Overlapping asynchronous matrix operations with simulated I/O              *
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <thread>
+
+#include <SymmetricMatrixParallel.h>
+#include <eigen3/Eigen/Eigen>
+
+// Time that one simulated I/O request blocks the caller
+static const std::chrono::milliseconds ioLatency(20);
+
+/**
+ * Simulate a blocking I/O request like reading the next event from disk
+ */
+static void simulateIO() {
+    std::this_thread::sleep_for(ioLatency);
+}
+
+/**
+ * Multiply and invert, then do I/O. The caller waits for everything.
+ */
+template<typename Scalar>
+void BM_Sequential(benchmark::State& state) {
+    SymmetricMatrix<Scalar> mat1
+        = SymmetricMatrix<Scalar>::Random(state.range(0));
+    SymmetricMatrix<Scalar> mat2
+        = SymmetricMatrix<Scalar>::Random(state.range(0));
+    Eigen::Matrix<Scalar, -1, -1> prod;
+    SymmetricMatrix<Scalar> inv;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(prod = mat1 * mat2);
+        benchmark::DoNotOptimize(inv = inverseAsync(mat1).get());
+        simulateIO();
+    }
+}
+
+/**
+ * Start multiplication and inversion on the shared pool, do I/O in the
+ * meantime and collect the results afterwards.
+ */
+template<typename Scalar>
+void BM_Overlapped(benchmark::State& state) {
+    SymmetricMatrix<Scalar> mat1
+        = SymmetricMatrix<Scalar>::Random(state.range(0));
+    SymmetricMatrix<Scalar> mat2
+        = SymmetricMatrix<Scalar>::Random(state.range(0));
+    Eigen::Matrix<Scalar, -1, -1> prod;
+    SymmetricMatrix<Scalar> inv;
+
+    for (auto _ : state) {
+        auto futureProd = multiplyAsync(mat1, mat2);
+        auto futureInv = inverseAsync(mat1);
+        simulateIO();
+        benchmark::DoNotOptimize(prod = futureProd.get());
+        benchmark::DoNotOptimize(inv = futureInv.get());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_Sequential, double) -> Unit(benchmark::kMillisecond)
+    -> Args({100})
+    -> Args({250})
+    -> Args({500})
+    -> Args({1000})
+    -> UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_Overlapped, double) -> Unit(benchmark::kMillisecond)
+    -> Args({100})
+    -> Args({250})
+    -> Args({500})
+    -> Args({1000})
+    -> UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - cached_solve                                                   *
+ *  Repeated solves with the same covariance with and without caching          *
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <SymmetricMatrix.h>
+#include <eigen3/Eigen/Eigen>
+
+static SymmetricMatrix<double> spdMatrix(int dim) {
+    Eigen::MatrixXd mat = Eigen::MatrixXd::Random(dim, dim);
+    mat = mat * mat.transpose();
+    mat.diagonal().array() += 1.0;
+    return SymmetricMatrix<double>(mat);
+}
+
+/**
+ * Solve by expanding the matrix and inverting it, i.e., what every solve
+ * costs without a solve member
+ */
+void BM_SolveExpandInverse(benchmark::State& state) {
+    SymmetricMatrix<double> sym = spdMatrix(state.range(0));
+    const Eigen::VectorXd b = Eigen::VectorXd::Random(state.range(0));
+    Eigen::VectorXd x;
+
+    for (auto _ : state) {
+        x = sym.constructEigenMatrix().inverse() * b;
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+
+/**
+ * Solve that factorizes the packed storage on every call
+ */
+void BM_SolvePacked(benchmark::State& state) {
+    const SymmetricMatrix<double> sym = spdMatrix(state.range(0));
+    const Eigen::VectorXd b = Eigen::VectorXd::Random(state.range(0));
+    Eigen::VectorXd x;
+
+    for (auto _ : state) {
+        x = sym.solve(b);
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+
+/**
+ * Solve with the factor kept between calls
+ */
+void BM_SolveCached(benchmark::State& state) {
+    SymmetricMatrix<double> sym = spdMatrix(state.range(0));
+    sym.cacheFactorization();
+    const Eigen::VectorXd b = Eigen::VectorXd::Random(state.range(0));
+    Eigen::VectorXd x;
+
+    for (auto _ : state) {
+        x = sym.solve(b);
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+
+/**
+ * Chi-square of a residual with the factor kept between calls
+ */
+void BM_Chi2Cached(benchmark::State& state) {
+    SymmetricMatrix<double> sym = spdMatrix(state.range(0));
+    sym.cacheFactorization();
+    const Eigen::VectorXd r = Eigen::VectorXd::Random(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sym.chi2(r));
+    }
+}
+
+BENCHMARK(BM_SolveExpandInverse)
+    -> Args({10})
+    -> Args({100})
+    -> Args({500});
+
+BENCHMARK(BM_SolvePacked)
+    -> Args({10})
+    -> Args({100})
+    -> Args({500});
+
+BENCHMARK(BM_SolveCached)
+    -> Args({10})
+    -> Args({100})
+    -> Args({500});
+
+BENCHMARK(BM_Chi2Cached)
+    -> Args({10})
+    -> Args({100})
+    -> Args({500});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - cholesky_update                                                *
+ *  Refactorization versus rank-1 update of a Cholesky factorization          *
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <SymmetricMatrixDecomposition.h>
+#include <eigen3/Eigen/Eigen>
+
+static Eigen::MatrixXd spdMatrix(int dim) {
+    Eigen::MatrixXd mat = Eigen::MatrixXd::Random(dim, dim);
+    mat = mat * mat.transpose();
+    mat.diagonal().array() += 1.0;
+    return mat;
+}
+
+/**
+ * Refactorization of the normal equations after one measurement was removed
+ * with Eigen::LLT
+ */
+void BM_RefactorizeDense(benchmark::State& state) {
+    const Eigen::MatrixXd mat = spdMatrix(state.range(0));
+    Eigen::LLT<Eigen::MatrixXd> llt;
+
+    for (auto _ : state) {
+        llt.compute(mat);
+        benchmark::DoNotOptimize(llt.matrixLLT().data());
+    }
+}
+
+/**
+ * Same with SymmetricLLT, which factorizes the packed storage
+ */
+void BM_RefactorizePacked(benchmark::State& state) {
+    SymmetricMatrix<double> sym(spdMatrix(state.range(0)));
+    SymmetricLLT<double> llt;
+
+    for (auto _ : state) {
+        llt.compute(sym);
+        benchmark::DoNotOptimize(llt.info());
+    }
+}
+
+/**
+ * Alternating update and downdate of the factor of Eigen::LLT
+ */
+void BM_UpdateDense(benchmark::State& state) {
+    Eigen::LLT<Eigen::MatrixXd> llt(spdMatrix(state.range(0)));
+    const Eigen::VectorXd x = Eigen::VectorXd::Random(state.range(0));
+
+    for (auto _ : state) {
+        llt.rankUpdate(x, 0.01);
+        llt.rankUpdate(x, -0.01);
+        benchmark::DoNotOptimize(llt.matrixLLT().data());
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+/**
+ * Alternating update and downdate of the packed factor of SymmetricLLT
+ */
+void BM_UpdatePacked(benchmark::State& state) {
+    SymmetricMatrix<double> sym(spdMatrix(state.range(0)));
+    SymmetricLLT<double> llt(sym);
+    const Eigen::VectorXd x = Eigen::VectorXd::Random(state.range(0));
+
+    for (auto _ : state) {
+        llt.choleskyUpdate(x, 0.01);
+        llt.choleskyUpdate(x, -0.01);
+        benchmark::DoNotOptimize(llt.info());
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+BENCHMARK(BM_RefactorizeDense)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK(BM_RefactorizePacked)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK(BM_UpdateDense)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK(BM_UpdatePacked)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - conjugate_gradient                                             *
+ *  Conjugate gradient on dense matrices and on packed matrix-free operators   *
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <SymmetricMatrixParallel.h>
+#include <eigen3/Eigen/Eigen>
+
+/**
+ * Diagonally dominant test problem, so that the number of iterations is small
+ * and about the same for all dimensions
+ */
+static Eigen::MatrixXd spdMatrix(int dim) {
+    Eigen::MatrixXd mat = Eigen::MatrixXd::Random(dim, dim);
+    mat = (mat + mat.transpose()).eval();
+    mat.diagonal().array() += 2.0 * dim;
+    return mat;
+}
+
+/**
+ * Product with the packed operator only, the first argument is the
+ * dimension, the second the number of threads
+ */
+void BM_OperatorProduct(benchmark::State& state) {
+    SymmetricMatrix<double> sym(spdMatrix(state.range(0)));
+    SymmetricMatrixOperator<double> op(sym, state.range(1));
+    Eigen::VectorXd x = Eigen::VectorXd::Random(state.range(0));
+    Eigen::VectorXd y(state.range(0));
+
+    for (auto _ : state) {
+        y.noalias() = op * x;
+        benchmark::DoNotOptimize(y.data());
+    }
+    // Every packed element is read once
+    state.SetBytesProcessed(state.iterations() * state.range(0)
+                            * (state.range(0) + 1) / 2 * sizeof(double));
+}
+
+void BM_DenseProduct(benchmark::State& state) {
+    Eigen::MatrixXd mat = spdMatrix(state.range(0));
+    Eigen::VectorXd x = Eigen::VectorXd::Random(state.range(0));
+    Eigen::VectorXd y(state.range(0));
+
+    for (auto _ : state) {
+        y.noalias() = mat.selfadjointView<Eigen::Lower>() * x;
+        benchmark::DoNotOptimize(y.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0)
+                            * state.range(0) * sizeof(double));
+}
+
+void BM_DenseCG(benchmark::State& state) {
+    Eigen::MatrixXd mat = spdMatrix(state.range(0));
+    Eigen::VectorXd b = Eigen::VectorXd::Random(state.range(0));
+    Eigen::VectorXd x;
+
+    for (auto _ : state) {
+        Eigen::ConjugateGradient<Eigen::MatrixXd, Eigen::Lower | Eigen::Upper>
+            solver(mat);
+        x = solver.solve(b);
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+
+void BM_PackedCG(benchmark::State& state) {
+    SymmetricMatrix<double> sym(spdMatrix(state.range(0)));
+    Eigen::VectorXd b = Eigen::VectorXd::Random(state.range(0));
+    Eigen::VectorXd x;
+
+    for (auto _ : state) {
+        SymmetricMatrixOperator<double> op(sym, state.range(1));
+        Eigen::ConjugateGradient<SymmetricMatrixOperator<double>,
+                                 Eigen::Lower | Eigen::Upper,
+                                 SymmetricJacobiPreconditioner<double> >
+            solver(op);
+        x = solver.solve(b);
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+
+BENCHMARK(BM_DenseProduct)
+    -> Args({500})
+    -> Args({2000})
+    -> Args({5000});
+
+BENCHMARK(BM_OperatorProduct)
+    -> Args({500, 1})
+    -> Args({2000, 1})
+    -> Args({2000, 4})
+    -> Args({5000, 1})
+    -> Args({5000, 4});
+
+BENCHMARK(BM_DenseCG)
+    -> Args({500})
+    -> Args({2000});
+
+BENCHMARK(BM_PackedCG)
+    -> Args({500, 1})
+    -> Args({2000, 1})
+    -> Args({2000, 4});
+
+BENCHMARK_MAIN();
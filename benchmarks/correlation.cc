@@ -0,0 +1,100 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - correlation                                                    *
+ *  Covariance to correlation conversion in dense and packed storage           *
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <SymmetricMatrixBatch.h>
+#include <eigen3/Eigen/Eigen>
+
+/**
+ * Make an instance of Eigen::Matrix symmetric and positive definite
+ */
+template<typename Scalar, int Dimension>
+Eigen::Matrix<Scalar, Dimension, Dimension>
+randomPositiveDefinite() {
+    Eigen::Matrix<Scalar, Dimension, Dimension> mat
+        = Eigen::Matrix<Scalar, Dimension, Dimension>::Random();
+    mat = mat * mat.transpose();
+    mat.diagonal().array() += Scalar(1);
+    for (int i = 0; i < mat.rows(); ++i) {
+        for (int j = i; j < mat.cols(); ++j) {
+            mat(i, j) = mat(j, i);
+        }
+    }
+    return mat;
+}
+
+/**
+ * Expand to a dense matrix and scale element by element
+ */
+template<typename Scalar, int Dimension>
+void BM_CorrelationDense(benchmark::State& state) {
+    SymmetricMatrix<Scalar, Dimension> C(
+        randomPositiveDefinite<Scalar, Dimension>());
+    for (auto _ : state) {
+        Eigen::Matrix<Scalar, Dimension, Dimension> dense
+            = C.constructEigenMatrix();
+        for (int i = 0; i < Dimension; ++i) {
+            for (int j = 0; j < Dimension; ++j) {
+                dense(i, j) /= std::sqrt(C(i, i) * C(j, j));
+            }
+        }
+        SymmetricMatrix<Scalar, Dimension> R(dense);
+        benchmark::DoNotOptimize(R.data());
+    }
+}
+
+/**
+ * Scale the packed rows directly
+ */
+template<typename Scalar, int Dimension>
+void BM_CorrelationPacked(benchmark::State& state) {
+    SymmetricMatrix<Scalar, Dimension> C(
+        randomPositiveDefinite<Scalar, Dimension>());
+    for (auto _ : state) {
+        SymmetricMatrix<Scalar, Dimension> R = C.correlation();
+        benchmark::DoNotOptimize(R.data());
+    }
+}
+
+/**
+ * Convert a whole batch in place, one matrix per SIMD lane
+ */
+template<typename Scalar, int Dimension>
+void BM_CorrelationBatch(benchmark::State& state) {
+    const size_t count = state.range(0);
+    std::vector<SymmetricMatrix<Scalar, Dimension> > mats(count,
+        SymmetricMatrix<Scalar, Dimension>(
+            randomPositiveDefinite<Scalar, Dimension>()));
+    SymmetricMatrixBatch<Scalar, Dimension> C(mats);
+    SymmetricMatrixBatch<Scalar, Dimension> R;
+    for (auto _ : state) {
+        R = C.correlation();
+        benchmark::DoNotOptimize(R.element(0));
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK_TEMPLATE(BM_CorrelationDense, double, 5);
+BENCHMARK_TEMPLATE(BM_CorrelationPacked, double, 5);
+BENCHMARK_TEMPLATE(BM_CorrelationDense, double, 12);
+BENCHMARK_TEMPLATE(BM_CorrelationPacked, double, 12);
+
+BENCHMARK_TEMPLATE(BM_CorrelationBatch, double, 5)
+    -> Args({1000})
+    -> Args({100000});
+
+BENCHMARK_TEMPLATE(BM_CorrelationBatch, float, 5)
+    -> Args({1000})
+    -> Args({100000});
+
+BENCHMARK_MAIN();
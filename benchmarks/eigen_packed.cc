@@ -0,0 +1,196 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - eigen_packed                                                   *
+ *  Eigendecomposition from packed storage vs. a dense copy                    *
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <SymmetricMatrixDecomposition.h>
+#include <eigen3/Eigen/Eigen>
+
+/**
+ * Expand to an Eigen::Matrix and use Eigen::SelfAdjointEigenSolver
+ */
+static void BM_EigenDense(benchmark::State& state) {
+    const int dim = state.range(0);
+    const int options = state.range(1) ? Eigen::ComputeEigenvectors
+                                        : Eigen::EigenvaluesOnly;
+    Eigen::MatrixXd mat = Eigen::MatrixXd::Random(dim, dim);
+    SymmetricMatrix<double> sym(Eigen::MatrixXd(mat + mat.transpose()));
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver;
+    for (auto _ : state) {
+        solver.compute(sym.constructEigenMatrix(), options);
+        benchmark::DoNotOptimize(solver.eigenvalues().data());
+    }
+}
+
+/**
+ * Tridiagonalize in packed storage with SymmetricEigenSolver
+ */
+static void BM_EigenPacked(benchmark::State& state) {
+    const int dim = state.range(0);
+    const int options = state.range(1) ? Eigen::ComputeEigenvectors
+                                        : Eigen::EigenvaluesOnly;
+    Eigen::MatrixXd mat = Eigen::MatrixXd::Random(dim, dim);
+    SymmetricMatrix<double> sym(Eigen::MatrixXd(mat + mat.transpose()));
+    SymmetricEigenSolver<double> solver;
+    for (auto _ : state) {
+        solver.compute(sym, options);
+        benchmark::DoNotOptimize(solver.eigenvalues().data());
+    }
+}
+
+/**
+ * Closed-form eigendecomposition of many 3x3 matrices with
+ * Eigen::SelfAdjointEigenSolver::computeDirect()
+ */
+static void BM_EigenDirectDense(benchmark::State& state) {
+    const size_t count = state.range(0);
+    std::vector<Eigen::Matrix3d, Eigen::aligned_allocator<Eigen::Matrix3d> >
+        mats(count);
+    for (size_t t = 0; t < count; ++t) {
+        Eigen::Matrix3d mat = Eigen::Matrix3d::Random();
+        mats[t] = mat + mat.transpose();
+    }
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+    for (auto _ : state) {
+        for (size_t t = 0; t < count; ++t) {
+            solver.computeDirect(mats[t]);
+            benchmark::DoNotOptimize(solver.eigenvectors().data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+/**
+ * Closed-form eigendecomposition of many 3x3 matrices in a
+ * SymmetricMatrixBatch, one matrix per SIMD lane
+ */
+static void BM_EigenDirectBatch(benchmark::State& state) {
+    const size_t count = state.range(0);
+    SymmetricMatrixBatch<double, 3> batch(count);
+    batch.packed().setRandom();
+    Eigen::Array<double, 3, Eigen::Dynamic, Eigen::RowMajor> values;
+    Eigen::Array<double, 9, Eigen::Dynamic, Eigen::RowMajor> vectors;
+    for (auto _ : state) {
+        eigenDirect(batch, values, &vectors);
+        benchmark::DoNotOptimize(vectors.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+/**
+ * Square root of a positive definite matrix with
+ * Eigen::SelfAdjointEigenSolver::operatorSqrt()
+ */
+static void BM_SqrtDense(benchmark::State& state) {
+    const int dim = state.range(0);
+    Eigen::MatrixXd mat = Eigen::MatrixXd::Random(dim, dim);
+    SymmetricMatrix<double> sym(Eigen::MatrixXd(mat * mat.transpose()
+        + Eigen::MatrixXd::Identity(dim, dim)));
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver;
+    for (auto _ : state) {
+        solver.compute(sym.constructEigenMatrix());
+        Eigen::MatrixXd root = solver.operatorSqrt();
+        benchmark::DoNotOptimize(root.data());
+    }
+}
+
+/**
+ * Square root of a positive definite matrix with SymmetricMatrix::sqrt()
+ */
+static void BM_SqrtPacked(benchmark::State& state) {
+    const int dim = state.range(0);
+    Eigen::MatrixXd mat = Eigen::MatrixXd::Random(dim, dim);
+    SymmetricMatrix<double> sym(Eigen::MatrixXd(mat * mat.transpose()
+        + Eigen::MatrixXd::Identity(dim, dim)));
+    for (auto _ : state) {
+        SymmetricMatrix<double> root = sym.sqrt();
+        benchmark::DoNotOptimize(root.data());
+    }
+}
+
+/**
+ * Inverse square root of many 3x3 matrices with
+ * Eigen::SelfAdjointEigenSolver::computeDirect()
+ */
+static void BM_InverseSqrtDirectDense(benchmark::State& state) {
+    const size_t count = state.range(0);
+    std::vector<Eigen::Matrix3d, Eigen::aligned_allocator<Eigen::Matrix3d> >
+        mats(count);
+    for (size_t t = 0; t < count; ++t) {
+        Eigen::Matrix3d mat = Eigen::Matrix3d::Random();
+        mats[t] = mat * mat.transpose() + Eigen::Matrix3d::Identity();
+    }
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+    for (auto _ : state) {
+        for (size_t t = 0; t < count; ++t) {
+            solver.computeDirect(mats[t]);
+            Eigen::Matrix3d root = solver.operatorInverseSqrt();
+            benchmark::DoNotOptimize(root.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+/**
+ * Inverse square root of many 3x3 matrices with
+ * SymmetricMatrix::inverseSqrt()
+ */
+static void BM_InverseSqrtDirectPacked(benchmark::State& state) {
+    const size_t count = state.range(0);
+    std::vector<SymmetricMatrix<double, 3> > mats;
+    for (size_t t = 0; t < count; ++t) {
+        Eigen::Matrix3d mat = Eigen::Matrix3d::Random();
+        mats.push_back(SymmetricMatrix<double, 3>(Eigen::Matrix3d(
+            mat * mat.transpose() + Eigen::Matrix3d::Identity())));
+    }
+    for (auto _ : state) {
+        for (size_t t = 0; t < count; ++t) {
+            SymmetricMatrix<double, 3> root = mats[t].inverseSqrt();
+            benchmark::DoNotOptimize(root.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_EigenDense)
+    -> Args({100, 0})
+    -> Args({100, 1})
+    -> Args({500, 0})
+    -> Args({500, 1});
+
+BENCHMARK(BM_EigenPacked)
+    -> Args({100, 0})
+    -> Args({100, 1})
+    -> Args({500, 0})
+    -> Args({500, 1});
+
+BENCHMARK(BM_EigenDirectDense)
+    -> Args({10000});
+
+BENCHMARK(BM_EigenDirectBatch)
+    -> Args({10000});
+
+BENCHMARK(BM_SqrtDense)
+    -> Args({10})
+    -> Args({100});
+
+BENCHMARK(BM_SqrtPacked)
+    -> Args({10})
+    -> Args({100});
+
+BENCHMARK(BM_InverseSqrtDirectDense)
+    -> Args({10000});
+
+BENCHMARK(BM_InverseSqrtDirectPacked)
+    -> Args({10000});
+
+BENCHMARK_MAIN();
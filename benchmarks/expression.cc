@@ -0,0 +1,98 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - expression                                                     *
+ *  SymmetricMatrix as operand of Eigen expressions versus explicit expansion  *
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <SymmetricMatrix.h>
+#include <eigen3/Eigen/Eigen>
+
+/**
+ * Product with a vector after expanding the packed storage
+ */
+void BM_ProductExpand(benchmark::State& state) {
+    SymmetricMatrix<double> sym = SymmetricMatrix<double>::Random(
+        state.range(0));
+    const Eigen::VectorXd x = Eigen::VectorXd::Random(state.range(0));
+    Eigen::VectorXd y(state.range(0));
+
+    for (auto _ : state) {
+        y.noalias() = sym.constructEigenMatrix() * x;
+        benchmark::DoNotOptimize(y.data());
+    }
+}
+
+/**
+ * Product with a vector as Eigen expression on the packed storage
+ */
+void BM_ProductExpression(benchmark::State& state) {
+    const SymmetricMatrix<double> sym = SymmetricMatrix<double>::Random(
+        state.range(0));
+    const Eigen::VectorXd x = Eigen::VectorXd::Random(state.range(0));
+    Eigen::VectorXd y(state.range(0));
+
+    for (auto _ : state) {
+        y.noalias() = sym * x;
+        benchmark::DoNotOptimize(y.data());
+    }
+}
+
+/**
+ * Sum with an Eigen::Matrix after expanding the packed storage
+ */
+void BM_SumExpand(benchmark::State& state) {
+    SymmetricMatrix<double> sym = SymmetricMatrix<double>::Random(
+        state.range(0));
+    const Eigen::MatrixXd mat = Eigen::MatrixXd::Random(state.range(0),
+                                                        state.range(0));
+    Eigen::MatrixXd ret(state.range(0), state.range(0));
+
+    for (auto _ : state) {
+        ret = mat + sym.constructEigenMatrix();
+        benchmark::DoNotOptimize(ret.data());
+    }
+}
+
+/**
+ * Sum with an Eigen::Matrix as Eigen expression on the packed storage
+ */
+void BM_SumExpression(benchmark::State& state) {
+    const SymmetricMatrix<double> sym = SymmetricMatrix<double>::Random(
+        state.range(0));
+    const Eigen::MatrixXd mat = Eigen::MatrixXd::Random(state.range(0),
+                                                        state.range(0));
+    Eigen::MatrixXd ret(state.range(0), state.range(0));
+
+    for (auto _ : state) {
+        ret = mat + sym;
+        benchmark::DoNotOptimize(ret.data());
+    }
+}
+
+BENCHMARK(BM_ProductExpand)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK(BM_ProductExpression)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK(BM_SumExpand)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK(BM_SumExpression)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - kalman_batch                                                   *
+ *  Kalman filter on one track at a time vs. many tracks per SIMD instruction  *
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <SymmetricMatrixKalman.h>
+#include <eigen3/Eigen/Eigen>
+
+/**
+ * Make an instance of Eigen::Matrix symmetric and positive definite
+ */
+template<typename Scalar, int Dimension>
+Eigen::Matrix<Scalar, Dimension, Dimension>
+randomPositiveDefinite() {
+    Eigen::Matrix<Scalar, Dimension, Dimension> mat
+        = Eigen::Matrix<Scalar, Dimension, Dimension>::Random();
+    mat = mat * mat.transpose();
+    mat.diagonal().array() += Scalar(1);
+    for (int i = 0; i < mat.rows(); ++i) {
+        for (int j = i; j < mat.cols(); ++j) {
+            mat(i, j) = mat(j, i);
+        }
+    }
+    return mat;
+}
+
+/**
+ * Measurement update of every track with its own KalmanUpdate object
+ */
+template<typename Scalar>
+void BM_UpdatePerTrack(benchmark::State& state) {
+    const size_t count = state.range(0);
+    std::vector<SymmetricMatrix<Scalar, 5> > C(count);
+    std::vector<SymmetricMatrix<Scalar, 2> > V(count);
+    std::vector<Eigen::Matrix<Scalar, 5, 1> > x(count);
+    std::vector<Eigen::Matrix<Scalar, 2, 1> > m(count);
+    Eigen::Matrix<Scalar, 2, 5> H = Eigen::Matrix<Scalar, 2, 5>::Random();
+    for (size_t t = 0; t < count; ++t) {
+        C[t] = SymmetricMatrix<Scalar, 5>(randomPositiveDefinite<Scalar, 5>());
+        V[t] = SymmetricMatrix<Scalar, 2>(randomPositiveDefinite<Scalar, 2>());
+        x[t] = Eigen::Matrix<Scalar, 5, 1>::Random();
+        m[t] = Eigen::Matrix<Scalar, 2, 1>::Random();
+    }
+    KalmanUpdate<Scalar, 5, 2> update;
+
+    for (auto _ : state) {
+        for (size_t t = 0; t < count; ++t) {
+            update.compute(C[t], x[t], H, V[t], m[t]);
+            benchmark::DoNotOptimize(update.chi2());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+/**
+ * Measurement update of all tracks with BatchKalmanFilter
+ */
+template<typename Scalar>
+void BM_UpdateBatch(benchmark::State& state) {
+    typedef BatchKalmanFilter<Scalar, 5, 2> Filter;
+    const size_t count = state.range(0);
+    Filter filter(count);
+    typename Filter::ProjectionBatch H(10, count);
+    typename Filter::MeasurementCovarianceBatch V(count);
+    typename Filter::MeasurementBatch m(2, count);
+    Eigen::Matrix<Scalar, 2, 5> projection
+        = Eigen::Matrix<Scalar, 2, 5>::Random();
+    for (size_t t = 0; t < count; ++t) {
+        filter.setTrack(t, Eigen::Matrix<Scalar, 5, 1>::Random(),
+                        SymmetricMatrix<Scalar, 5>(
+                            randomPositiveDefinite<Scalar, 5>()));
+        V.set(t, SymmetricMatrix<Scalar, 2>(
+            randomPositiveDefinite<Scalar, 2>()));
+        m.col(t) = Eigen::Matrix<Scalar, 2, 1>::Random();
+        for (int a = 0; a < 2; ++a) {
+            for (int k = 0; k < 5; ++k) {
+                H(a * 5 + k, t) = projection(a, k);
+            }
+        }
+    }
+    typename Filter::CovarianceBatch C = filter.covariances();
+    typename Filter::StateBatch x = filter.states();
+
+    for (auto _ : state) {
+        // Start every iteration from the same tracks
+        state.PauseTiming();
+        filter.covariances() = C;
+        filter.states() = x;
+        state.ResumeTiming();
+        filter.update(H, V, m);
+        benchmark::DoNotOptimize(filter.chi2().data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+/**
+ * Prediction of all tracks with BatchKalmanFilter
+ */
+template<typename Scalar>
+void BM_PredictBatch(benchmark::State& state) {
+    typedef BatchKalmanFilter<Scalar, 5, 2> Filter;
+    const size_t count = state.range(0);
+    Filter filter(count);
+    typename Filter::JacobianBatch F(25, count);
+    typename Filter::CovarianceBatch Q(count);
+    for (size_t t = 0; t < count; ++t) {
+        filter.setTrack(t, Eigen::Matrix<Scalar, 5, 1>::Random(),
+                        SymmetricMatrix<Scalar, 5>(
+                            randomPositiveDefinite<Scalar, 5>()));
+        Eigen::Matrix<Scalar, 5, 5> noise
+            = Scalar(1e-3) * randomPositiveDefinite<Scalar, 5>();
+        Q.set(t, SymmetricMatrix<Scalar, 5>(noise));
+    }
+    F.setZero();
+    for (int i = 0; i < 5; ++i) {
+        F.row(i * 5 + i).setOnes();
+    }
+
+    for (auto _ : state) {
+        filter.predict(F, Q);
+        benchmark::DoNotOptimize(filter.covariances().element(0));
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK_TEMPLATE(BM_UpdatePerTrack, double)
+    -> Args({1000})
+    -> Args({10000});
+
+BENCHMARK_TEMPLATE(BM_UpdateBatch, double)
+    -> Args({1000})
+    -> Args({10000});
+
+BENCHMARK_TEMPLATE(BM_PredictBatch, double)
+    -> Args({1000})
+    -> Args({10000});
+
+BENCHMARK_TEMPLATE(BM_UpdatePerTrack, float)
+    -> Args({1000})
+    -> Args({10000});
+
+BENCHMARK_TEMPLATE(BM_UpdateBatch, float)
+    -> Args({1000})
+    -> Args({10000});
+
+BENCHMARK_MAIN();
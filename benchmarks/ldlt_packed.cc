@@ -0,0 +1,71 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - ldlt_packed                                                    *
+ *  Indefinite LDL^T factorization in packed storage vs. a dense copy          *
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <SymmetricMatrixDecomposition.h>
+#include <eigen3/Eigen/Eigen>
+
+/**
+ * KKT matrix [I A^T; A 0] with m = dim / 4 constraints
+ */
+static SymmetricMatrix<double> kktMatrix(int dim) {
+    const int m = dim / 4;
+    Eigen::MatrixXd mat = Eigen::MatrixXd::Identity(dim, dim);
+    mat.bottomLeftCorner(m, dim - m) = Eigen::MatrixXd::Random(m, dim - m);
+    mat.topRightCorner(dim - m, m) = mat.bottomLeftCorner(m, dim - m)
+                                        .transpose();
+    mat.bottomRightCorner(m, m).setZero();
+    return SymmetricMatrix<double>(mat);
+}
+
+/**
+ * Expand to an Eigen::Matrix and use Eigen::LDLT
+ */
+static void BM_LDLTDense(benchmark::State& state) {
+    const int dim = state.range(0);
+    SymmetricMatrix<double> sym = kktMatrix(dim);
+    const Eigen::VectorXd b = Eigen::VectorXd::Random(dim);
+    Eigen::LDLT<Eigen::MatrixXd> ldlt;
+    for (auto _ : state) {
+        ldlt.compute(sym.constructEigenMatrix());
+        Eigen::VectorXd x = ldlt.solve(b);
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+
+/**
+ * Bunch-Kaufman factorization in packed storage with SymmetricLDLT
+ */
+static void BM_LDLTPacked(benchmark::State& state) {
+    const int dim = state.range(0);
+    SymmetricMatrix<double> sym = kktMatrix(dim);
+    const Eigen::VectorXd b = Eigen::VectorXd::Random(dim);
+    SymmetricLDLT<double> ldlt;
+    for (auto _ : state) {
+        ldlt.compute(sym);
+        Eigen::VectorXd x = ldlt.solve(b);
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+
+BENCHMARK(BM_LDLTDense)
+    -> Args({10})
+    -> Args({100})
+    -> Args({500})
+    -> Args({1000});
+
+BENCHMARK(BM_LDLTPacked)
+    -> Args({10})
+    -> Args({100})
+    -> Args({500})
+    -> Args({1000});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - linear_combination                                             *
+ *  Damping and blending of covariances with and without fused kernels         *
+ ******************************************************************************/
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <SymmetricMatrix.h>
+#include <eigen3/Eigen/Eigen>
+
+/**
+ * Blending a S1 + b S2 through Eigen expressions and packing the result
+ */
+void BM_BlendExpression(benchmark::State& state) {
+    const SymmetricMatrix<double> sym1 = SymmetricMatrix<double>::Random(
+        state.range(0));
+    const SymmetricMatrix<double> sym2 = SymmetricMatrix<double>::Random(
+        state.range(0));
+    SymmetricMatrix<double> result;
+
+    for (auto _ : state) {
+        result = SymmetricMatrix<double>(
+            Eigen::MatrixXd(0.3 * sym1 + 0.7 * sym2));
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+/**
+ * Blending a S1 + b S2 in place by axpby()
+ */
+void BM_BlendAxpby(benchmark::State& state) {
+    const SymmetricMatrix<double> sym1 = SymmetricMatrix<double>::Random(
+        state.range(0));
+    SymmetricMatrix<double> sym2 = SymmetricMatrix<double>::Random(
+        state.range(0));
+
+    for (auto _ : state) {
+        sym2.axpby(0.3, sym1, 0.7);
+        benchmark::DoNotOptimize(sym2.data());
+    }
+}
+
+/**
+ * Blending of four matrices by repeated operator+= on scaled copies
+ */
+void BM_CombinationRepeated(benchmark::State& state) {
+    std::vector<SymmetricMatrix<double> > syms;
+    for (int k = 0; k < 4; ++k) {
+        syms.push_back(SymmetricMatrix<double>::Random(state.range(0)));
+    }
+    SymmetricMatrix<double> result;
+
+    for (auto _ : state) {
+        result = syms[0];
+        for (int k = 1; k < 4; ++k) {
+            SymmetricMatrix<double> scaled = syms[k];
+            scaled.axpby(0.25, syms[k], 0.0);
+            result += scaled;
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+/**
+ * Blending of four matrices by linearCombination()
+ */
+void BM_CombinationFused(benchmark::State& state) {
+    std::vector<SymmetricMatrix<double> > syms;
+    for (int k = 0; k < 4; ++k) {
+        syms.push_back(SymmetricMatrix<double>::Random(state.range(0)));
+    }
+    const std::vector<double> coefficients(4, 0.25);
+    std::vector<const SymmetricMatrix<double>*> matrices;
+    for (int k = 0; k < 4; ++k) {
+        matrices.push_back(&syms[k]);
+    }
+    SymmetricMatrix<double> result;
+
+    for (auto _ : state) {
+        result = SymmetricMatrix<double>::linearCombination(coefficients,
+                                                            matrices);
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+/**
+ * Damping S + lambda I through an Eigen expression and packing the result
+ */
+void BM_DampingExpression(benchmark::State& state) {
+    const SymmetricMatrix<double> sym = SymmetricMatrix<double>::Random(
+        state.range(0));
+    SymmetricMatrix<double> result;
+
+    for (auto _ : state) {
+        result = SymmetricMatrix<double>(Eigen::MatrixXd(
+            sym + 1e-3 * Eigen::MatrixXd::Identity(state.range(0),
+                                                  state.range(0))));
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+/**
+ * Damping S + lambda I in place by addDiagonal()
+ */
+void BM_DampingDiagonal(benchmark::State& state) {
+    SymmetricMatrix<double> sym = SymmetricMatrix<double>::Random(
+        state.range(0));
+
+    for (auto _ : state) {
+        sym.addDiagonal(1e-3);
+        benchmark::DoNotOptimize(sym.data());
+    }
+}
+
+BENCHMARK(BM_BlendExpression)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK(BM_BlendAxpby)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK(BM_CombinationRepeated)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK(BM_CombinationFused)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK(BM_DampingExpression)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK(BM_DampingDiagonal)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - log_determinant                                                *
+ *  Log-determinants of many covariances, dense LU vs. packed Cholesky         *
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+#include <SymmetricMatrixBatch.h>
+#include <eigen3/Eigen/Eigen>
+
+/**
+ * Fill a batch with positive definite matrices
+ */
+template<int Dimension>
+void fillPositiveDefinite(SymmetricMatrixBatch<double, Dimension>& batch) {
+    batch.packed().setRandom();
+    batch.packed() *= 0.1;
+    for (int i = 0; i < Dimension; ++i) {
+        batch.packed().row(symmat_internal::packedIndex(i, i, Dimension))
+            .setConstant(1.0);
+    }
+}
+
+/**
+ * Expand every matrix to an Eigen::Matrix and use its LU decomposition
+ */
+template<int Dimension>
+void BM_LogDetDense(benchmark::State& state) {
+    const size_t count = state.range(0);
+    SymmetricMatrixBatch<double, Dimension> batch(count);
+    fillPositiveDefinite(batch);
+    std::vector<SymmetricMatrix<double, Dimension> > mats;
+    for (size_t t = 0; t < count; ++t) {
+        mats.push_back(batch.get(t));
+    }
+    for (auto _ : state) {
+        for (size_t t = 0; t < count; ++t) {
+            benchmark::DoNotOptimize(std::log(
+                mats[t].constructEigenMatrix().partialPivLu().determinant()));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+/**
+ * SymmetricMatrix::logDeterminant() of every matrix
+ */
+template<int Dimension>
+void BM_LogDetPacked(benchmark::State& state) {
+    const size_t count = state.range(0);
+    SymmetricMatrixBatch<double, Dimension> batch(count);
+    fillPositiveDefinite(batch);
+    std::vector<SymmetricMatrix<double, Dimension> > mats;
+    for (size_t t = 0; t < count; ++t) {
+        mats.push_back(batch.get(t));
+    }
+    for (auto _ : state) {
+        for (size_t t = 0; t < count; ++t) {
+            benchmark::DoNotOptimize(mats[t].logDeterminant());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+/**
+ * logDeterminant() of a SymmetricMatrixBatch, one matrix per SIMD lane
+ */
+template<int Dimension>
+void BM_LogDetBatch(benchmark::State& state) {
+    const size_t count = state.range(0);
+    SymmetricMatrixBatch<double, Dimension> batch(count);
+    fillPositiveDefinite(batch);
+    for (auto _ : state) {
+        Eigen::ArrayXd result = logDeterminant(batch);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK_TEMPLATE(BM_LogDetDense, 3) -> Args({10000});
+BENCHMARK_TEMPLATE(BM_LogDetPacked, 3) -> Args({10000});
+BENCHMARK_TEMPLATE(BM_LogDetBatch, 3) -> Args({10000});
+BENCHMARK_TEMPLATE(BM_LogDetDense, 5) -> Args({10000});
+BENCHMARK_TEMPLATE(BM_LogDetPacked, 5) -> Args({10000});
+BENCHMARK_TEMPLATE(BM_LogDetBatch, 5) -> Args({10000});
+
+BENCHMARK_MAIN();
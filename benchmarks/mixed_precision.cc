@@ -0,0 +1,125 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - mixed_precision                                                *
+ *  Covariance batches stored as float or double, computed in double           *
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <SymmetricMatrixKalman.h>
+#include <eigen3/Eigen/Eigen>
+
+/**
+ * Prediction of many tracks. The batches are much larger than the caches for
+ * the larger arguments, so the prediction is bound by memory bandwidth.
+ * Scalar is the storage type, ComputeScalar the type the kernels compute in.
+ */
+template<typename Scalar, typename ComputeScalar>
+void BM_PredictBatch(benchmark::State& state) {
+    typedef BatchKalmanFilter<Scalar, 5, 2, ComputeScalar> Filter;
+    const size_t count = state.range(0);
+    Filter filter(count);
+    typename Filter::JacobianBatch F(25, count);
+    typename Filter::CovarianceBatch Q(count);
+    filter.covariances().packed().setConstant(Scalar(1));
+    filter.states().setRandom();
+    Q.packed().setConstant(Scalar(1e-6));
+    F.setZero();
+    for (int i = 0; i < 5; ++i) {
+        F.row(i * 5 + i).setOnes();
+    }
+
+    for (auto _ : state) {
+        filter.predict(F, Q);
+        benchmark::DoNotOptimize(filter.covariances().element(0));
+        benchmark::ClobberMemory();
+    }
+    // Read F, Q, C, x and write C, x
+    state.SetBytesProcessed(state.iterations() * count * sizeof(Scalar)
+                            * (25 + 15 + 2 * 15 + 2 * 5));
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+/**
+ * Chi-square of one residual per covariance. Only a few operations are done
+ * per loaded element, so this kernel shows the bandwidth win of single
+ * precision storage best.
+ */
+template<typename Scalar, typename ComputeScalar>
+void BM_Chi2Batch(benchmark::State& state) {
+    const size_t count = state.range(0);
+    SymmetricMatrixBatch<Scalar, 3, ComputeScalar> S(count);
+    S.packed().setZero();
+    S.packed().row(0).setConstant(Scalar(2));
+    S.packed().row(3).setConstant(Scalar(2));
+    S.packed().row(5).setConstant(Scalar(2));
+    typename SymmetricMatrixBatch<Scalar, 3>::VectorBatch residuals
+        = SymmetricMatrixBatch<Scalar, 3>::VectorBatch::Random(3, count);
+    Eigen::Array<Scalar, Eigen::Dynamic, 1> result(count);
+
+    for (auto _ : state) {
+        chi2(S, residuals, result);
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    // Read S and r, write chi2
+    state.SetBytesProcessed(state.iterations() * count * sizeof(Scalar)
+                            * (6 + 3 + 1));
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+/**
+ * Conversion of a whole batch between storage types
+ */
+template<typename Src, typename Dst>
+void BM_ConvertBatch(benchmark::State& state) {
+    SymmetricMatrixBatch<Src, 5> batch(state.range(0));
+    batch.packed().setRandom();
+    SymmetricMatrixBatch<Dst, 5> converted;
+
+    for (auto _ : state) {
+        converted = batch.template cast<Dst>();
+        benchmark::DoNotOptimize(converted.element(0));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 15
+                            * (sizeof(Src) + sizeof(Dst)));
+}
+
+BENCHMARK_TEMPLATE(BM_PredictBatch, double, double)
+    -> Args({10000})
+    -> Args({1000000})
+    -> Args({10000000});
+
+BENCHMARK_TEMPLATE(BM_PredictBatch, float, double)
+    -> Args({10000})
+    -> Args({1000000})
+    -> Args({10000000});
+
+BENCHMARK_TEMPLATE(BM_PredictBatch, float, float)
+    -> Args({10000})
+    -> Args({1000000})
+    -> Args({10000000});
+
+BENCHMARK_TEMPLATE(BM_Chi2Batch, double, double)
+    -> Args({10000})
+    -> Args({1000000})
+    -> Args({10000000});
+
+BENCHMARK_TEMPLATE(BM_Chi2Batch, float, double)
+    -> Args({10000})
+    -> Args({1000000})
+    -> Args({10000000});
+
+BENCHMARK_TEMPLATE(BM_ConvertBatch, float, double)
+    -> Args({10000})
+    -> Args({1000000});
+
+BENCHMARK_TEMPLATE(BM_ConvertBatch, double, float)
+    -> Args({10000})
+    -> Args({1000000});
+
+BENCHMARK_MAIN();
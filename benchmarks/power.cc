@@ -0,0 +1,132 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - power                                                          *
+ *  Squares, powers and Gram matrices computed in full and as packed results   *
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <SymmetricMatrix.h>
+#include <eigen3/Eigen/Eigen>
+
+/**
+ * Square by operator*, which computes all n^2 elements of the dense product
+ */
+void BM_SquareProduct(benchmark::State& state) {
+    SymmetricMatrix<double> sym = SymmetricMatrix<double>::Random(
+        state.range(0));
+    Eigen::MatrixXd result;
+
+    for (auto _ : state) {
+        result = sym * sym;
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+/**
+ * Square by square(), which computes the lower triangle only
+ */
+void BM_SquarePacked(benchmark::State& state) {
+    const SymmetricMatrix<double> sym = SymmetricMatrix<double>::Random(
+        state.range(0));
+    SymmetricMatrix<double> result;
+
+    for (auto _ : state) {
+        result = sym.square();
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+/**
+ * A^8 by three dense squarings of an Eigen::Matrix
+ */
+void BM_PowDense(benchmark::State& state) {
+    const Eigen::MatrixXd mat = SymmetricMatrix<double>::Random(
+        state.range(0)).constructEigenMatrix();
+    Eigen::MatrixXd result;
+
+    for (auto _ : state) {
+        result = mat * mat;
+        result = result * result;
+        result = result * result;
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+/**
+ * A^8 by pow()
+ */
+void BM_PowPacked(benchmark::State& state) {
+    const SymmetricMatrix<double> sym = SymmetricMatrix<double>::Random(
+        state.range(0));
+    SymmetricMatrix<double> result;
+
+    for (auto _ : state) {
+        result = sym.pow(8);
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+/**
+ * B B^T of an n x n/2 matrix as dense product
+ */
+void BM_GramDense(benchmark::State& state) {
+    const Eigen::MatrixXd factor = Eigen::MatrixXd::Random(state.range(0),
+                                                           state.range(0) / 2);
+    Eigen::MatrixXd result;
+
+    for (auto _ : state) {
+        result = factor * factor.transpose();
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+/**
+ * B B^T of an n x n/2 matrix by gram()
+ */
+void BM_GramPacked(benchmark::State& state) {
+    const Eigen::MatrixXd factor = Eigen::MatrixXd::Random(state.range(0),
+                                                           state.range(0) / 2);
+    SymmetricMatrix<double> result;
+
+    for (auto _ : state) {
+        result = SymmetricMatrix<double>::gram(factor);
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+BENCHMARK(BM_SquareProduct)
+    -> Args({100})
+    -> Args({500})
+    -> Args({1000});
+
+BENCHMARK(BM_SquarePacked)
+    -> Args({100})
+    -> Args({500})
+    -> Args({1000});
+
+BENCHMARK(BM_PowDense)
+    -> Args({100})
+    -> Args({500})
+    -> Args({1000});
+
+BENCHMARK(BM_PowPacked)
+    -> Args({100})
+    -> Args({500})
+    -> Args({1000});
+
+BENCHMARK(BM_GramDense)
+    -> Args({100})
+    -> Args({500})
+    -> Args({1000});
+
+BENCHMARK(BM_GramPacked)
+    -> Args({100})
+    -> Args({500})
+    -> Args({1000});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - scatter_add                                                    *
+ *  Concurrent scatter-add of small blocks into a shared symmetric matrix      *
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include <SymmetricMatrixParallel.h>
+#include <eigen3/Eigen/Eigen>
+
+// Dimension of the shared matrix
+static const int dim = 5000;
+
+/**
+ * Shared matrix every benchmark scatters into. The first argument of each
+ * benchmark is the range of indices the blocks are placed in: A small range
+ * means that all threads hit the same few tiles (high contention), a range of
+ * dim means that blocks are spread over the whole matrix (low contention).
+ */
+static SymmetricMatrix<double>& sharedMatrix() {
+    static SymmetricMatrix<double> mat = SymmetricMatrix<double>::Zero(dim);
+    return mat;
+}
+
+static std::vector<int> randomIndices(std::mt19937& gen, int range) {
+    std::vector<int> indices;
+    std::uniform_int_distribution<int> dist(0, range - 1);
+    while (indices.size() < 5) {
+        int idx = dist(gen);
+        if (std::find(indices.begin(), indices.end(), idx) == indices.end()) {
+            indices.push_back(idx);
+        }
+    }
+    return indices;
+}
+
+void BM_ScatterGlobalLock(benchmark::State& state) {
+    static std::mutex mutex;
+    SymmetricMatrix<double>& mat = sharedMatrix();
+    Eigen::Matrix<double, 5, 5> block = Eigen::Matrix<double, 5, 5>::Random();
+    std::mt19937 gen(state.thread_index());
+
+    for (auto _ : state) {
+        std::vector<int> indices = randomIndices(gen, state.range(0));
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int a = 0; a < 5; ++a) {
+            for (int b = a; b < 5; ++b) {
+                mat(indices[a], indices[b]) += block(a, b);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<ScatterMode mode>
+void BM_Scatter(benchmark::State& state) {
+    static SymmetricMatrixScatter<double> scatter(sharedMatrix(), mode);
+    Eigen::Matrix<double, 5, 5> block = Eigen::Matrix<double, 5, 5>::Random();
+    std::mt19937 gen(state.thread_index());
+
+    for (auto _ : state) {
+        scatter.scatterAdd(randomIndices(gen, state.range(0)), block);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ScatterGlobalLock)
+    -> Args({50})
+    -> Args({dim})
+    -> ThreadRange(1, 16)
+    -> UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_Scatter, StripedLockScatter)
+    -> Args({50})
+    -> Args({dim})
+    -> ThreadRange(1, 16)
+    -> UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_Scatter, AtomicScatter)
+    -> Args({50})
+    -> Args({dim})
+    -> ThreadRange(1, 16)
+    -> UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Benchmark - trace_product                                                  *
+ *  Traces of products from full products and from packed storage              *
+ ******************************************************************************/
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <SymmetricMatrix.h>
+#include <SymmetricMatrixBatch.h>
+#include <eigen3/Eigen/Eigen>
+
+/**
+ * tr(A B) by expanding both matrices and computing the full product
+ */
+void BM_TraceOfProductDense(benchmark::State& state) {
+    SymmetricMatrix<double> sym1 = SymmetricMatrix<double>::Random(
+        state.range(0));
+    SymmetricMatrix<double> sym2 = SymmetricMatrix<double>::Random(
+        state.range(0));
+    double result;
+
+    for (auto _ : state) {
+        result = (sym1.constructEigenMatrix()
+                  * sym2.constructEigenMatrix()).trace();
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+/**
+ * tr(A B) by traceOfProduct() from the packed storages
+ */
+void BM_TraceOfProductPacked(benchmark::State& state) {
+    const SymmetricMatrix<double> sym1 = SymmetricMatrix<double>::Random(
+        state.range(0));
+    const SymmetricMatrix<double> sym2 = SymmetricMatrix<double>::Random(
+        state.range(0));
+    double result;
+
+    for (auto _ : state) {
+        result = sym1.traceOfProduct(sym2);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+/**
+ * tr(A_i B_i) of 4x4 matrices by traceOfProduct() of every single matrix
+ */
+void BM_TraceOfProductSingle(benchmark::State& state) {
+    std::vector<SymmetricMatrix<double, 4> > syms1, syms2;
+    for (int t = 0; t < state.range(0); ++t) {
+        syms1.push_back(SymmetricMatrix<double, 4>::Random());
+        syms2.push_back(SymmetricMatrix<double, 4>::Random());
+    }
+    std::vector<double> result(state.range(0));
+
+    for (auto _ : state) {
+        for (int t = 0; t < state.range(0); ++t) {
+            result[t] = syms1[t].traceOfProduct(syms2[t]);
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+/**
+ * tr(A_i B_i) of 4x4 matrices by traceOfProduct() of a batch
+ */
+void BM_TraceOfProductBatch(benchmark::State& state) {
+    std::vector<SymmetricMatrix<double, 4> > syms1, syms2;
+    for (int t = 0; t < state.range(0); ++t) {
+        syms1.push_back(SymmetricMatrix<double, 4>::Random());
+        syms2.push_back(SymmetricMatrix<double, 4>::Random());
+    }
+    const SymmetricMatrixBatch<double, 4> batch1(syms1), batch2(syms2);
+    Eigen::ArrayXd result;
+
+    for (auto _ : state) {
+        result = traceOfProduct(batch1, batch2);
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+BENCHMARK(BM_TraceOfProductDense)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK(BM_TraceOfProductPacked)
+    -> Args({10})
+    -> Args({100})
+    -> Args({1000});
+
+BENCHMARK(BM_TraceOfProductSingle)
+    -> Args({1000})
+    -> Args({100000});
+
+BENCHMARK(BM_TraceOfProductBatch)
+    -> Args({1000})
+    -> Args({100000});
+
+BENCHMARK_MAIN();
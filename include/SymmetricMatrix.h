@@ -7,6 +7,8 @@
 #include <sstream>
 #include <ostream>
 #include <algorithm>
+#include <utility>
+#include <limits>
 #include <stdexcept>
 #include <array>
 #include "eigen3/Eigen/Eigen"
@@ -15,6 +17,871 @@
 #define CPP11_SUPPORT 1
 #endif 
 
+namespace symmat_internal {
+
+/**
+ * \brief Position of the element (row, col) in the packed storage of a
+ * symmetric matrix of dimension dim.
+ *
+ * The upper triangular part is stored row by row, i.e., row r starts at
+ * r * dim - r * (r - 1) / 2.
+ */
+inline size_t
+packedIndex(size_t row, size_t col, size_t dim) {
+    if (row > col) {
+        std::swap(row, col);
+    }
+    return row * dim - row * (row - 1) / 2 + col - row;
+}
+
+/**
+ * \brief Convert n elements from one scalar type to another.
+ *
+ * The loop is kept trivial on purpose: Eigen provides no packet casts between
+ * float and double, but compilers vectorize this loop (e.g., vcvtps2pd) at -O3.
+ *
+ * \param src Elements to convert
+ * \param n Number of elements
+ * \param dst Destination of the converted elements
+ */
+template<typename Src, typename Dst>
+inline void
+convertElements(const Src* src, size_t n, Dst* dst) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = static_cast<Dst>(src[i]);
+    }
+}
+
+/**
+ * \brief In-place Cholesky factorization A = U^T U of packed storage.
+ *
+ * a contains the upper triangular part of the symmetric matrix A of dimension
+ * n stored row by row. On success it is overwritten by the upper triangular
+ * factor U in the same layout. The factorization is computed row by row and
+ * stops at the first pivot that is not positive, so a matrix that is not
+ * positive definite is detected as early as possible.
+ *
+ * \param a Packed storage of A
+ * \param n Dimension of A
+ * \return Index of the first non-positive pivot or -1 on success
+ */
+template<typename Scalar>
+int
+packedCholesky(Scalar* a, size_t n) {
+    Scalar* row = a;
+    for (size_t i = 0; i < n; ++i) {
+        // row points to the element (i, i)
+        if (!(row[0] > Scalar(0))) {
+            return static_cast<int>(i);
+        }
+        Scalar pivot = std::sqrt(row[0]);
+        row[0] = pivot;
+        for (size_t j = 1; j < n - i; ++j) {
+            row[j] /= pivot;
+        }
+
+        // Subtract the outer product of row i from the trailing rows. Each
+        // trailing row is contiguous, so the inner loop vectorizes.
+        Scalar* next = row + (n - i);
+        for (size_t j = i + 1; j < n; ++j) {
+            const Scalar factor = row[j - i];
+            const Scalar* src = row + (j - i);
+            for (size_t k = 0; k < n - j; ++k) {
+                next[k] -= factor * src[k];
+            }
+            next += n - j;
+        }
+        row += n - i;
+    }
+    return -1;
+}
+
+/**
+ * \brief Solve U^T y = b in place for a packed upper triangular factor U.
+ * \param u Packed storage of U
+ * \param n Dimension of U
+ * \param b Right hand side, overwritten by y
+ */
+template<typename Scalar>
+void
+packedForwardSolve(const Scalar* u, size_t n, Scalar* b) {
+    const Scalar* row = u;
+    for (size_t i = 0; i < n; ++i) {
+        b[i] /= row[0];
+        for (size_t j = i + 1; j < n; ++j) {
+            b[j] -= row[j - i] * b[i];
+        }
+        row += n - i;
+    }
+}
+
+/**
+ * \brief Solve U x = y in place for a packed upper triangular factor U.
+ * \param u Packed storage of U
+ * \param n Dimension of U
+ * \param y Right hand side, overwritten by x
+ */
+template<typename Scalar>
+void
+packedBackSolve(const Scalar* u, size_t n, Scalar* y) {
+    if (n == 0) {
+        return;
+    }
+    const Scalar* row = u + (n * n + n) / 2 - 1;
+    for (size_t i = n; i-- > 0;) {
+        // row points to the element (i, i)
+        Scalar sum = y[i];
+        for (size_t j = i + 1; j < n; ++j) {
+            sum -= row[j - i] * y[j];
+        }
+        y[i] = sum / row[0];
+        if (i > 0) {
+            row -= n - i + 1;
+        }
+    }
+}
+
+/**
+ * \brief 1-norm, i.e., the maximum absolute column sum, of a symmetric matrix
+ * in packed storage.
+ * \param a Packed storage of A
+ * \param n Dimension of A
+ * \param colSums Workspace of size n, the sums are accumulated in its type
+ * \return 1-norm of A
+ */
+template<typename Scalar, typename ComputeScalar>
+ComputeScalar
+packedNorm1(const Scalar* a, size_t n, ComputeScalar* colSums) {
+    std::fill(colSums, colSums + n, ComputeScalar(0));
+    for (size_t i = 0; i < n; ++i) {
+        // a points to the element (i, i)
+        colSums[i] += static_cast<ComputeScalar>(std::abs(a[0]));
+        for (size_t j = i + 1; j < n; ++j) {
+            const ComputeScalar value
+                = static_cast<ComputeScalar>(std::abs(a[j - i]));
+            colSums[i] += value;
+            colSums[j] += value;
+        }
+        a += n - i;
+    }
+    return *std::max_element(colSums, colSums + n);
+}
+
+/**
+ * \brief Estimate the 1-norm of A^-1 from the packed Cholesky factor U of A.
+ *
+ * Implements the estimator of Hager as refined by Higham (LAPACK's xLACON):
+ * at most five iterations of a power method on A^-1, each costing two
+ * triangular solve pairs, followed by Higham's alternative estimate that
+ * guards against cases where the power method stalls. The estimate is a lower
+ * bound of the 1-norm of A^-1 that is almost always within a factor of 3.
+ *
+ * \param u Packed storage of U
+ * \param n Dimension of U
+ * \param x Workspace of size n
+ * \param y Workspace of size n
+ * \return Estimate of the 1-norm of A^-1
+ */
+template<typename Scalar>
+Scalar
+packedInverseNorm1Estimate(const Scalar* u, size_t n, Scalar* x, Scalar* y) {
+    std::fill(x, x + n, Scalar(1) / Scalar(n));
+    Scalar est = Scalar(0);
+    for (int iter = 0; iter < 5; ++iter) {
+        // y = A^-1 x
+        std::copy(x, x + n, y);
+        packedForwardSolve(u, n, y);
+        packedBackSolve(u, n, y);
+        Scalar norm = Scalar(0);
+        for (size_t i = 0; i < n; ++i) {
+            norm += std::abs(y[i]);
+        }
+        if (iter > 0 && norm <= est) {
+            break;
+        }
+        est = norm;
+
+        // z = A^-1 sign(y), A is symmetric so A^-T = A^-1
+        for (size_t i = 0; i < n; ++i) {
+            y[i] = (y[i] >= Scalar(0)) ? Scalar(1) : Scalar(-1);
+        }
+        packedForwardSolve(u, n, y);
+        packedBackSolve(u, n, y);
+        size_t j = 0;
+        Scalar ztx = Scalar(0);
+        for (size_t i = 0; i < n; ++i) {
+            if (std::abs(y[i]) > std::abs(y[j])) {
+                j = i;
+            }
+            ztx += y[i] * x[i];
+        }
+        if (iter > 0 && std::abs(y[j]) <= ztx) {
+            break;
+        }
+        std::fill(x, x + n, Scalar(0));
+        x[j] = Scalar(1);
+    }
+
+    // Alternative estimate with x_i = (-1)^i (1 + i / (n - 1))
+    for (size_t i = 0; i < n; ++i) {
+        Scalar value = Scalar(1) + ((n > 1) ? Scalar(i) / Scalar(n - 1)
+                                            : Scalar(0));
+        x[i] = (i % 2 == 0) ? value : -value;
+    }
+    packedForwardSolve(u, n, x);
+    packedBackSolve(u, n, x);
+    Scalar alt = Scalar(0);
+    for (size_t i = 0; i < n; ++i) {
+        alt += std::abs(x[i]);
+    }
+    alt = Scalar(2) * alt / Scalar(3 * n);
+    return std::max(est, alt);
+}
+
+/**
+ * \brief Logarithm of the determinant 2 sum_i log U_ii of A = U^T U from the
+ * packed Cholesky factor U.
+ *
+ * Summing logarithms cannot overflow or underflow, unlike the product of the
+ * pivots.
+ */
+template<typename Scalar>
+inline Scalar
+packedLogDeterminant(const Scalar* u, size_t n) {
+    Scalar ret(0);
+    for (size_t i = 0; i < n; u += n - i, ++i) {
+        ret += std::log(u[0]);
+    }
+    return Scalar(2) * ret;
+}
+
+/**
+ * \brief Inverse A^-1 = U^-1 U^-T from the packed Cholesky factor U of A,
+ * like LAPACK's dpptri.
+ *
+ * First W = U^-1 is computed from the last row upwards: row i of W is
+ * -1 / U_ii times the sum of U_ik times the rows k > i of W, which are
+ * contiguous in packed storage. Then (A^-1)_ij = sum_{k >= j} W_ik W_jk for
+ * i <= j is the dot product of the tail of row i with row j of W. Row i of W
+ * is not needed for the rows below, so the result overwrites W row by row.
+ * Both steps cost n^3 / 6 multiply-adds.
+ *
+ * \param u Packed storage of U
+ * \param n Dimension of U
+ * \param inv Packed storage of A^-1, must not overlap u
+ * \param work Workspace of size n
+ */
+template<typename Scalar>
+inline void
+packedCholeskyInverse(const Scalar* u, size_t n, Scalar* inv, Scalar* work) {
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> Vector;
+    // W = U^-1 into inv, from the last row upwards
+    for (size_t i = n; i-- > 0;) {
+        const size_t ii = packedIndex(i, i, n);
+        Eigen::Map<Vector> row(work, n - i);
+        row.setZero();
+        size_t kk = ii + (n - i);
+        for (size_t k = i + 1; k < n; kk += n - k, ++k) {
+            row.tail(n - k) += u[ii + k - i]
+                * Eigen::Map<const Vector>(inv + kk, n - k);
+        }
+        const Scalar pivot = Scalar(1) / u[ii];
+        row *= -pivot;
+        row[0] = pivot;
+        Eigen::Map<Vector>(inv + ii, n - i) = row;
+    }
+    // A^-1 = W W^T, row by row from the top
+    for (size_t i = 0; i < n; ++i) {
+        const size_t ii = packedIndex(i, i, n);
+        Eigen::Map<Vector> row(work, n - i);
+        size_t jj = ii;
+        for (size_t j = i; j < n; jj += n - j, ++j) {
+            row[j - i] = Eigen::Map<const Vector>(inv + ii + (j - i), n - j)
+                .dot(Eigen::Map<const Vector>(inv + jj, n - j));
+        }
+        Eigen::Map<Vector>(inv + ii, n - i) = row;
+    }
+}
+
+/**
+ * \brief Determinant of a packed symmetric matrix that is not positive
+ * definite.
+ *
+ * Expands the matrix and uses Eigen's determinant(), i.e., closed-form
+ * expressions up to dimension 4 and a partial pivoting LU decomposition
+ * above.
+ *
+ * \param a Packed storage of A
+ * \param n Dimension of A
+ * \return Determinant of A in ComputeScalar
+ */
+template<typename ComputeScalar, int Dimension, typename Scalar>
+inline ComputeScalar
+packedDenseDeterminant(const Scalar* a, size_t n) {
+    Eigen::Matrix<ComputeScalar, Dimension, Dimension> mat(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i; j < n; ++j, ++a) {
+            mat(i, j) = mat(j, i) = static_cast<ComputeScalar>(*a);
+        }
+    }
+    return mat.determinant();
+}
+
+/**
+ * \brief Scale a packed symmetric matrix from both sides, i.e.,
+ * dst_ij = s_i * src_ij * s_j.
+ *
+ * Row i of the packed storage is contiguous and holds the columns i to n - 1,
+ * so it is rescaled by a single vectorized multiply with the broadcast s_i and
+ * the segment s_i, ..., s_{n-1}. src and dst may point to the same storage.
+ *
+ * \param src Packed storage of the matrix
+ * \param n Dimension of the matrix
+ * \param s Scaling factors in the compute type
+ * \param dst Packed storage of the scaled matrix
+ */
+template<typename Scalar, typename ComputeScalar>
+inline void
+packedScale(const Scalar* src, size_t n, const ComputeScalar* s,
+            Scalar* dst) {
+    typedef Eigen::Array<Scalar, Eigen::Dynamic, 1> Row;
+    typedef Eigen::Array<ComputeScalar, Eigen::Dynamic, 1> ComputeRow;
+    for (size_t i = 0, start = 0; i < n; start += n - i, ++i) {
+        Eigen::Map<const Row> in(src + start, n - i);
+        Eigen::Map<const ComputeRow> scale(s + i, n - i);
+        Eigen::Map<Row> out(dst + start, n - i);
+        out = (in.template cast<ComputeScalar>() * (s[i] * scale))
+            .template cast<Scalar>();
+    }
+}
+
+/**
+ * \brief Convert a packed covariance matrix to the correlation matrix
+ * C_ij / sqrt(C_ii C_jj).
+ *
+ * The diagonal is extracted once and its reciprocal square roots are computed
+ * in one vectorized pass before the rows are rescaled by packedScale(). The
+ * diagonal of the result is set to exactly one. A variance that is not
+ * positive yields non-finite correlations. src and dst may point to the same
+ * storage.
+ *
+ * \param src Packed storage of the covariance matrix
+ * \param n Dimension of the matrix
+ * \param s Workspace of n elements
+ * \param dst Packed storage of the correlation matrix
+ */
+template<typename Scalar, typename ComputeScalar>
+inline void
+packedCorrelation(const Scalar* src, size_t n, ComputeScalar* s,
+                  Scalar* dst) {
+    for (size_t i = 0, ii = 0; i < n; ii += n - i, ++i) {
+        s[i] = static_cast<ComputeScalar>(src[ii]);
+    }
+    Eigen::Map<Eigen::Array<ComputeScalar, Eigen::Dynamic, 1> > diag(s, n);
+    diag = diag.rsqrt();
+    packedScale(src, n, s, dst);
+    for (size_t i = 0, ii = 0; i < n; ii += n - i, ++i) {
+        dst[ii] = Scalar(1);
+    }
+}
+
+/**
+ * \brief Gather a principal submatrix of a packed symmetric matrix.
+ *
+ * Row a of the submatrix consists of the elements (indices[a], indices[b])
+ * with b >= a of the parent. For the top left corner (indices is null) these
+ * are the first k - a elements of row a of the parent, which are copied as one
+ * contiguous segment. Otherwise the start of row indices[a] of the parent is
+ * computed once per row, so increasing indices need a single load per element.
+ *
+ * \param src Packed storage of the parent matrix
+ * \param n Dimension of the parent matrix
+ * \param indices Rows and columns of the parent that form the submatrix, or
+ * null for the top left corner
+ * \param k Dimension of the submatrix
+ * \param dst Packed storage of the submatrix
+ */
+template<typename Src, typename Dst>
+inline void
+packedGather(const Src* src, size_t n, const int* indices, size_t k,
+             Dst* dst) {
+    for (size_t a = 0; a < k; ++a) {
+        if (!indices) {
+            convertElements(src + packedIndex(a, a, n), k - a, dst);
+            dst += k - a;
+            continue;
+        }
+        const size_t i = indices[a];
+        const Src* row = src + packedIndex(i, i, n) - i;
+        for (size_t b = a; b < k; ++b) {
+            const size_t j = indices[b];
+            *dst++ = static_cast<Dst>((j >= i) ? row[j]
+                                               : src[packedIndex(j, i, n)]);
+        }
+    }
+}
+
+/**
+ * \brief Scatter a packed matrix into a principal submatrix of a packed
+ * symmetric matrix, i.e., the inverse of packedGather().
+ *
+ * \param src Packed storage of the submatrix
+ * \param k Dimension of the submatrix
+ * \param dst Packed storage of the parent matrix
+ * \param n Dimension of the parent matrix
+ * \param indices Rows and columns of the parent that form the submatrix, or
+ * null for the top left corner
+ * \param op Eigen assignment functor, e.g., Eigen::internal::add_assign_op
+ */
+template<typename Src, typename Dst, typename Op>
+inline void
+packedScatter(const Src* src, size_t k, Dst* dst, size_t n,
+              const int* indices, const Op& op) {
+    for (size_t a = 0; a < k; ++a) {
+        const size_t i = indices ? indices[a] : a;
+        Dst* row = dst + packedIndex(i, i, n) - i;
+        for (size_t b = a; b < k; ++b) {
+            const size_t j = indices ? indices[b] : b;
+            op.assignCoeff((j >= i) ? row[j] : dst[packedIndex(j, i, n)],
+                           static_cast<Dst>(*src++));
+        }
+    }
+}
+
+/**
+ * \brief Schur complement S_aa - S_ab S_bb^-1 S_ba of a packed symmetric
+ * matrix S.
+ *
+ * S_bb is gathered and factorized into U^T U in packed storage. The rows of
+ * S_ba are overwritten by W = U^-T S_ba with one vectorized row update per
+ * element of U. S_aa - W^T W is then accumulated as m packed rank-1 updates,
+ * each of which updates the contiguous packed rows of the result with a
+ * single multiply-add, so only the upper triangle is computed and S is never
+ * expanded.
+ *
+ * \param s Packed storage of S
+ * \param n Dimension of S
+ * \param keep Rows and columns a that are kept
+ * \param k Number of kept rows
+ * \param elim Rows and columns b that are eliminated
+ * \param m Number of eliminated rows
+ * \param work Workspace of (m * m + m) / 2 + m * k + (k * k + k) / 2
+ * elements
+ * \param result Packed storage of the Schur complement of dimension k
+ * \return False if S_bb is not positive definite, true otherwise
+ */
+template<typename Scalar, typename ComputeScalar>
+inline bool
+packedSchurComplement(const Scalar* s, size_t n, const int* keep, size_t k,
+                      const int* elim, size_t m, ComputeScalar* work,
+                      Scalar* result) {
+    typedef Eigen::Array<ComputeScalar, Eigen::Dynamic, 1> Row;
+    ComputeScalar* u = work;
+    ComputeScalar* w = u + (m * m + m) / 2;
+    ComputeScalar* acc = w + m * k;
+    packedGather(s, n, elim, m, u);
+    if (packedCholesky(u, m) >= 0) {
+        return false;
+    }
+
+    // W = U^-T S_ba, row r of W holds the columns keep of the row elim[r]
+    for (size_t r = 0; r < m; ++r) {
+        for (size_t c = 0; c < k; ++c) {
+            w[r * k + c] = static_cast<ComputeScalar>(
+                s[packedIndex(elim[r], keep[c], n)]);
+        }
+    }
+    for (size_t i = 0, ii = 0; i < m; ii += m - i, ++i) {
+        Eigen::Map<Row> wi(w + i * k, k);
+        wi /= u[ii];
+        for (size_t j = i + 1; j < m; ++j) {
+            Eigen::Map<Row>(w + j * k, k) -= u[ii + j - i] * wi;
+        }
+    }
+
+    // S_aa - W^T W as a sum of packed rank-1 updates
+    packedGather(s, n, keep, k, acc);
+    for (size_t r = 0; r < m; ++r) {
+        const ComputeScalar* wr = w + r * k;
+        for (size_t i = 0, start = 0; i < k; start += k - i, ++i) {
+            Eigen::Map<Row>(acc + start, k - i)
+                -= wr[i] * Eigen::Map<const Row>(wr + i, k - i);
+        }
+    }
+    convertElements(acc, (k * k + k) / 2, result);
+    return true;
+}
+
+/**
+ * \brief Schur complement of the rows and columns keep of a packed symmetric
+ * matrix, eliminating all other rows and columns
+ *
+ * \param s Packed storage of S
+ * \param n Dimension of S
+ * \param keep Distinct rows and columns that are kept
+ * \param result Packed storage of the Schur complement, unchanged if the
+ * eliminated block is not positive definite
+ * \return Eigen::NumericalIssue if the eliminated block is not positive
+ * definite, Eigen::Success otherwise
+ */
+template<typename ComputeScalar, typename Scalar>
+inline Eigen::ComputationInfo
+schurComplement(const Scalar* s, size_t n, const std::vector<int>& keep,
+                std::vector<Scalar>& result) {
+    std::vector<char> kept(n, 0);
+    for (size_t a = 0; a < keep.size(); ++a) {
+        eigen_assert(keep[a] >= 0 && static_cast<size_t>(keep[a]) < n
+            && !kept[keep[a]]
+            && "Kept indices must be distinct and in range");
+        kept[keep[a]] = 1;
+    }
+    std::vector<int> elim;
+    for (size_t i = 0; i < n; ++i) {
+        if (!kept[i]) {
+            elim.push_back(i);
+        }
+    }
+    const size_t k = keep.size();
+    const size_t m = elim.size();
+    std::vector<ComputeScalar> work((m * m + m) / 2 + m * k + (k * k + k) / 2);
+    std::vector<Scalar> packed((k * k + k) / 2);
+    if (!packedSchurComplement(s, n, keep.data(), k, elim.data(), m,
+                               work.data(), packed.data())) {
+        return Eigen::NumericalIssue;
+    }
+    result.swap(packed);
+    return Eigen::Success;
+}
+
+/**
+ * \brief Add the contributions of the packed rows [begin, end) of a
+ * symmetric matrix A to the product z = A x.
+ *
+ * The packed row i holds A(i, i..n-1). It contributes its dot product with
+ * x(i..n-1) to y_i and, by symmetry, x_i times A(i, i+1..n-1) to
+ * y(i+1..n-1). Both are contiguous and vectorize. Two rows are processed
+ * per pass, like Eigen's dense selfadjoint product, so that z(i+2..n-1) is
+ * loaded and stored once for two rows. Only z(begin..n-1) is written. The
+ * dot products do not conjugate, since A is symmetric, not self-adjoint.
+ *
+ * \param a Pointer to the packed row begin
+ * \param n Dimension of A
+ * \param x Vector of size n
+ * \param z Vector of size n, the contributions are added to it
+ * \param begin First row
+ * \param end One past the last row
+ */
+template<typename Scalar, typename ComputeScalar>
+inline void
+packedSymvRows(const Scalar* a, size_t n, const ComputeScalar* x,
+               ComputeScalar* z, size_t begin, size_t end) {
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> Row;
+    typedef Eigen::Matrix<ComputeScalar, Eigen::Dynamic, 1> Vector;
+    size_t i = begin;
+    for (; i + 1 < end; a += 2 * (n - i) - 1, i += 2) {
+        // Columns i + 2..n-1 of the rows i and i + 1
+        const Eigen::Index len = n - i - 2;
+        const Scalar* r1 = a + (n - i);
+        Eigen::Map<const Row> row0(a + 2, len);
+        Eigen::Map<const Row> row1(r1 + 1, len);
+        Eigen::Map<const Vector> xj(x + i + 2, len);
+        const ComputeScalar x0 = x[i];
+        const ComputeScalar x1 = x[i + 1];
+        const ComputeScalar a01 = static_cast<ComputeScalar>(a[1]);
+        z[i] += static_cast<ComputeScalar>(a[0]) * x0 + a01 * x1
+            + row0.template cast<ComputeScalar>().cwiseProduct(xj).sum();
+        z[i + 1] += static_cast<ComputeScalar>(r1[0]) * x1 + a01 * x0
+            + row1.template cast<ComputeScalar>().cwiseProduct(xj).sum();
+        Eigen::Map<Vector>(z + i + 2, len)
+            += x0 * row0.template cast<ComputeScalar>()
+             + x1 * row1.template cast<ComputeScalar>();
+    }
+    if (i < end) {
+        const Eigen::Index len = n - i - 1;
+        Eigen::Map<const Row> row(a + 1, len);
+        z[i] += static_cast<ComputeScalar>(a[0]) * x[i]
+            + row.template cast<ComputeScalar>().cwiseProduct(
+                Eigen::Map<const Vector>(x + i + 1, len)).sum();
+        Eigen::Map<Vector>(z + i + 1, len)
+            += x[i] * row.template cast<ComputeScalar>();
+    }
+}
+
+/**
+ * \brief y = alpha x + beta y on packed storage in one pass.
+ *
+ * The elements are converted to ComputeScalar, combined and stored again.
+ * If beta is zero, y is not read, like in BLAS.
+ *
+ * \param alpha Factor of x
+ * \param x Packed storage of x
+ * \param beta Factor of y
+ * \param y Packed storage of y, overwritten by the result
+ * \param size Number of packed elements
+ */
+template<typename Scalar, typename ComputeScalar>
+inline void
+packedAxpby(const ComputeScalar& alpha, const Scalar* x,
+            const ComputeScalar& beta, Scalar* y, size_t size) {
+    typedef Eigen::Array<Scalar, Eigen::Dynamic, 1> Array;
+    Eigen::Map<const Array> xs(x, size);
+    Eigen::Map<Array> ys(y, size);
+    if (beta == ComputeScalar(0)) {
+        ys = (alpha * xs.template cast<ComputeScalar>())
+            .template cast<Scalar>();
+    } else {
+        ys = (alpha * xs.template cast<ComputeScalar>()
+              + beta * ys.template cast<ComputeScalar>())
+            .template cast<Scalar>();
+    }
+}
+
+/**
+ * \brief Add lambda to the diagonal of packed storage.
+ *
+ * The diagonal element (i, i) starts the packed row i, so consecutive
+ * diagonal elements are n - i apart and only these n elements are touched.
+ *
+ * \param a Packed storage of A
+ * \param n Dimension of A
+ * \param lambda Value to add
+ */
+template<typename Scalar, typename ComputeScalar>
+inline void
+packedAddDiagonal(Scalar* a, size_t n, const ComputeScalar& lambda) {
+    for (size_t i = 0; i < n; a += n - i, ++i) {
+        *a = static_cast<Scalar>(static_cast<ComputeScalar>(*a) + lambda);
+    }
+}
+
+/**
+ * \brief dst = sum_k coefficients[k] sources[k] on packed storage.
+ *
+ * The storage is processed in chunks that fit into the L1 cache. All
+ * sources are accumulated into the chunk in ComputeScalar before it is
+ * stored, so every source is read once and dst is written once. If count is
+ * zero, dst is set to zero.
+ *
+ * \param coefficients Factors of the sources
+ * \param sources Packed storages of the same size
+ * \param count Number of sources
+ * \param size Number of packed elements
+ * \param dst Packed storage of the result
+ */
+template<typename Scalar, typename ComputeScalar>
+void
+packedLinearCombination(const ComputeScalar* coefficients,
+                        const Scalar* const* sources, size_t count,
+                        size_t size, Scalar* dst) {
+    typedef Eigen::Array<Scalar, Eigen::Dynamic, 1> Array;
+    typedef Eigen::Array<ComputeScalar, Eigen::Dynamic, 1> ComputeArray;
+    enum { Chunk = 512 };
+    if (count == 0) {
+        std::fill(dst, dst + size, Scalar(0));
+        return;
+    }
+    ComputeScalar buffer[Chunk];
+    for (size_t begin = 0; begin < size; begin += Chunk) {
+        const Eigen::Index len = std::min<size_t>(Chunk, size - begin);
+        Eigen::Map<ComputeArray> acc(buffer, len);
+        acc = coefficients[0]
+            * Eigen::Map<const Array>(sources[0] + begin, len)
+              .template cast<ComputeScalar>();
+        for (size_t k = 1; k < count; ++k) {
+            acc += coefficients[k]
+                * Eigen::Map<const Array>(sources[k] + begin, len)
+                  .template cast<ComputeScalar>();
+        }
+        Eigen::Map<Array>(dst + begin, len) = acc.template cast<Scalar>();
+    }
+}
+
+/**
+ * \brief Trace of packed storage in ComputeScalar.
+ *
+ * Walks the n diagonal elements like packedAddDiagonal().
+ *
+ * \param a Packed storage of A
+ * \param n Dimension of A
+ * \return tr A
+ */
+template<typename ComputeScalar, typename Scalar>
+inline ComputeScalar
+packedTrace(const Scalar* a, size_t n) {
+    ComputeScalar ret(0);
+    for (size_t i = 0; i < n; a += n - i, ++i) {
+        ret += static_cast<ComputeScalar>(*a);
+    }
+    return ret;
+}
+
+/**
+ * \brief sum_ij op(a_ij) b_ij of two symmetric matrices from packed storage.
+ *
+ * Every off-diagonal element is stored once but occurs twice in the sum, so
+ * the result is 2 sum_k op(a_k) b_k over the packed storage, which is a
+ * single vectorized pass, minus the diagonal terms that were counted twice.
+ * For symmetric A and B and op the identity this is tr(A B), for op the
+ * complex conjugate it is the Frobenius inner product <A, B>_F. Both agree for
+ * real matrices.
+ *
+ * \param a Packed storage of A
+ * \param b Packed storage of B
+ * \param n Dimension of A and B
+ * \return tr(A B) or <A, B>_F
+ */
+template<typename ComputeScalar, bool Conjugate, typename Scalar>
+inline ComputeScalar
+packedTraceOfProduct(const Scalar* a, const Scalar* b, size_t n) {
+    typedef Eigen::Array<Scalar, Eigen::Dynamic, 1> Array;
+    const Eigen::Index size = (n * n + n) / 2;
+    Eigen::Map<const Array> as(a, size), bs(b, size);
+    ComputeScalar full;
+    if (Conjugate) {
+        full = (as.template cast<ComputeScalar>().conjugate()
+                * bs.template cast<ComputeScalar>()).sum();
+    } else {
+        full = (as.template cast<ComputeScalar>()
+                * bs.template cast<ComputeScalar>()).sum();
+    }
+    ComputeScalar diagonal(0);
+    for (size_t i = 0, k = 0; i < n; k += n - i, ++i) {
+        const ComputeScalar ak = static_cast<ComputeScalar>(a[k]);
+        diagonal += (Conjugate ? Eigen::numext::conj(ak) : ak)
+            * static_cast<ComputeScalar>(b[k]);
+    }
+    return ComputeScalar(2) * full - diagonal;
+}
+
+/**
+ * \brief Copy the lower triangular part of a dense matrix into packed
+ * storage.
+ *
+ * Column j of the lower triangle is the packed row j, so every column is
+ * copied (and converted to Scalar) in one contiguous piece.
+ *
+ * \param mat Square dense matrix, only its lower triangle is read
+ * \param packed Packed storage of the dimension of mat
+ */
+template<typename Derived, typename Scalar>
+inline void
+packLower(const Eigen::MatrixBase<Derived>& mat, Scalar* packed) {
+    const Eigen::Index n = mat.rows();
+    for (Eigen::Index j = 0; j < n; ++j) {
+        Eigen::Map<Eigen::Matrix<Scalar, Eigen::Dynamic, 1> >(packed, n - j)
+            = mat.col(j).tail(n - j).template cast<Scalar>();
+        packed += n - j;
+    }
+}
+
+/**
+ * \brief A^k of a symmetric matrix A by repeated squaring.
+ *
+ * All powers of A commute, so every intermediate product is symmetric. Only
+ * its lower triangle is computed by Eigen's triangular matrix product, i.e.,
+ * with half the flops of a full product, and mirrored (without conjugation)
+ * before it is used as a factor again.
+ *
+ * \param base Symmetric matrix A, overwritten
+ * \param k Exponent
+ * \return A^k, only the lower triangle is valid
+ */
+template<typename ComputeScalar, int Dimension>
+Eigen::Matrix<ComputeScalar, Dimension, Dimension>
+symmetricPower(Eigen::Matrix<ComputeScalar, Dimension, Dimension>& base,
+               int k) {
+    typedef Eigen::Matrix<ComputeScalar, Dimension, Dimension> Matrix;
+    const Eigen::Index n = base.rows();
+    if (k == 0) {
+        return Matrix::Identity(n, n);
+    }
+    Matrix result(n, n);
+    Matrix product(n, n);
+    bool first = true;
+    for (;;) {
+        if (k & 1) {
+            if (first) {
+                result = base;
+                first = false;
+            } else {
+                product.template triangularView<Eigen::Lower>()
+                    = result * base;
+                product.template triangularView<Eigen::StrictlyUpper>()
+                    = product.transpose();
+                result.swap(product);
+            }
+        }
+        k >>= 1;
+        if (k == 0) {
+            return result;
+        }
+        product.template triangularView<Eigen::Lower>() = base * base;
+        product.template triangularView<Eigen::StrictlyUpper>()
+            = product.transpose();
+        base.swap(product);
+    }
+}
+
+/**
+ * \brief Packed Cholesky factor that a SymmetricMatrix with dynamic dimension
+ * keeps between queries once caching is enabled.
+ *
+ * valid is cleared by every access that may modify the matrix. factor is
+ * only complete if positiveDefinite is true.
+ */
+template<typename ComputeScalar>
+struct FactorizationCache {
+    FactorizationCache() : enabled(false), valid(false),
+                           positiveDefinite(false) {}
+
+    void invalidate() {
+        valid = false;
+    }
+
+    std::vector<ComputeScalar> factor;
+    bool enabled;
+    bool valid;
+    bool positiveDefinite;
+};
+
+}  // namespace symmat_internal
+
+template<typename Scalar, typename ComputeScalar>
+class SymmetricMatrixView;
+
+template<typename Scalar, int Dimension = Eigen::Dynamic,
+         typename ComputeScalar = Scalar>
+class SymmetricMatrix;
+
+namespace Eigen {
+namespace internal {
+
+/**
+ * \brief Expression traits of SymmetricMatrix
+ *
+ * SymmetricMatrix is a read-only dense expression for Eigen: it has no
+ * LvalueBit, so Eigen never writes into the packed storage behind the back
+ * of the class (and of its cached factorization). The coefficients are read
+ * by the evaluator below.
+ */
+template<typename _Scalar, int _Dimension, typename _ComputeScalar>
+struct traits<SymmetricMatrix<_Scalar, _Dimension, _ComputeScalar> > {
+    typedef _Scalar Scalar;
+    typedef Eigen::Index StorageIndex;
+    typedef Dense StorageKind;
+    typedef MatrixXpr XprKind;
+    enum {
+        RowsAtCompileTime = _Dimension,
+        ColsAtCompileTime = _Dimension,
+        MaxRowsAtCompileTime = _Dimension,
+        MaxColsAtCompileTime = _Dimension,
+        Flags = NestByRefBit
+    };
+};
+
+}  // namespace internal
+}  // namespace Eigen
+
 /**
  * \class SymmetricMatrix<typename Scalar, int Dimension = Eigen::Dimension>
  * \brief Generic class template for symmetric matrices
@@ -33,17 +900,86 @@
  * only suitable for small matrices (a few hundred to a thousand elements). If
  * the dimension is set to Eigen::Dynamic (or not at all) all elements are stored
  * on the heap but all the work is done during runtime.
+ *
+ * The optional third template argument ComputeScalar is the type that is used
+ * for accumulation in products, similarity transforms and factorizations.
+ * Choosing, e.g., SymmetricMatrix<float, 5, double> halves the memory
+ * traffic compared to double storage, while all kernels load float, compute
+ * in double and store float again.
+ *
+ * SymmetricMatrix is a read-only Eigen expression, i.e., it can be used as
+ * an operand wherever Eigen accepts a dense matrix (sums with Eigen::Matrix,
+ * blocks, products, assignment to Eigen::Matrix). The coefficients are read
+ * from the packed storage and products with vectors use the packed kernel.
+ * The members of SymmetricMatrix take precedence over the ones of
+ * Eigen::MatrixBase with the same name.
  */
-template<typename Scalar, int Dimension = Eigen::Dynamic>
-class SymmetricMatrix {
+template<typename Scalar, int Dimension, typename ComputeScalar>
+class SymmetricMatrix
+    : public Eigen::MatrixBase<SymmetricMatrix<Scalar, Dimension,
+                                               ComputeScalar> > {
  public:
+    typedef Eigen::MatrixBase<SymmetricMatrix<Scalar, Dimension,
+                                              ComputeScalar> > Base;
+    using Base::operator+;
+    using Base::operator-;
+    using Base::operator*;
+    typedef typename Eigen::internal::ref_selector<SymmetricMatrix>::type
+        Nested;
+
+    /*
+     * The operators of Eigen::MatrixBase for Eigen expressions are const,
+     * the ones below that take an Eigen::Matrix are not. Without these
+     * overloads, an expression that converts to Eigen::Matrix would make
+     * the call ambiguous for a non-const matrix.
+     */
+    template<typename OtherDerived>
+    const Eigen::CwiseBinaryOp<
+        Eigen::internal::scalar_sum_op<Scalar, typename OtherDerived::Scalar>,
+        const SymmetricMatrix, const OtherDerived>
+    operator+(const Eigen::MatrixBase<OtherDerived>& other) {
+        return Base::operator+(other);
+    }
+
+    template<typename OtherDerived>
+    const Eigen::CwiseBinaryOp<
+        Eigen::internal::scalar_difference_op<Scalar,
+                                              typename OtherDerived::Scalar>,
+        const SymmetricMatrix, const OtherDerived>
+    operator-(const Eigen::MatrixBase<OtherDerived>& other) {
+        return Base::operator-(other);
+    }
+
+    template<typename OtherDerived>
+    const Eigen::Product<SymmetricMatrix, OtherDerived>
+    operator*(const Eigen::MatrixBase<OtherDerived>& other) {
+        return Base::operator*(other);
+    }
+
     /* Constructors */
 #if CPP11_SUPPORT
     SymmetricMatrix() = default;
+    SymmetricMatrix(const SymmetricMatrix& other) = default;
 #else
     SymmetricMatrix() {};
 #endif
 
+    /**
+     * \brief Copy assignment of the packed storage
+     *
+     * Declared explicitly since the one of Eigen::MatrixBase would assign
+     * through Eigen, which SymmetricMatrix does not allow.
+     */
+    SymmetricMatrix&
+    operator=(const SymmetricMatrix& other) {
+        if (this != &other) {
+            std::copy(other.data(),
+                      other.data() + (Dimension * Dimension + Dimension) / 2,
+                      data());
+        }
+        return *this;
+    }
+
     /**
      * \brief Construct SymmetricMatrix from Eigen::Matrix
      * 
@@ -63,6 +999,23 @@ class SymmetricMatrix {
         }
     }
 
+    /**
+     * \brief Construct SymmetricMatrix from a view of a principal submatrix
+     *
+     * The elements are gathered directly from the packed storage of the
+     * parent matrix.
+     *
+     * \param view View whose dimension equals Dimension
+     */
+    template<typename ViewScalar>
+    explicit SymmetricMatrix(
+        const SymmetricMatrixView<ViewScalar, ComputeScalar>& view) {
+        eigen_assert(view.dim() == Dimension
+            && "Cannot construct an instance of SymmetricMatrix with fixed "
+            && "dimension from a view with not matching dimension.");
+        view.gather(data());
+    }
+
     /**
      * \brief Construct SymmetricMatrix from Eigen::Matrix
      * 
@@ -141,68 +1094,540 @@ class SymmetricMatrix {
      * random values.
      * \return SymmetricMatrix filled with random values
      */
-    static SymmetricMatrix<Scalar, Dimension>
+    static SymmetricMatrix<Scalar, Dimension, ComputeScalar>
     Random() {
-        return SymmetricMatrix<Scalar, Dimension>(
+        return SymmetricMatrix<Scalar, Dimension, ComputeScalar>(
             static_cast<Eigen::Matrix<Scalar, Dimension, Dimension> >(
                 Eigen::Matrix<Scalar, Dimension, Dimension>::Random(Dimension,
                                                                     Dimension)));
     }
 
-    /* Overloaded operators */
+    /**
+     * \brief Get a SymmetricMatrix with fixed dimension that is filled with
+     * zeros.
+     * \return SymmetricMatrix filled with zeros
+     */
+    static SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    Zero() {
+        SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret;
+        std::fill(ret.data(), ret.data() + (Dimension*Dimension+Dimension)/2,
+                  Scalar(0));
+        return ret;
+    }
 
     /**
-     * \brief Operator () to access a single element of the matrix
-     * 
-     * Overloaded operator () to access a single element of the current instance
-     * of SymmetricMatrix.
-     * 
-     * \param row The row index of the element
-     * \param col The column index of the element
-     * \return Reference to the element (row, col) of the matrix
+     * \brief Dimension of the symmetric matrix.
+     * \return Dimension of the symmetric matrix.
      */
-    Scalar&
-    operator()(int row, int col) {
-        if (row <= col) {
-            return elements[row * Dimension - (row - 1)*((row - 1) + 1)/2
-                            + col - row];
-        } else {
-            return elements[col * Dimension - (col - 1)*((col - 1) + 1)/2
-                            + row - col];
-        }
+    size_t dim() const {
+        return Dimension;
     }
 
     /**
-     * \brief Operator << to push the elements of the matrix into an out-stream.
-     * 
-     * To print the matrix the operator << is overloaded. 
-     * 
-     * \param stream The out-stream
-     * \param mat The matrix to push into stream
+     * \brief Number of rows, i.e., the dimension, for Eigen::MatrixBase.
      */
-    friend std::ostream&
-    operator<<(std::ostream& stream, SymmetricMatrix<Scalar, Dimension>& mat) {
-        for (int row = 0; row < Dimension; ++row) {
-            for (int col = 0; col < Dimension; ++col) {
-                stream << mat(row, col) << " ";
-            }
-            stream << ((row == Dimension - 1)?"":"\n");
-        }
-        return stream;
+    Eigen::Index rows() const {
+        return Dimension;
     }
 
     /**
-     * \brief Overloaded operator + to add a SymmetricMatrix with fixed
-     * dimension.
-     * \param other Matrix to add
-     * \return Sum of both matrices
+     * \brief Number of columns, i.e., the dimension, for Eigen::MatrixBase.
      */
-    SymmetricMatrix<Scalar, Dimension>
-    operator+(const SymmetricMatrix<Scalar, Dimension>& other) {
-        // Construct new matrix and set underlying std::array
-        SymmetricMatrix<Scalar, Dimension> ret(elements);
-        // Just add up both underlying std::vector
-        for (int i = 0; i < (Dimension*Dimension+Dimension)/2; ++i) {
+    Eigen::Index cols() const {
+        return Dimension;
+    }
+
+    /**
+     * \brief Pointer to the packed storage, i.e., the upper triangular part
+     * stored row by row.
+     * \return Pointer to the first element
+     */
+    Scalar* data() {
+        return &elements[0];
+    }
+
+    /**
+     * \brief Pointer to the packed storage, i.e., the upper triangular part
+     * stored row by row.
+     * \return Const pointer to the first element
+     */
+    const Scalar* data() const {
+        return &elements[0];
+    }
+
+    /**
+     * \brief Convert the elements to another scalar type.
+     *
+     * Useful to switch between single precision storage and double precision
+     * storage, e.g., SymmetricMatrix<float, 5, double> to
+     * SymmetricMatrix<double, 5>.
+     *
+     * \return SymmetricMatrix with elements of type NewScalar
+     */
+    template<typename NewScalar>
+    SymmetricMatrix<NewScalar, Dimension>
+    cast() const {
+        return cast<NewScalar, NewScalar>();
+    }
+
+    /**
+     * \brief Convert the elements to another scalar type and choose the
+     * type used for computations.
+     * \return SymmetricMatrix with elements of type NewScalar
+     */
+    template<typename NewScalar, typename NewComputeScalar>
+    SymmetricMatrix<NewScalar, Dimension, NewComputeScalar>
+    cast() const {
+        SymmetricMatrix<NewScalar, Dimension, NewComputeScalar> ret;
+        symmat_internal::convertElements(data(),
+            (Dimension * Dimension + Dimension) / 2, ret.data());
+        return ret;
+    }
+
+    /**
+     * \brief Check if the matrix is positive definite.
+     *
+     * Attempts a Cholesky factorization in packed storage that stops at the
+     * first pivot that is not positive. No exception is thrown.
+     *
+     * \return True if the matrix is positive definite, false otherwise
+     */
+    bool isPositiveDefinite() const {
+        ComputeScalar a[(Dimension * Dimension + Dimension) / 2];
+        symmat_internal::convertElements(data(),
+            (Dimension * Dimension + Dimension) / 2, a);
+        return symmat_internal::packedCholesky(a, Dimension) < 0;
+    }
+
+    /**
+     * \brief Estimate the reciprocal condition number in the 1-norm.
+     *
+     * Factorizes the matrix in packed storage and estimates the 1-norm of the
+     * inverse with the Hager/Higham estimator, so the inverse is never
+     * formed. No exception is thrown.
+     *
+     * \return Estimate of 1 / (|A|_1 |A^-1|_1), or 0 if the matrix is not
+     * positive definite
+     */
+    Scalar rcondEstimate() const {
+        ComputeScalar a[(Dimension * Dimension + Dimension) / 2];
+        ComputeScalar x[Dimension], y[Dimension];
+        symmat_internal::convertElements(data(),
+            (Dimension * Dimension + Dimension) / 2, a);
+        ComputeScalar norm = symmat_internal::packedNorm1(a, Dimension, x);
+        if (symmat_internal::packedCholesky(a, Dimension) >= 0) {
+            return Scalar(0);
+        }
+        return static_cast<Scalar>(ComputeScalar(1) / (norm
+            * symmat_internal::packedInverseNorm1Estimate(a, Dimension, x, y)));
+    }
+
+    /**
+     * \brief Logarithm of the determinant.
+     *
+     * Computed from the diagonal of a Cholesky factorization in packed
+     * storage, whose loops have compile-time bounds. Matrices that are not
+     * positive definite fall back to the determinant of the expanded matrix.
+     * No exception is thrown.
+     *
+     * \return log det A, -infinity if A is singular and NaN if det A is
+     * negative
+     */
+    Scalar logDeterminant() const {
+        ComputeScalar a[(Dimension * Dimension + Dimension) / 2];
+        symmat_internal::convertElements(data(),
+            (Dimension * Dimension + Dimension) / 2, a);
+        if (symmat_internal::packedCholesky(a, Dimension) < 0) {
+            return static_cast<Scalar>(
+                symmat_internal::packedLogDeterminant(a, Dimension));
+        }
+        return static_cast<Scalar>(std::log(symmat_internal
+            ::packedDenseDeterminant<ComputeScalar, Dimension>(data(),
+                                                              Dimension)));
+    }
+
+    /**
+     * \brief Determinant.
+     *
+     * Computed as the squared product of the diagonal of a Cholesky
+     * factorization in packed storage. Matrices that are not positive
+     * definite fall back to the determinant of the expanded matrix. Prefer
+     * logDeterminant() for larger dimensions, where the determinant easily
+     * over- or underflows.
+     *
+     * \return det A
+     */
+    Scalar determinant() const {
+        ComputeScalar a[(Dimension * Dimension + Dimension) / 2];
+        symmat_internal::convertElements(data(),
+            (Dimension * Dimension + Dimension) / 2, a);
+        if (symmat_internal::packedCholesky(a, Dimension) < 0) {
+            ComputeScalar product(1);
+            for (int i = 0; i < Dimension; ++i) {
+                product *= a[symmat_internal::packedIndex(i, i, Dimension)];
+            }
+            return static_cast<Scalar>(product * product);
+        }
+        return static_cast<Scalar>(symmat_internal
+            ::packedDenseDeterminant<ComputeScalar, Dimension>(data(),
+                                                              Dimension));
+    }
+
+    /**
+     * \brief Correlation matrix C_ij / sqrt(C_ii C_jj) of a covariance
+     * matrix.
+     *
+     * Computed directly in packed storage. Variances that are not positive
+     * yield non-finite correlations.
+     *
+     * \return Correlation matrix with a diagonal of ones
+     */
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    correlation() const {
+        SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret;
+        ComputeScalar s[Dimension];
+        symmat_internal::packedCorrelation(data(), Dimension, s, ret.data());
+        return ret;
+    }
+
+    /**
+     * \brief Convert a covariance matrix to its correlation matrix in place
+     * \return Reference to this matrix
+     */
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>&
+    toCorrelation() {
+        ComputeScalar s[Dimension];
+        symmat_internal::packedCorrelation(data(), Dimension, s, data());
+        return *this;
+    }
+
+    /**
+     * \brief Covariance matrix R_ij sigma_i sigma_j of a correlation matrix
+     * \param stddev Standard deviations sigma
+     * \return Covariance matrix
+     */
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    covariance(const Eigen::Matrix<Scalar, Dimension, 1>& stddev) const {
+        SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret;
+        Eigen::Matrix<ComputeScalar, Dimension, 1> s
+            = stddev.template cast<ComputeScalar>();
+        symmat_internal::packedScale(data(), Dimension, s.data(), ret.data());
+        return ret;
+    }
+
+    /**
+     * \brief Convert a correlation matrix to a covariance matrix in place
+     * \param stddev Standard deviations sigma
+     * \return Reference to this matrix
+     */
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>&
+    toCovariance(const Eigen::Matrix<Scalar, Dimension, 1>& stddev) {
+        Eigen::Matrix<ComputeScalar, Dimension, 1> s
+            = stddev.template cast<ComputeScalar>();
+        symmat_internal::packedScale(data(), Dimension, s.data(), data());
+        return *this;
+    }
+
+    /**
+     * \brief Principal square root S^1/2 of a positive definite matrix.
+     *
+     * Matrix functions are evaluated on the eigendecomposition S = V L V^T
+     * as V f(L) V^T, which is symmetric by construction and only computed
+     * for the upper triangle. The eigendecomposition starts from packed
+     * storage and is computed in closed form for dimension 2 and 3. Defined
+     * in SymmetricMatrixDecomposition.h, which has to be included.
+     *
+     * \return Square root, NaN if the matrix has negative eigenvalues
+     */
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    sqrt() const;
+
+    /**
+     * \brief Inverse square root S^-1/2 of a positive definite matrix,
+     * e.g., to whiten residuals.
+     * \see sqrt()
+     * \return Inverse square root, infinite or NaN if the matrix is not
+     * positive definite
+     */
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    inverseSqrt() const;
+
+    /**
+     * \brief Matrix exponential of a symmetric matrix
+     * \see sqrt()
+     * \return Matrix exponential, which is positive definite
+     */
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    exp() const;
+
+    /**
+     * \brief Principal matrix logarithm of a positive definite matrix
+     * \see sqrt()
+     * \return Matrix logarithm, infinite or NaN if the matrix is not
+     * positive definite
+     */
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    log() const;
+
+    /**
+     * \brief Square A^2 of the matrix
+     *
+     * A^2 is symmetric, so only its lower triangle is computed, with half
+     * the flops of operator*, and the result stays packed.
+     *
+     * \return A^2
+     */
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    square() const {
+        return pow(2);
+    }
+
+    /**
+     * \brief Power A^k of the matrix by repeated squaring
+     *
+     * Every product computes only one triangle of the symmetric result. The
+     * intermediate powers are kept in ComputeScalar.
+     *
+     * \param k Non-negative exponent, A^0 is the identity
+     * \return A^k
+     */
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    pow(int k) const {
+        eigen_assert(k >= 0 && "Negative powers are not supported");
+        Eigen::Matrix<ComputeScalar, Dimension, Dimension> base
+            = Base::template cast<ComputeScalar>();
+        SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret;
+        symmat_internal::packLower(
+            symmat_internal::symmetricPower(base, k), ret.data());
+        return ret;
+    }
+
+    /**
+     * \brief Gram matrix B B^T of a (not necessarily square) matrix B
+     *
+     * Only the lower triangle of B B^T is computed, in ComputeScalar, and
+     * packed. For a symmetric matrix A, A A^T is square().
+     *
+     * \param b Matrix with as many rows as the dimension of the result
+     * \return B B^T
+     */
+    template<typename Derived>
+    static SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    gram(const Eigen::MatrixBase<Derived>& b) {
+        typedef Eigen::Matrix<ComputeScalar, Eigen::Dynamic, Eigen::Dynamic>
+            Matrix;
+        eigen_assert(b.rows() == Dimension
+            && "Cannot compute the Gram matrix of a matrix with not "
+            && "matching number of rows.");
+        const Matrix factor = b.template cast<ComputeScalar>();
+        Matrix product(b.rows(), b.rows());
+        product.template triangularView<Eigen::Lower>()
+            = factor * factor.transpose();
+        SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret;
+        symmat_internal::packLower(product, ret.data());
+        return ret;
+    }
+
+    /**
+     * \brief Trace tr A from the Dimension diagonal elements, computed in
+     * ComputeScalar.
+     * \return tr A
+     */
+    Scalar trace() const {
+        return static_cast<Scalar>(
+            symmat_internal::packedTrace<ComputeScalar>(data(), Dimension));
+    }
+
+    /**
+     * \brief Trace tr(A B) of the product with another symmetric matrix
+     *
+     * tr(A B) = sum_ij a_ij b_ij, which is read from both packed storages in
+     * one pass with the off-diagonal elements weighted by 2 (see
+     * symmat_internal::packedTraceOfProduct()). The product is never formed,
+     * so this costs O(n^2) instead of O(n^3).
+     *
+     * \param other Matrix with the same dimension
+     * \return tr(A B)
+     */
+    template<int OtherDimension>
+    Scalar traceOfProduct(
+        const SymmetricMatrix<Scalar, OtherDimension, ComputeScalar>& other)
+        const {
+        eigen_assert(Dimension == other.dim()
+            && "Operation traceOfProduct cannot be performed for instances "
+            && "of SymmetricMatrix with not matching dimension");
+        return static_cast<Scalar>(
+            symmat_internal::packedTraceOfProduct<ComputeScalar, false>(
+                data(), other.data(), Dimension));
+    }
+
+    /**
+     * \brief Frobenius inner product <A, B>_F = sum_ij conj(a_ij) b_ij
+     *
+     * Computed like traceOfProduct() from the packed storages. For real
+     * matrices both are the same.
+     *
+     * \param other Matrix with the same dimension
+     * \return <A, B>_F
+     */
+    template<int OtherDimension>
+    Scalar frobeniusDot(
+        const SymmetricMatrix<Scalar, OtherDimension, ComputeScalar>& other)
+        const {
+        eigen_assert(Dimension == other.dim()
+            && "Operation frobeniusDot cannot be performed for instances "
+            && "of SymmetricMatrix with not matching dimension");
+        return static_cast<Scalar>(
+            symmat_internal::packedTraceOfProduct<ComputeScalar, true>(
+                data(), other.data(), Dimension));
+    }
+
+    /**
+     * \brief View of the top left k x k corner without copying.
+     *
+     * Element (row, col) of the view is element (row, col) of this matrix.
+     * The view is invalidated when this matrix is destroyed.
+     *
+     * \param k Dimension of the corner
+     * \return Writable view of the corner
+     */
+    SymmetricMatrixView<Scalar, ComputeScalar>
+    topLeftCorner(int k) {
+        eigen_assert(k >= 0 && k <= Dimension
+            && "Corner is larger than the matrix");
+        return SymmetricMatrixView<Scalar, ComputeScalar>(data(), Dimension,
+                                                          k);
+    }
+
+    /**
+     * \brief Read-only view of the top left k x k corner without copying
+     * \param k Dimension of the corner
+     * \return Read-only view of the corner
+     */
+    SymmetricMatrixView<const Scalar, ComputeScalar>
+    topLeftCorner(int k) const {
+        eigen_assert(k >= 0 && k <= Dimension
+            && "Corner is larger than the matrix");
+        return SymmetricMatrixView<const Scalar, ComputeScalar>(data(),
+                                                                Dimension, k);
+    }
+
+    /**
+     * \brief View of the principal submatrix of the rows and columns indices
+     * without copying.
+     *
+     * Element (row, col) of the view is element (indices[row], indices[col])
+     * of this matrix. The view is invalidated when this matrix is destroyed.
+     *
+     * \param indices Distinct rows and columns that form the submatrix
+     * \return Writable view of the submatrix
+     */
+    SymmetricMatrixView<Scalar, ComputeScalar>
+    principal(const std::vector<int>& indices) {
+        return SymmetricMatrixView<Scalar, ComputeScalar>(data(), Dimension,
+                                                          indices);
+    }
+
+    /**
+     * \brief Read-only view of the principal submatrix of the rows and
+     * columns indices without copying
+     * \param indices Distinct rows and columns that form the submatrix
+     * \return Read-only view of the submatrix
+     */
+    SymmetricMatrixView<const Scalar, ComputeScalar>
+    principal(const std::vector<int>& indices) const {
+        return SymmetricMatrixView<const Scalar, ComputeScalar>(data(),
+            Dimension, indices);
+    }
+
+    /**
+     * \brief Schur complement S_aa - S_ab S_bb^-1 S_ba, i.e., the
+     * marginalization of an information matrix onto the rows and columns
+     * keep.
+     *
+     * All rows and columns that are not in keep form the block b that is
+     * eliminated. S_bb is factorized in packed storage and S_aa is updated
+     * with a packed rank update, so the matrix is never expanded. No
+     * exception is thrown.
+     *
+     * \param keep Distinct rows and columns a that are kept, in the order
+     * they appear in the result
+     * \param result Schur complement of dimension keep.size(), unchanged if
+     * S_bb is not positive definite
+     * \return Eigen::NumericalIssue if S_bb is not positive definite,
+     * Eigen::Success otherwise
+     */
+    Eigen::ComputationInfo
+    schurComplement(const std::vector<int>& keep,
+                    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>&
+                    result) const {
+        std::vector<Scalar> packed;
+        Eigen::ComputationInfo info
+            = symmat_internal::schurComplement<ComputeScalar>(data(),
+                                                              Dimension, keep,
+                                                              packed);
+        if (info == Eigen::Success) {
+            result = SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>(
+                packed, keep.size());
+        }
+        return info;
+    }
+
+    /* Overloaded operators */
+
+    /**
+     * \brief Operator () to access a single element of the matrix
+     * 
+     * Overloaded operator () to access a single element of the current instance
+     * of SymmetricMatrix.
+     * 
+     * \param row The row index of the element
+     * \param col The column index of the element
+     * \return Reference to the element (row, col) of the matrix
+     */
+    Scalar&
+    operator()(int row, int col) {
+        if (row <= col) {
+            return elements[row * Dimension - (row - 1)*((row - 1) + 1)/2
+                            + col - row];
+        } else {
+            return elements[col * Dimension - (col - 1)*((col - 1) + 1)/2
+                            + row - col];
+        }
+    }
+
+    /**
+     * \brief Operator << to push the elements of the matrix into an out-stream.
+     * 
+     * To print the matrix the operator << is overloaded. 
+     * 
+     * \param stream The out-stream
+     * \param mat The matrix to push into stream
+     */
+    friend std::ostream&
+    operator<<(std::ostream& stream,
+               SymmetricMatrix<Scalar, Dimension, ComputeScalar>& mat) {
+        for (int row = 0; row < Dimension; ++row) {
+            for (int col = 0; col < Dimension; ++col) {
+                stream << mat(row, col) << " ";
+            }
+            stream << ((row == Dimension - 1)?"":"\n");
+        }
+        return stream;
+    }
+
+    /**
+     * \brief Overloaded operator + to add a SymmetricMatrix with fixed
+     * dimension.
+     * \param other Matrix to add
+     * \return Sum of both matrices
+     */
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    operator+(const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& other) {
+        // Construct new matrix and set underlying std::array
+        SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret(elements);
+        // Just add up both underlying std::vector
+        for (int i = 0; i < (Dimension*Dimension+Dimension)/2; ++i) {
            ret.elements[i] += other.elements[i];
         }
         return ret;
@@ -214,15 +1639,16 @@ class SymmetricMatrix {
      * \param other Matrix to add
      * \return Sum of both matrices
      */
-    SymmetricMatrix<Scalar, Dimension>
-    operator+(const SymmetricMatrix<Scalar>& other) {
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    operator+(
+        const SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>& other) {
         // Check if dynamic dimension is equal to fixed one
         eigen_assert(Dimension == other.dim() 
             && "Operation + cannot be performed for instances of "
             && "SymmetricMatrix with not matching dimension");
 
         // Construct new matrix and set underlying std::array
-        SymmetricMatrix<Scalar, Dimension> ret(elements);
+        SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret(elements);
 
         // Just add up the underlying std::array and std::vector
         for (int i = 0; i < (Dimension*Dimension+Dimension)/2; ++i) {
@@ -237,10 +1663,10 @@ class SymmetricMatrix {
      * \param other Matrix to subtract
      * \return Difference of both matrices
      */
-    SymmetricMatrix<Scalar, Dimension>
-    operator-(const SymmetricMatrix<Scalar, Dimension>& other) {
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    operator-(const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& other) {
         // Construct new matrix and set underlying std::array
-        SymmetricMatrix<Scalar, Dimension> ret(elements);
+        SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret(elements);
 
         // Just add up both underlying std::array and std::vector
         for (int i = 0; i < (Dimension*Dimension+Dimension)/2; ++i) {
@@ -255,15 +1681,16 @@ class SymmetricMatrix {
      * \param other Matrix to subtract
      * \return Difference of both matrices
      */
-    SymmetricMatrix<Scalar, Dimension>
-    operator-(const SymmetricMatrix<Scalar>& other) {
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    operator-(
+        const SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>& other) {
         // Check if dynamic dimension is equal to fixed one
         eigen_assert(Dimension == other.dim() 
             && "Operation + cannot be performed for instances of "
             && "SymmetricMatrix with not matching dimension");
 
         // Construct new matrix and set underlying std::array
-        SymmetricMatrix<Scalar, Dimension> ret(elements);
+        SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret(elements);
         // Just add up both underlying std::vector
         for (int i = 0; i < (Dimension*Dimension+Dimension)/2; ++i) {
            ret.elements[i] -= other.elements[i];
@@ -271,6 +1698,78 @@ class SymmetricMatrix {
         return ret;
     }
 
+    /**
+     * \brief Overloaded operator += to add a SymmetricMatrix with fixed
+     * dimension in place.
+     * \param other Matrix to add
+     * \return Reference to the current instance
+     */
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>&
+    operator+=(const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& other) {
+        for (int i = 0; i < (Dimension*Dimension+Dimension)/2; ++i) {
+           elements[i] += other.elements[i];
+        }
+        return *this;
+    }
+
+    /**
+     * \brief Scaled addition alpha X + beta A in place in one pass over the
+     * packed storage.
+     * \param alpha Factor of x
+     * \param x Matrix with the same dimension
+     * \param beta Factor of the current instance
+     * \return Reference to the current instance
+     */
+    template<int OtherDimension>
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>&
+    axpby(const ComputeScalar& alpha,
+          const SymmetricMatrix<Scalar, OtherDimension, ComputeScalar>& x,
+          const ComputeScalar& beta) {
+        eigen_assert(Dimension == x.dim()
+            && "Operation axpby cannot be performed for instances of "
+            && "SymmetricMatrix with not matching dimension");
+        symmat_internal::packedAxpby(alpha, x.data(), beta, data(),
+                                     (Dimension * Dimension + Dimension) / 2);
+        return *this;
+    }
+
+    /**
+     * \brief Add lambda to the diagonal, e.g., for damping A + lambda I.
+     * Only the Dimension diagonal elements are touched.
+     * \param lambda Value to add
+     * \return Reference to the current instance
+     */
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar>&
+    addDiagonal(const ComputeScalar& lambda) {
+        symmat_internal::packedAddDiagonal(data(), Dimension, lambda);
+        return *this;
+    }
+
+    /**
+     * \brief Linear combination sum_k coefficients[k] matrices[k] in one
+     * pass over the packed storage.
+     * \param coefficients Factors of the matrices
+     * \param matrices Matrices of the same dimension, as many as
+     * coefficients
+     * \return Linear combination, the zero matrix if there are no matrices
+     */
+    static SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+    linearCombination(const std::vector<ComputeScalar>& coefficients,
+                      const std::vector<const SymmetricMatrix<
+                          Scalar, Dimension, ComputeScalar>*>& matrices) {
+        eigen_assert(coefficients.size() == matrices.size()
+            && "Number of coefficients and matrices do not match");
+        std::vector<const Scalar*> sources(matrices.size());
+        for (size_t k = 0; k < matrices.size(); ++k) {
+            sources[k] = matrices[k]->data();
+        }
+        SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret;
+        symmat_internal::packedLinearCombination(coefficients.data(),
+            sources.data(), sources.size(),
+            (Dimension * Dimension + Dimension) / 2, ret.data());
+        return ret;
+    }
+
    /**
      * \brief Overloaded operator + to add an Eigen::Matrix with fixed dimension.
      * \param other Matrix to subtract
@@ -371,10 +1870,11 @@ class SymmetricMatrix {
      * \return Product of both matrices
      */
     Eigen::Matrix<Scalar, Dimension, Dimension>
-    operator*(SymmetricMatrix<Scalar, Dimension>& other) {
-        return Eigen::Matrix<Scalar, Eigen::Dynamic,
-                             Eigen::Dynamic>(constructEigenMatrix()
-                                             * other.constructEigenMatrix());
+    operator*(SymmetricMatrix<Scalar, Dimension, ComputeScalar>& other) {
+        return Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>(
+            (constructEigenMatrix().template cast<ComputeScalar>()
+             * other.constructEigenMatrix().template cast<ComputeScalar>())
+            .template cast<Scalar>());
     }
 
     /**
@@ -384,10 +1884,11 @@ class SymmetricMatrix {
      * \return Product of both matrices
      */
     Eigen::Matrix<Scalar, Dimension, Dimension>
-    operator*(SymmetricMatrix<Scalar>& other) {
-        return Eigen::Matrix<Scalar, Eigen::Dynamic,
-                             Eigen::Dynamic>(constructEigenMatrix()
-                                             * other.constructEigenMatrix());
+    operator*(SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>& other) {
+        return Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>(
+            (constructEigenMatrix().template cast<ComputeScalar>()
+             * other.constructEigenMatrix().template cast<ComputeScalar>())
+            .template cast<Scalar>());
     }
 
 
@@ -419,147 +1920,820 @@ class SymmetricMatrix {
      * \brief Construct SymmetricMatrix from std::array. 
      * \param arr std::array that contains the matrix elements
      */
-#if CPP11_SUPPORT
-    SymmetricMatrix(const std::array<Scalar,
-        (Dimension*Dimension+Dimension)/2>& arr) : elements(arr) {}
-#else
-    SymmetricMatrix(const Scalar arr[]) {
-        for (int i = 0; i < (Dimension * Dimension + Dimension) / 2; ++i)
-            elements[i] = arr[i];
+#if CPP11_SUPPORT
+    SymmetricMatrix(const std::array<Scalar,
+        (Dimension*Dimension+Dimension)/2>& arr) : elements(arr) {}
+#else
+    SymmetricMatrix(const Scalar arr[]) {
+        for (int i = 0; i < (Dimension * Dimension + Dimension) / 2; ++i)
+            elements[i] = arr[i];
+    }
+#endif
+
+#if CPP11_SUPPORT
+    /**
+     * \brief Calculate size of the underlying std::array at compile-time
+     * \return Size of underlying std::array
+     */
+    static constexpr int calcArraySize();
+    std::array<Scalar, calcArraySize()> elements;
+#else
+    Scalar elements[(Dimension*Dimension+Dimension)/2];
+#endif
+};
+
+#if CPP11_SUPPORT
+template<typename Scalar, int Dimension, typename ComputeScalar>
+constexpr int
+SymmetricMatrix<Scalar, Dimension, ComputeScalar>::calcArraySize() {
+    return (Dimension * Dimension + Dimension) / 2;
+}
+#endif
+
+/**
+ * \class SymmetricMatrix<Scalar, Eigen::Dynamic>
+ * \brief Partial template specialisation where Dimension = Eigen::Dynamic.
+ * 
+ * This class represents symmetric matrices with dynamic dimension, i.e, the
+ * matrix dimension can be chosen and changes at runtime. This class is in
+ * particular suitable for large matrices as the matrix elements are stored
+ * an the heap.
+ */
+template<typename Scalar, typename ComputeScalar>
+class SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    : public Eigen::MatrixBase<SymmetricMatrix<Scalar, Eigen::Dynamic,
+                                               ComputeScalar> > {
+ public:
+    typedef Eigen::MatrixBase<SymmetricMatrix<Scalar, Eigen::Dynamic,
+                                              ComputeScalar> > Base;
+    using Base::operator+;
+    using Base::operator-;
+    using Base::operator*;
+    typedef typename Eigen::internal::ref_selector<SymmetricMatrix>::type
+        Nested;
+
+    /*
+     * The operators of Eigen::MatrixBase for Eigen expressions are const,
+     * the ones below that take an Eigen::Matrix are not. Without these
+     * overloads, an expression that converts to Eigen::Matrix would make
+     * the call ambiguous for a non-const matrix.
+     */
+    template<typename OtherDerived>
+    const Eigen::CwiseBinaryOp<
+        Eigen::internal::scalar_sum_op<Scalar, typename OtherDerived::Scalar>,
+        const SymmetricMatrix, const OtherDerived>
+    operator+(const Eigen::MatrixBase<OtherDerived>& other) {
+        return Base::operator+(other);
+    }
+
+    template<typename OtherDerived>
+    const Eigen::CwiseBinaryOp<
+        Eigen::internal::scalar_difference_op<Scalar,
+                                              typename OtherDerived::Scalar>,
+        const SymmetricMatrix, const OtherDerived>
+    operator-(const Eigen::MatrixBase<OtherDerived>& other) {
+        return Base::operator-(other);
+    }
+
+    template<typename OtherDerived>
+    const Eigen::Product<SymmetricMatrix, OtherDerived>
+    operator*(const Eigen::MatrixBase<OtherDerived>& other) {
+        return Base::operator*(other);
+    }
+
+    /**
+     * \brief Default constructor that constructs a 0-dimensional symmetric matrix
+     */
+    SymmetricMatrix() : dimension(0) {}
+
+#if CPP11_SUPPORT
+    SymmetricMatrix(const SymmetricMatrix& other) = default;
+    SymmetricMatrix(SymmetricMatrix&& other) = default;
+
+    /**
+     * \brief Move assignment of the packed storage and the cached
+     * factorization
+     */
+    SymmetricMatrix&
+    operator=(SymmetricMatrix&& other) {
+        elements = std::move(other.elements);
+        dimension = other.dimension;
+        cache = std::move(other.cache);
+        return *this;
+    }
+#endif
+
+    /**
+     * \brief Copy assignment of the packed storage and the cached
+     * factorization
+     *
+     * Declared explicitly since the one of Eigen::MatrixBase would assign
+     * through Eigen, which SymmetricMatrix does not allow.
+     */
+    SymmetricMatrix&
+    operator=(const SymmetricMatrix& other) {
+        elements = other.elements;
+        dimension = other.dimension;
+        cache = other.cache;
+        return *this;
+    }
+
+    /**
+     * \brief Constructor that reserves size for the underlying container
+     * \param dimension Dimension of the matrix
+     */
+    explicit SymmetricMatrix(size_t dimension) : dimension(dimension) {
+        elements.reserve((dimension*dimension+dimension)/2);
+    }
+
+    /**
+     * \brief Constructor that builds a symmetric matrix from an Eigen::Matrix
+     * 
+     * The Eigen::Matrix that is passed as an argument must be a square matrix and
+     * have the template parameters Eigen::Dynamic
+     * 
+     * \param mat Instance of Eigen::Matrix
+     */
+    SymmetricMatrix(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>&
+        mat) : dimension(mat.cols()) {
+        // check if mat is a square matrix
+        eigen_assert(mat.cols() == mat.rows() 
+            && "No instance of SymmetricMatrix can be constructed "
+            && "from non-square matrix of type Eigen::Matrix");
+
+        // Push upper triangular part of mat into the underlying std::vector
+        for (int row = 0; row < dimension; row++) {
+            for (int col = row; col < dimension; col++) {
+                elements.push_back(mat(row, col));
+            }
+        }
+    }
+
+    /**
+     * \brief Constructor that gathers a principal submatrix from the packed
+     * storage of the parent matrix
+     * \param view View of the principal submatrix
+     */
+    template<typename ViewScalar>
+    explicit SymmetricMatrix(
+        const SymmetricMatrixView<ViewScalar, ComputeScalar>& view)
+    : elements((view.dim() * view.dim() + view.dim()) / 2),
+      dimension(view.dim()) {
+        view.gather(elements.data());
+    }
+
+    /**
+     * \brief Constructor that builds a symmetric matrix from a std::vector<T>.
+     * \param vec std::vector<Scalar> that contains the elements of the upper
+     * triangular part of the matrix
+     */
+    explicit SymmetricMatrix(const std::vector<Scalar>& vec) : elements(vec) {
+        // Calculation of dimension
+        dimension = (std::sqrt(1 + 8 * vec.size()) - 1) / 2;
+    }
+
+    /**
+     * \brief Constructor that builds a symmetric matrix from a std::vector<T>.
+     * \param vec std::vector<Scalar> that contains the elements of the upper
+     * triangular part of the matrix
+     * \param dimension The dimension of the matrix. It doesn't have to be
+     * calculated.
+     */
+    SymmetricMatrix(const std::vector<Scalar>& vec, int dimension)
+    : elements(vec), dimension(dimension) {}
+
+    /**
+     * \brief Checks if a matrix of type Eigen::Matrix is symmetric or not.
+     * \param mat Matrix of type Eigen::Matrix.
+     * \return True if mat is symmetric, false otherwise
+     */
+    static bool
+    isSymmetric(const Eigen::Matrix<Scalar,
+                                    Eigen::Dynamic, Eigen::Dynamic>& mat) {
+        // if mat is not square its not symmetric
+        if (mat.cols() != mat.rows()) {
+            return false;
+        }
+        // if mat is square we check if it is equal to the transposed matrix
+        return (mat == mat.transpose())?true:false;
+    }
+
+    /**
+     * \brief Get a SymmetricMatrix with dynamic dimension that is filled with
+     * random values.
+     * \param dim Dimension of the dynamic matrix
+     * \return SymmetricMatrix filled with random values
+     */
+    static SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    Random(int dim) {
+        eigen_assert(dim >=0 
+            && "Cannot construct matrix with negative "
+            && "dimension");
+       
+        return SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>(
+            static_cast<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> >(
+                Eigen::Matrix<Scalar,
+                              Eigen::Dynamic,
+                              Eigen::Dynamic>::Random(dim, dim)));
+    }
+
+    /**
+     * \brief Get a SymmetricMatrix with dynamic dimension that is filled with
+     * zeros.
+     * \param dim Dimension of the dynamic matrix
+     * \return SymmetricMatrix filled with zeros
+     */
+    static SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    Zero(int dim) {
+        eigen_assert(dim >=0 
+            && "Cannot construct matrix with negative "
+            && "dimension");
+
+        return SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>(
+            std::vector<Scalar>((dim*dim+dim)/2, Scalar(0)), dim);
+    }
+
+    /**
+     * \brief Dimension of the symmetric matrix.
+     *
+     * Since any symmetric matrix is a square matrix no difference between
+     * row-number and column-number has to be considered.
+     * /return Dimension of the symmetric matrix.
+     */
+    size_t dim() const {
+        return dimension;
+    }
+
+    /**
+     * \brief Number of rows, i.e., the dimension, for Eigen::MatrixBase.
+     */
+    Eigen::Index rows() const {
+        return dimension;
+    }
+
+    /**
+     * \brief Number of columns, i.e., the dimension, for Eigen::MatrixBase.
+     */
+    Eigen::Index cols() const {
+        return dimension;
+    }
+
+    /**
+     * \brief Pointer to the packed storage, i.e., the upper triangular part
+     * stored row by row.
+     * \return Pointer to the first element
+     */
+    Scalar* data() {
+        cache.invalidate();
+        return elements.data();
+    }
+
+    /**
+     * \brief Pointer to the packed storage, i.e., the upper triangular part
+     * stored row by row.
+     * \return Const pointer to the first element
+     */
+    const Scalar* data() const {
+        return elements.data();
+    }
+
+    /**
+     * \brief Convert the elements to another scalar type.
+     * \return SymmetricMatrix with elements of type NewScalar
+     */
+    template<typename NewScalar>
+    SymmetricMatrix<NewScalar, Eigen::Dynamic>
+    cast() const {
+        return cast<NewScalar, NewScalar>();
+    }
+
+    /**
+     * \brief Convert the elements to another scalar type and choose the
+     * type used for computations.
+     * \return SymmetricMatrix with elements of type NewScalar
+     */
+    template<typename NewScalar, typename NewComputeScalar>
+    SymmetricMatrix<NewScalar, Eigen::Dynamic, NewComputeScalar>
+    cast() const {
+        std::vector<NewScalar> vec(elements.size());
+        symmat_internal::convertElements(elements.data(), elements.size(),
+                                         vec.data());
+        return SymmetricMatrix<NewScalar, Eigen::Dynamic, NewComputeScalar>(
+            vec, dimension);
+    }
+
+    /**
+     * \brief Check if the matrix is positive definite.
+     *
+     * Attempts a Cholesky factorization in packed storage that stops at the
+     * first pivot that is not positive. No exception is thrown.
+     *
+     * \return True if the matrix is positive definite, false otherwise
+     */
+    bool isPositiveDefinite() const {
+        std::vector<ComputeScalar> work;
+        bool positiveDefinite;
+        factorize(work, positiveDefinite);
+        return positiveDefinite;
+    }
+
+    /**
+     * \brief Estimate the reciprocal condition number in the 1-norm.
+     *
+     * Factorizes the matrix in packed storage and estimates the 1-norm of the
+     * inverse with the Hager/Higham estimator, so the inverse is never
+     * formed. No exception is thrown.
+     *
+     * \return Estimate of 1 / (|A|_1 |A^-1|_1), or 0 if the matrix is not
+     * positive definite or empty
+     */
+    Scalar rcondEstimate() const {
+        if (dimension == 0) {
+            return Scalar(0);
+        }
+        std::vector<ComputeScalar> work, x(dimension), y(dimension);
+        ComputeScalar norm = symmat_internal::packedNorm1(elements.data(),
+                                                          dimension, x.data());
+        bool positiveDefinite;
+        const ComputeScalar* u = factorize(work, positiveDefinite);
+        if (!positiveDefinite) {
+            return Scalar(0);
+        }
+        return static_cast<Scalar>(ComputeScalar(1) / (norm
+            * symmat_internal::packedInverseNorm1Estimate(u, dimension,
+                                                          x.data(),
+                                                          y.data())));
+    }
+
+    /**
+     * \brief Logarithm of the determinant.
+     *
+     * Computed from the diagonal of a Cholesky factorization in packed
+     * storage. Matrices that are not positive definite fall back to the
+     * determinant of the expanded matrix. No exception is thrown.
+     *
+     * \return log det A, -infinity if A is singular and NaN if det A is
+     * negative
+     */
+    Scalar logDeterminant() const {
+        std::vector<ComputeScalar> work;
+        bool positiveDefinite;
+        const ComputeScalar* u = factorize(work, positiveDefinite);
+        if (positiveDefinite) {
+            return static_cast<Scalar>(
+                symmat_internal::packedLogDeterminant(u, dimension));
+        }
+        return static_cast<Scalar>(std::log(symmat_internal
+            ::packedDenseDeterminant<ComputeScalar, Eigen::Dynamic>(
+                elements.data(), dimension)));
+    }
+
+    /**
+     * \brief Determinant.
+     *
+     * Computed as the squared product of the diagonal of a Cholesky
+     * factorization in packed storage. Matrices that are not positive
+     * definite fall back to the determinant of the expanded matrix. Prefer
+     * logDeterminant() for larger dimensions, where the determinant easily
+     * over- or underflows.
+     *
+     * \return det A, 1 for an empty matrix
+     */
+    Scalar determinant() const {
+        std::vector<ComputeScalar> work;
+        bool positiveDefinite;
+        const ComputeScalar* u = factorize(work, positiveDefinite);
+        if (positiveDefinite) {
+            ComputeScalar product(1);
+            for (size_t i = 0; i < dimension; ++i) {
+                product *= u[symmat_internal::packedIndex(i, i, dimension)];
+            }
+            return static_cast<Scalar>(product * product);
+        }
+        return static_cast<Scalar>(symmat_internal
+            ::packedDenseDeterminant<ComputeScalar, Eigen::Dynamic>(
+                elements.data(), dimension));
+    }
+
+    /**
+     * \brief Solve A x = b for a positive definite matrix A.
+     *
+     * Uses the packed Cholesky factor, so the matrix is never expanded. With
+     * cacheFactorization() enabled, repeated solves cost O(n^2) each.
+     *
+     * \param b Right hand side, a vector or a matrix with one right hand side
+     * per column
+     * \return Solution in ComputeScalar, NaN if A is not positive definite
+     */
+    template<typename Rhs>
+    Eigen::Matrix<ComputeScalar, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+    solve(const Eigen::MatrixBase<Rhs>& b) const {
+        eigen_assert(static_cast<size_t>(b.rows()) == dimension
+            && "Dimensions of matrix and right hand side do not match");
+        Eigen::Matrix<ComputeScalar, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+            x = b.template cast<ComputeScalar>();
+        std::vector<ComputeScalar> work;
+        bool positiveDefinite;
+        const ComputeScalar* u = factorize(work, positiveDefinite);
+        if (!positiveDefinite) {
+            x.setConstant(std::numeric_limits<ComputeScalar>::quiet_NaN());
+            return x;
+        }
+        for (Eigen::Index c = 0; c < x.cols(); ++c) {
+            symmat_internal::packedForwardSolve(u, dimension, x.col(c).data());
+            symmat_internal::packedBackSolve(u, dimension, x.col(c).data());
+        }
+        return x;
+    }
+
+    /**
+     * \brief Inverse of a positive definite matrix.
+     *
+     * Computed as U^-1 U^-T from the packed Cholesky factor U (see
+     * symmat_internal::packedCholeskyInverse()), which is symmetric by
+     * construction and only computed for the upper triangle.
+     *
+     * \return Inverse, NaN if the matrix is not positive definite
+     */
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    inverse() const {
+        std::vector<ComputeScalar> work;
+        bool positiveDefinite;
+        const ComputeScalar* u = factorize(work, positiveDefinite);
+        std::vector<Scalar> ret(elements.size(),
+                                std::numeric_limits<Scalar>::quiet_NaN());
+        if (positiveDefinite) {
+            std::vector<ComputeScalar> inv(elements.size()), x(dimension);
+            symmat_internal::packedCholeskyInverse(u, dimension, inv.data(),
+                                                   x.data());
+            symmat_internal::convertElements(inv.data(), inv.size(),
+                                             ret.data());
+        }
+        return SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>(
+            ret, dimension);
+    }
+
+    /**
+     * \brief Chi-square r^T A^-1 r of a residual r with covariance A.
+     *
+     * Computed as |U^-T r|^2 with one triangular solve.
+     *
+     * \param r Residual of size dim()
+     * \return Chi-square, NaN if A is not positive definite
+     */
+    template<typename Derived>
+    Scalar chi2(const Eigen::MatrixBase<Derived>& r) const {
+        eigen_assert(static_cast<size_t>(r.size()) == dimension
+            && "Dimensions of matrix and residual do not match");
+        std::vector<ComputeScalar> work;
+        bool positiveDefinite;
+        const ComputeScalar* u = factorize(work, positiveDefinite);
+        if (!positiveDefinite) {
+            return std::numeric_limits<Scalar>::quiet_NaN();
+        }
+        Eigen::Matrix<ComputeScalar, Eigen::Dynamic, 1> y
+            = r.template cast<ComputeScalar>();
+        symmat_internal::packedForwardSolve(u, dimension, y.data());
+        return static_cast<Scalar>(y.squaredNorm());
+    }
+
+    /**
+     * \brief Keep the packed Cholesky factor between queries.
+     *
+     * Caching is disabled by default. Once enabled, the first of solve(),
+     * inverse(), chi2(), determinant(), logDeterminant(),
+     * isPositiveDefinite() and rcondEstimate() factorizes the matrix and
+     * keeps the factor, so that later queries skip the O(n^3)
+     * factorization. operator(), data(), operator+=, toCorrelation(),
+     * toCovariance() and writes through views obtained by topLeftCorner()
+     * and principal() discard the factor. Writes through a pointer returned
+     * by data() are not tracked, so do not keep it across queries. Since
+     * queries then write the cache, an instance with caching enabled must not
+     * be queried by several threads at the same time.
+     *
+     * \param enable True to enable, false to disable caching and release the
+     * factor
+     */
+    void cacheFactorization(bool enable = true) {
+        cache.enabled = enable;
+        cache.invalidate();
+        if (!enable) {
+            std::vector<ComputeScalar>().swap(cache.factor);
+        }
+    }
+
+    /**
+     * \brief Whether a valid factor is cached, i.e., whether the next query
+     * skips the factorization
+     */
+    bool isFactorizationCached() const {
+        return cache.valid;
+    }
+
+    /**
+     * \brief Correlation matrix C_ij / sqrt(C_ii C_jj) of a covariance
+     * matrix.
+     *
+     * Computed directly in packed storage. Variances that are not positive
+     * yield non-finite correlations.
+     *
+     * \return Correlation matrix with a diagonal of ones
+     */
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    correlation() const {
+        SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> ret(*this);
+        return ret.toCorrelation();
+    }
+
+    /**
+     * \brief Convert a covariance matrix to its correlation matrix in place
+     * \return Reference to this matrix
+     */
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>&
+    toCorrelation() {
+        std::vector<ComputeScalar> s(dimension);
+        symmat_internal::packedCorrelation(data(), dimension, s.data(),
+                                           data());
+        return *this;
+    }
+
+    /**
+     * \brief Covariance matrix R_ij sigma_i sigma_j of a correlation matrix
+     * \param stddev Standard deviations sigma
+     * \return Covariance matrix
+     */
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    covariance(const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& stddev) const {
+        SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> ret(*this);
+        return ret.toCovariance(stddev);
+    }
+
+    /**
+     * \brief Convert a correlation matrix to a covariance matrix in place
+     * \param stddev Standard deviations sigma, one per row
+     * \return Reference to this matrix
+     */
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>&
+    toCovariance(const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& stddev) {
+        eigen_assert(static_cast<size_t>(stddev.size()) == dimension
+            && "Number of standard deviations does not match the dimension");
+        Eigen::Matrix<ComputeScalar, Eigen::Dynamic, 1> s
+            = stddev.template cast<ComputeScalar>();
+        symmat_internal::packedScale(data(), dimension, s.data(), data());
+        return *this;
+    }
+
+    /**
+     * \brief Principal square root S^1/2 of a positive definite matrix.
+     *
+     * Matrix functions are evaluated on the eigendecomposition S = V L V^T
+     * as V f(L) V^T, which is symmetric by construction and only computed
+     * for the upper triangle. The eigendecomposition starts from packed
+     * storage and is computed in closed form for dimension 2 and 3. Defined
+     * in SymmetricMatrixDecomposition.h, which has to be included.
+     *
+     * \return Square root, NaN if the matrix has negative eigenvalues
+     */
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    sqrt() const;
+
+    /**
+     * \brief Inverse square root S^-1/2 of a positive definite matrix,
+     * e.g., to whiten residuals.
+     * \see sqrt()
+     * \return Inverse square root, infinite or NaN if the matrix is not
+     * positive definite
+     */
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    inverseSqrt() const;
+
+    /**
+     * \brief Matrix exponential of a symmetric matrix
+     * \see sqrt()
+     * \return Matrix exponential, which is positive definite
+     */
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    exp() const;
+
+    /**
+     * \brief Principal matrix logarithm of a positive definite matrix
+     * \see sqrt()
+     * \return Matrix logarithm, infinite or NaN if the matrix is not
+     * positive definite
+     */
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    log() const;
+
+    /**
+     * \brief Square A^2 of the matrix
+     *
+     * A^2 is symmetric, so only its lower triangle is computed, with half
+     * the flops of operator*, and the result stays packed.
+     *
+     * \return A^2
+     */
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    square() const {
+        return pow(2);
     }
-#endif
 
-#if CPP11_SUPPORT
     /**
-     * \brief Calculate size of the underlying std::array at compile-time
-     * \return Size of underlying std::array
+     * \brief Power A^k of the matrix by repeated squaring
+     *
+     * Every product computes only one triangle of the symmetric result. The
+     * intermediate powers are kept in ComputeScalar.
+     *
+     * \param k Non-negative exponent, A^0 is the identity
+     * \return A^k
      */
-    static constexpr int calcArraySize();
-    std::array<Scalar, calcArraySize()> elements;
-#else
-    Scalar elements[(Dimension*Dimension+Dimension)/2];
-#endif
-};
-
-#if CPP11_SUPPORT
-template<typename Scalar, int Dimension>
-constexpr int SymmetricMatrix<Scalar, Dimension>::calcArraySize() {
-    return (Dimension * Dimension + Dimension) / 2;
-}
-#endif
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    pow(int k) const {
+        eigen_assert(k >= 0 && "Negative powers are not supported");
+        Eigen::Matrix<ComputeScalar, Eigen::Dynamic, Eigen::Dynamic> base
+            = Base::template cast<ComputeScalar>();
+        SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> ret(
+            std::vector<Scalar>(elements.size()), dimension);
+        symmat_internal::packLower(
+            symmat_internal::symmetricPower(base, k), ret.data());
+        return ret;
+    }
 
-/**
- * \class SymmetricMatrix<Scalar, Eigen::Dynamic>
- * \brief Partial template specialisation where Dimension = Eigen::Dynamic.
- * 
- * This class represents symmetric matrices with dynamic dimension, i.e, the
- * matrix dimension can be chosen and changes at runtime. This class is in
- * particular suitable for large matrices as the matrix elements are stored
- * an the heap.
- */
-template<typename Scalar>
-class SymmetricMatrix<Scalar, Eigen::Dynamic> {
- public:
     /**
-     * \brief Default constructor that constructs a 0-dimensional symmetric matrix
+     * \brief Gram matrix B B^T of a (not necessarily square) matrix B
+     *
+     * Only the lower triangle of B B^T is computed, in ComputeScalar, and
+     * packed. For a symmetric matrix A, A A^T is square().
+     *
+     * \param b Matrix with as many rows as the dimension of the result
+     * \return B B^T
      */
-    SymmetricMatrix() : dimension(0) {}
+    template<typename Derived>
+    static SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    gram(const Eigen::MatrixBase<Derived>& b) {
+        typedef Eigen::Matrix<ComputeScalar, Eigen::Dynamic, Eigen::Dynamic>
+            Matrix;
+        const Matrix factor = b.template cast<ComputeScalar>();
+        Matrix product(b.rows(), b.rows());
+        product.template triangularView<Eigen::Lower>()
+            = factor * factor.transpose();
+        const size_t n = b.rows();
+        SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> ret(
+            std::vector<Scalar>((n * n + n) / 2), n);
+        symmat_internal::packLower(product, ret.data());
+        return ret;
+    }
 
     /**
-     * \brief Constructor that reserves size for the underlying container
-     * \param dimension Dimension of the matrix
+     * \brief Trace tr A from the dim() diagonal elements, computed in
+     * ComputeScalar.
+     * \return tr A
      */
-    explicit SymmetricMatrix(size_t dimension) : dimension(dimension) {
-        elements.reserve((dimension*dimension+dimension)/2);
+    Scalar trace() const {
+        return static_cast<Scalar>(
+            symmat_internal::packedTrace<ComputeScalar>(data(), dimension));
     }
 
     /**
-     * \brief Constructor that builds a symmetric matrix from an Eigen::Matrix
-     * 
-     * The Eigen::Matrix that is passed as an argument must be a square matrix and
-     * have the template parameters Eigen::Dynamic
-     * 
-     * \param mat Instance of Eigen::Matrix
+     * \brief Trace tr(A B) of the product with another symmetric matrix
+     *
+     * tr(A B) = sum_ij a_ij b_ij, which is read from both packed storages in
+     * one pass with the off-diagonal elements weighted by 2 (see
+     * symmat_internal::packedTraceOfProduct()). The product is never formed,
+     * so this costs O(n^2) instead of O(n^3).
+     *
+     * The term tr(S1^-1 S2) of the Kullback-Leibler divergence of two
+     * Gaussians is S1.inverse().traceOfProduct(S2).
+     *
+     * \param other Matrix with the same dimension
+     * \return tr(A B)
      */
-    SymmetricMatrix(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>&
-        mat) : dimension(mat.cols()) {
-        // check if mat is a square matrix
-        eigen_assert(mat.cols() == mat.rows() 
-            && "No instance of SymmetricMatrix can be constructed "
-            && "from non-square matrix of type Eigen::Matrix");
+    template<int OtherDimension>
+    Scalar traceOfProduct(
+        const SymmetricMatrix<Scalar, OtherDimension, ComputeScalar>& other)
+        const {
+        eigen_assert(dimension == other.dim()
+            && "Operation traceOfProduct cannot be performed for instances "
+            && "of SymmetricMatrix with not matching dimension");
+        return static_cast<Scalar>(
+            symmat_internal::packedTraceOfProduct<ComputeScalar, false>(
+                data(), other.data(), dimension));
+    }
 
-        // Push upper triangular part of mat into the underlying std::vector
-        for (int row = 0; row < dimension; row++) {
-            for (int col = row; col < dimension; col++) {
-                elements.push_back(mat(row, col));
-            }
-        }
+    /**
+     * \brief Frobenius inner product <A, B>_F = sum_ij conj(a_ij) b_ij
+     *
+     * Computed like traceOfProduct() from the packed storages. For real
+     * matrices both are the same.
+     *
+     * \param other Matrix with the same dimension
+     * \return <A, B>_F
+     */
+    template<int OtherDimension>
+    Scalar frobeniusDot(
+        const SymmetricMatrix<Scalar, OtherDimension, ComputeScalar>& other)
+        const {
+        eigen_assert(dimension == other.dim()
+            && "Operation frobeniusDot cannot be performed for instances "
+            && "of SymmetricMatrix with not matching dimension");
+        return static_cast<Scalar>(
+            symmat_internal::packedTraceOfProduct<ComputeScalar, true>(
+                data(), other.data(), dimension));
     }
 
     /**
-     * \brief Constructor that builds a symmetric matrix from a std::vector<T>.
-     * \param vec std::vector<Scalar> that contains the elements of the upper
-     * triangular part of the matrix
+     * \brief View of the top left k x k corner without copying.
+     *
+     * Element (row, col) of the view is element (row, col) of this matrix.
+     * The view is invalidated when this matrix is destroyed. Taking the view
+     * keeps a cached factorization, writes through the view discard it.
+     *
+     * \param k Dimension of the corner
+     * \return Writable view of the corner
      */
-    explicit SymmetricMatrix(const std::vector<Scalar>& vec) : elements(vec) {
-        // Calculation of dimension
-        dimension = (sqrt(1 + 8 * vec.size()) - 1) / 2;
+    SymmetricMatrixView<Scalar, ComputeScalar>
+    topLeftCorner(int k) {
+        eigen_assert(k >= 0 && static_cast<size_t>(k) <= dimension
+            && "Corner is larger than the matrix");
+        return SymmetricMatrixView<Scalar, ComputeScalar>(elements.data(),
+                                                          dimension, k,
+                                                          &cache);
     }
 
     /**
-     * \brief Constructor that builds a symmetric matrix from a std::vector<T>.
-     * \param vec std::vector<Scalar> that contains the elements of the upper
-     * triangular part of the matrix
-     * \param dimension The dimension of the matrix. It doesn't have to be
-     * calculated.
+     * \brief Read-only view of the top left k x k corner without copying
+     * \param k Dimension of the corner
+     * \return Read-only view of the corner
      */
-    SymmetricMatrix(const std::vector<Scalar>& vec, int dimension)
-    : elements(vec), dimension(dimension) {}
+    SymmetricMatrixView<const Scalar, ComputeScalar>
+    topLeftCorner(int k) const {
+        eigen_assert(k >= 0 && static_cast<size_t>(k) <= dimension
+            && "Corner is larger than the matrix");
+        return SymmetricMatrixView<const Scalar, ComputeScalar>(data(),
+                                                                dimension, k);
+    }
 
     /**
-     * \brief Checks if a matrix of type Eigen::Matrix is symmetric or not.
-     * \param mat Matrix of type Eigen::Matrix.
-     * \return True if mat is symmetric, false otherwise
+     * \brief View of the principal submatrix of the rows and columns indices
+     * without copying.
+     *
+     * Element (row, col) of the view is element (indices[row], indices[col])
+     * of this matrix. The view is invalidated when this matrix is destroyed.
+     * Taking the view keeps a cached factorization, writes through the view
+     * discard it.
+     *
+     * \param indices Distinct rows and columns that form the submatrix
+     * \return Writable view of the submatrix
      */
-    static bool
-    isSymmetric(const Eigen::Matrix<Scalar,
-                                    Eigen::Dynamic, Eigen::Dynamic>& mat) {
-        // if mat is not square its not symmetric
-        if (mat.cols() != mat.rows()) {
-            return false;
-        }
-        // if mat is square we check if it is equal to the transposed matrix
-        return (mat == mat.transpose())?true:false;
+    SymmetricMatrixView<Scalar, ComputeScalar>
+    principal(const std::vector<int>& indices) {
+        return SymmetricMatrixView<Scalar, ComputeScalar>(elements.data(),
+                                                          dimension, indices,
+                                                          &cache);
     }
 
     /**
-     * \brief Get a SymmetricMatrix with dynamic dimension that is filled with
-     * random values.
-     * \param dim Dimension of the dynamic matrix
-     * \return SymmetricMatrix filled with random values
+     * \brief Read-only view of the principal submatrix of the rows and
+     * columns indices without copying
+     * \param indices Distinct rows and columns that form the submatrix
+     * \return Read-only view of the submatrix
      */
-    static SymmetricMatrix<Scalar>
-    Random(int dim) {
-        eigen_assert(dim >=0 
-            && "Cannot construct matrix with negative "
-            && "dimension");
-       
-        return SymmetricMatrix<Scalar>(
-            static_cast<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> >(
-                Eigen::Matrix<Scalar,
-                              Eigen::Dynamic,
-                              Eigen::Dynamic>::Random(dim, dim)));
+    SymmetricMatrixView<const Scalar, ComputeScalar>
+    principal(const std::vector<int>& indices) const {
+        return SymmetricMatrixView<const Scalar, ComputeScalar>(data(),
+            dimension, indices);
     }
 
     /**
-     * \brief Dimension of the symmetric matrix.
+     * \brief Schur complement S_aa - S_ab S_bb^-1 S_ba, i.e., the
+     * marginalization of an information matrix onto the rows and columns
+     * keep.
      *
-     * Since any symmetric matrix is a square matrix no difference between
-     * row-number and column-number has to be considered.
-     * /return Dimension of the symmetric matrix.
+     * All rows and columns that are not in keep form the block b that is
+     * eliminated. S_bb is factorized in packed storage and S_aa is updated
+     * with a packed rank update, so the matrix is never expanded. No
+     * exception is thrown.
+     *
+     * \param keep Distinct rows and columns a that are kept, in the order
+     * they appear in the result
+     * \param result Schur complement of dimension keep.size(), unchanged if
+     * S_bb is not positive definite
+     * \return Eigen::NumericalIssue if S_bb is not positive definite,
+     * Eigen::Success otherwise
      */
-    size_t dim() const {
-        return dimension;
+    Eigen::ComputationInfo
+    schurComplement(const std::vector<int>& keep,
+                    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>&
+                    result) const {
+        std::vector<Scalar> packed;
+        Eigen::ComputationInfo info
+            = symmat_internal::schurComplement<ComputeScalar>(data(),
+                                                              dimension, keep,
+                                                              packed);
+        if (info == Eigen::Success) {
+            result = SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>(
+                packed, keep.size());
+        }
+        return info;
     }
 
     /**
@@ -574,6 +2748,7 @@ class SymmetricMatrix<Scalar, Eigen::Dynamic> {
      */
     Scalar&
     operator()(int row, int col) {
+        cache.invalidate();
         if (row <= col) {
             return elements[row * dimension - (row - 1)*((row - 1) + 1)/2
                             + col - row];
@@ -601,8 +2776,8 @@ class SymmetricMatrix<Scalar, Eigen::Dynamic> {
         // Only loop through the upper triangular part
         for (int i = 0; i < dimension; ++i) {
             for (int j = i; j < dimension; ++j) {
-                ret(i, j) = operator()(i, j);
-                ret(j, i) = operator()(i, j);
+                ret(i, j) = ret(j, i)
+                    = elements[symmat_internal::packedIndex(i, j, dimension)];
             }
         }
         return ret;
@@ -618,10 +2793,12 @@ class SymmetricMatrix<Scalar, Eigen::Dynamic> {
      * \param mat The matrix to push into stream
      */
     friend std::ostream&
-    operator<<(std::ostream& stream, SymmetricMatrix<Scalar>& mat) {
+    operator<<(std::ostream& stream,
+               SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>& mat) {
         for (int row = 0; row < mat.dim(); ++row) {
             for (int col = 0; col < mat.dim(); ++col) {
-                stream << mat(row, col) << " ";
+                stream << mat.elements[symmat_internal::packedIndex(
+                    row, col, mat.dimension)] << " ";
             }
             stream << ((row == mat.dim() - 1)?"":"\n");
         }
@@ -633,8 +2810,9 @@ class SymmetricMatrix<Scalar, Eigen::Dynamic> {
      * \param other Matrix to add
      * \return Sum of both matrices
      */
-    SymmetricMatrix<Scalar>
-    operator+(const SymmetricMatrix<Scalar>& other) {
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    operator+(
+        const SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>& other) {
         // Check if both dynamic dimensions match
         eigen_assert(dimension == other.dim() 
             && "Operation + cannot be performed for instances of "
@@ -642,7 +2820,7 @@ class SymmetricMatrix<Scalar, Eigen::Dynamic> {
         
 
         // Construct new matrix and set underlying std::vector
-        SymmetricMatrix<Scalar> ret(elements);
+        SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> ret(elements);
 
         // Just add up both underlying std::vector
         for (int i = 0; i < elements.size(); ++i) {
@@ -656,15 +2834,16 @@ class SymmetricMatrix<Scalar, Eigen::Dynamic> {
      * \param other Matrix to subtract
      * \return Difference of both matrices
      */
-    SymmetricMatrix<Scalar>
-    operator-(const SymmetricMatrix<Scalar>& other) {
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    operator-(
+        const SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>& other) {
         // Check if both dynamic dimensions match
         eigen_assert(dimension == other.dim() 
             && "Operation + cannot be performed for instances of "
             && "SymmetricMatrix with not matching dimension");
 
         // Construct new matrix and set underlying std::vector
-        SymmetricMatrix<Scalar> ret(elements);
+        SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> ret(elements);
 
         // Just add up both underlying std::vector
         for (int i = 0; i < elements.size(); ++i) {
@@ -673,6 +2852,90 @@ class SymmetricMatrix<Scalar, Eigen::Dynamic> {
         return ret;
     }
 
+    /**
+     * \brief Overloaded operator += to add a SymmetricMatrix with dynamic
+     * dimension in place.
+     * \param other Matrix to add
+     * \return Reference to the current instance
+     */
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>&
+    operator+=(
+        const SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>& other) {
+        // Check if both dynamic dimensions match
+        eigen_assert(dimension == other.dim() 
+            && "Operation += cannot be performed for instances of "
+            && "SymmetricMatrix with not matching dimension");
+
+        cache.invalidate();
+        for (int i = 0; i < elements.size(); ++i) {
+           elements[i] += other.elements[i];
+        }
+        return *this;
+    }
+
+    /**
+     * \brief Scaled addition alpha X + beta A in place in one pass over the
+     * packed storage.
+     * \param alpha Factor of x
+     * \param x Matrix with the same dimension
+     * \param beta Factor of the current instance
+     * \return Reference to the current instance
+     */
+    template<int OtherDimension>
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>&
+    axpby(const ComputeScalar& alpha,
+          const SymmetricMatrix<Scalar, OtherDimension, ComputeScalar>& x,
+          const ComputeScalar& beta) {
+        eigen_assert(dimension == x.dim()
+            && "Operation axpby cannot be performed for instances of "
+            && "SymmetricMatrix with not matching dimension");
+        symmat_internal::packedAxpby(alpha, x.data(), beta, data(),
+                                     elements.size());
+        return *this;
+    }
+
+    /**
+     * \brief Add lambda to the diagonal, e.g., for damping A + lambda I.
+     * Only the dim() diagonal elements are touched.
+     * \param lambda Value to add
+     * \return Reference to the current instance
+     */
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>&
+    addDiagonal(const ComputeScalar& lambda) {
+        symmat_internal::packedAddDiagonal(data(), dimension, lambda);
+        return *this;
+    }
+
+    /**
+     * \brief Linear combination sum_k coefficients[k] matrices[k] in one
+     * pass over the packed storage.
+     * \param coefficients Factors of the matrices
+     * \param matrices Matrices of the same dimension, as many as
+     * coefficients
+     * \return Linear combination, the zero matrix if there are no matrices,
+     * which has dimension 0 here
+     */
+    static SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+    linearCombination(const std::vector<ComputeScalar>& coefficients,
+                      const std::vector<const SymmetricMatrix<
+                          Scalar, Eigen::Dynamic, ComputeScalar>*>& matrices) {
+        eigen_assert(coefficients.size() == matrices.size()
+            && "Number of coefficients and matrices do not match");
+        const size_t n = matrices.empty() ? 0 : matrices[0]->dim();
+        std::vector<const Scalar*> sources(matrices.size());
+        for (size_t k = 0; k < matrices.size(); ++k) {
+            eigen_assert(matrices[k]->dim() == n
+                && "Linear combination cannot be computed for instances of "
+                && "SymmetricMatrix with not matching dimension");
+            sources[k] = matrices[k]->data();
+        }
+        SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> ret(
+            std::vector<Scalar>((n * n + n) / 2), n);
+        symmat_internal::packedLinearCombination(coefficients.data(),
+            sources.data(), sources.size(), (n * n + n) / 2, ret.data());
+        return ret;
+    }
+
     /**
      * \brief Overloaded operator + to add an Eigen::Matrix with dynamic
      * dimension
@@ -693,7 +2956,8 @@ class SymmetricMatrix<Scalar, Eigen::Dynamic> {
 
         for (int i = 0; i < dimension; ++i) {
             for (int j = i; j < dimension; ++j) {
-                Scalar tmp = operator()(i, j);
+                Scalar tmp
+                    = elements[symmat_internal::packedIndex(i, j, dimension)];
                 ret(i, j) = tmp + other(i, j);
                 ret(j, i) = tmp + other(j, i);
             }
@@ -720,7 +2984,8 @@ class SymmetricMatrix<Scalar, Eigen::Dynamic> {
 
         for (int i = 0; i < dimension; ++i) {
             for (int j = i; j < dimension; ++j) {
-                Scalar tmp = operator()(i, j);
+                Scalar tmp
+                    = elements[symmat_internal::packedIndex(i, j, dimension)];
                 ret(i, j) = tmp - other(i, j);
                 ret(j, i) = tmp - other(j, i);
             }
@@ -735,10 +3000,11 @@ class SymmetricMatrix<Scalar, Eigen::Dynamic> {
      * \return Product of both matrices
      */
     Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>
-    operator*(SymmetricMatrix<Scalar>& other) {
-        return Eigen::Matrix<Scalar, Eigen::Dynamic,
-                             Eigen::Dynamic>(constructEigenMatrix()
-                                             * other.constructEigenMatrix());
+    operator*(SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>& other) {
+        return Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>(
+            (constructEigenMatrix().template cast<ComputeScalar>()
+             * other.constructEigenMatrix().template cast<ComputeScalar>())
+            .template cast<Scalar>());
     }
 
     /**
@@ -756,10 +3022,361 @@ class SymmetricMatrix<Scalar, Eigen::Dynamic> {
  private:
     // This is necessary since the generic class template needs to access
     // private members of this partial specialized class template
-    template<typename _Scalar, int _Dimension>
+    template<typename _Scalar, int _Dimension, typename _ComputeScalar>
     friend class SymmetricMatrix;
+
+    /**
+     * \brief Packed Cholesky factor in ComputeScalar, taken from the cache if
+     * caching is enabled and the factor is valid
+     * \param work Storage of the factor if caching is disabled
+     * \param positiveDefinite Set to false if the factorization failed, the
+     * factor is incomplete then
+     * \return Pointer to the packed factor
+     */
+    const ComputeScalar*
+    factorize(std::vector<ComputeScalar>& work, bool& positiveDefinite) const {
+        if (cache.valid) {
+            positiveDefinite = cache.positiveDefinite;
+            return cache.factor.data();
+        }
+        std::vector<ComputeScalar>& u = cache.enabled ? cache.factor : work;
+        u.assign(elements.begin(), elements.end());
+        positiveDefinite
+            = symmat_internal::packedCholesky(u.data(), dimension) < 0;
+        if (cache.enabled) {
+            cache.valid = true;
+            cache.positiveDefinite = positiveDefinite;
+        }
+        return u.data();
+    }
+
     std::vector<Scalar> elements;
     size_t dimension;
+    mutable symmat_internal::FactorizationCache<ComputeScalar> cache;
+};
+
+namespace Eigen {
+namespace internal {
+
+/**
+ * \brief Evaluator that reads the coefficients of a SymmetricMatrix from its
+ * packed storage
+ *
+ * Eigen loads packets along the columns. The part of column col on or below
+ * the diagonal is the contiguous packed row col, so these packets are plain
+ * unaligned loads. Packets that reach above the diagonal are gathered.
+ */
+template<typename _Scalar, int _Dimension, typename _ComputeScalar>
+struct evaluator<SymmetricMatrix<_Scalar, _Dimension, _ComputeScalar> >
+    : evaluator_base<SymmetricMatrix<_Scalar, _Dimension, _ComputeScalar> > {
+    typedef SymmetricMatrix<_Scalar, _Dimension, _ComputeScalar> XprType;
+    typedef _Scalar Scalar;
+    typedef Scalar CoeffReturnType;
+
+    enum {
+        CoeffReadCost = NumTraits<Scalar>::ReadCost
+                        + 2 * NumTraits<Index>::AddCost
+                        + NumTraits<Index>::MulCost,
+        Flags = packet_traits<Scalar>::Vectorizable ? PacketAccessBit : 0,
+        Alignment = 0
+    };
+
+    explicit evaluator(const XprType& mat)
+    : m_data(mat.data()), m_dim(mat.dim()) {}
+
+    EIGEN_STRONG_INLINE CoeffReturnType
+    coeff(Index row, Index col) const {
+        return m_data[symmat_internal::packedIndex(row, col, m_dim)];
+    }
+
+    template<int LoadMode, typename PacketType>
+    EIGEN_STRONG_INLINE PacketType
+    packet(Index row, Index col) const {
+        if (row >= col) {
+            return ploadu<PacketType>(
+                m_data + symmat_internal::packedIndex(col, row, m_dim));
+        }
+        enum { Size = unpacket_traits<PacketType>::size };
+        Scalar buffer[Size];
+        if (row + Size <= col + 1) {
+            // (r, col) and (r + 1, col) are dim - r - 1 apart above the
+            // diagonal
+            size_t index = symmat_internal::packedIndex(row, col, m_dim);
+            for (int k = 0; k < Size; ++k) {
+                buffer[k] = m_data[index];
+                index += m_dim - row - k - 1;
+            }
+        } else {
+            for (int k = 0; k < Size; ++k) {
+                buffer[k] = coeff(row + k, col);
+            }
+        }
+        return ploadu<PacketType>(buffer);
+    }
+
+    const Scalar* m_data;
+    size_t m_dim;
+};
+
+/**
+ * \brief Product of a SymmetricMatrix with a vector
+ *
+ * Computed by symmat_internal::packedSymvRows directly on the packed storage
+ * in ComputeScalar instead of Eigen's coefficient-wise fallback.
+ */
+template<typename _Scalar, int _Dimension, typename _ComputeScalar,
+         typename Rhs>
+struct generic_product_impl<SymmetricMatrix<_Scalar, _Dimension,
+                                            _ComputeScalar>,
+                            Rhs, DenseShape, DenseShape, GemvProduct>
+    : generic_product_impl_base<
+          SymmetricMatrix<_Scalar, _Dimension, _ComputeScalar>, Rhs,
+          generic_product_impl<SymmetricMatrix<_Scalar, _Dimension,
+                                               _ComputeScalar>,
+                               Rhs, DenseShape, DenseShape, GemvProduct> > {
+    typedef SymmetricMatrix<_Scalar, _Dimension, _ComputeScalar> Lhs;
+    typedef typename Product<Lhs, Rhs>::Scalar Scalar;
+    typedef Matrix<_ComputeScalar, Dynamic, 1> Vector;
+
+    template<typename Dest>
+    static void
+    scaleAndAddTo(Dest& dst, const Lhs& lhs, const Rhs& rhs,
+                  const Scalar& alpha) {
+        const size_t n = lhs.dim();
+        const Vector x = rhs.template cast<_ComputeScalar>();
+        Vector z = Vector::Zero(n);
+        symmat_internal::packedSymvRows(lhs.data(), n, x.data(), z.data(),
+                                        0, n);
+        dst += (static_cast<_ComputeScalar>(alpha) * z)
+            .template cast<Scalar>();
+    }
+};
+
+/**
+ * \brief Product of a row vector with a SymmetricMatrix, i.e., the transpose
+ * of the product of the SymmetricMatrix with the vector.
+ */
+template<typename Lhs, typename _Scalar, int _Dimension,
+         typename _ComputeScalar>
+struct generic_product_impl<Lhs,
+                            SymmetricMatrix<_Scalar, _Dimension,
+                                            _ComputeScalar>,
+                            DenseShape, DenseShape, GemvProduct>
+    : generic_product_impl_base<
+          Lhs, SymmetricMatrix<_Scalar, _Dimension, _ComputeScalar>,
+          generic_product_impl<Lhs, SymmetricMatrix<_Scalar, _Dimension,
+                                                    _ComputeScalar>,
+                               DenseShape, DenseShape, GemvProduct> > {
+    typedef SymmetricMatrix<_Scalar, _Dimension, _ComputeScalar> Rhs;
+    typedef typename Product<Lhs, Rhs>::Scalar Scalar;
+    typedef Matrix<_ComputeScalar, Dynamic, 1> Vector;
+
+    template<typename Dest>
+    static void
+    scaleAndAddTo(Dest& dst, const Lhs& lhs, const Rhs& rhs,
+                  const Scalar& alpha) {
+        const size_t n = rhs.dim();
+        const Vector x = lhs.transpose().template cast<_ComputeScalar>();
+        Vector z = Vector::Zero(n);
+        symmat_internal::packedSymvRows(rhs.data(), n, x.data(), z.data(),
+                                        0, n);
+        dst += (static_cast<_ComputeScalar>(alpha) * z)
+            .transpose().template cast<Scalar>();
+    }
+};
+
+}  // namespace internal
+}  // namespace Eigen
+
+/**
+ * \class SymmetricMatrixView<typename Scalar, typename ComputeScalar>
+ * \brief Principal submatrix of a SymmetricMatrix that refers to the packed
+ * storage of its parent instead of copying it
+ *
+ * A view is either the top left corner of its parent or the principal
+ * submatrix of an arbitrary set of rows and columns. Views are obtained by
+ * SymmetricMatrix::topLeftCorner() and SymmetricMatrix::principal(). If
+ * Scalar is const the view is read-only.
+ *
+ * Like Eigen::Block, copying a view copies the reference while assigning to a
+ * view writes the elements of the parent. To pass a view to other operations
+ * either construct a SymmetricMatrix from it, which gathers the packed
+ * elements with a single pass, or call eval().
+ */
+template<typename Scalar, typename ComputeScalar>
+class SymmetricMatrixView {
+ public:
+    typedef typename Eigen::internal::remove_const<Scalar>::type PlainScalar;
+
+    /**
+     * \brief View of the top left k x k corner of a packed matrix
+     * \param data Packed storage of the parent matrix
+     * \param n Dimension of the parent matrix
+     * \param k Dimension of the corner
+     * \param cache Cached factorization of the parent that writes through
+     * the view invalidate, if any
+     */
+    SymmetricMatrixView(Scalar* data, size_t n, size_t k,
+                        symmat_internal::FactorizationCache<ComputeScalar>*
+                        cache = 0)
+    : parent(data), parentDimension(n), dimension(k), parentCache(cache) {}
+
+    /**
+     * \brief View of the principal submatrix indices of a packed matrix
+     * \param data Packed storage of the parent matrix
+     * \param n Dimension of the parent matrix
+     * \param indices Distinct rows and columns that form the submatrix
+     * \param cache Cached factorization of the parent that writes through
+     * the view invalidate, if any
+     */
+    SymmetricMatrixView(Scalar* data, size_t n,
+                        const std::vector<int>& indices,
+                        symmat_internal::FactorizationCache<ComputeScalar>*
+                        cache = 0)
+    : parent(data), parentDimension(n), dimension(indices.size()),
+      indices(indices), parentCache(cache) {
+        for (size_t a = 0; a < indices.size(); ++a) {
+            eigen_assert(indices[a] >= 0
+                && static_cast<size_t>(indices[a]) < n
+                && "Index of principal submatrix out of range");
+        }
+    }
+
+    /**
+     * \brief Dimension of the submatrix
+     */
+    size_t dim() const {
+        return dimension;
+    }
+
+    /**
+     * \brief Access an element of the submatrix in the parent matrix
+     * \param row The row index of the element
+     * \param col The column index of the element
+     * \return Reference to the element (row, col) of the submatrix
+     */
+    Scalar&
+    operator()(int row, int col) {
+        invalidateParent();
+        return parent[index(row, col)];
+    }
+
+    /**
+     * \brief Copy the submatrix into packed storage
+     * \param dst Packed storage of dimension dim()
+     */
+    template<typename Dst>
+    void gather(Dst* dst) const {
+        symmat_internal::packedGather(parent, parentDimension, indexData(),
+                                      dimension, dst);
+    }
+
+    /**
+     * \brief Copy the submatrix into a SymmetricMatrix
+     * \return SymmetricMatrix with dynamic dimension
+     */
+    SymmetricMatrix<PlainScalar, Eigen::Dynamic, ComputeScalar>
+    eval() const {
+        return SymmetricMatrix<PlainScalar, Eigen::Dynamic, ComputeScalar>(
+            *this);
+    }
+
+    /**
+     * \brief Construct an Eigen::Matrix of the submatrix
+     * \return Instance of Eigen::Matrix with dynamic dimension
+     */
+    Eigen::Matrix<PlainScalar, Eigen::Dynamic, Eigen::Dynamic>
+    constructEigenMatrix() const {
+        return eval().constructEigenMatrix();
+    }
+
+    /**
+     * \brief Overwrite the submatrix in the parent matrix
+     * \param other Matrix with dimension dim()
+     * \return Reference to this view
+     */
+    template<int OtherDimension>
+    SymmetricMatrixView<Scalar, ComputeScalar>&
+    operator=(const SymmetricMatrix<PlainScalar, OtherDimension,
+                                    ComputeScalar>& other) {
+        scatter(other, Eigen::internal::assign_op<PlainScalar,
+                                                  PlainScalar>());
+        return *this;
+    }
+
+    /**
+     * \brief Overwrite the submatrix in the parent matrix with the elements
+     * of another view, which may refer to the same parent
+     * \param other View with dimension dim()
+     * \return Reference to this view
+     */
+    SymmetricMatrixView<Scalar, ComputeScalar>&
+    operator=(const SymmetricMatrixView<Scalar, ComputeScalar>& other) {
+        return *this = other.eval();
+    }
+
+    /**
+     * \brief Add a matrix to the submatrix in the parent matrix
+     * \param other Matrix with dimension dim()
+     * \return Reference to this view
+     */
+    template<int OtherDimension>
+    SymmetricMatrixView<Scalar, ComputeScalar>&
+    operator+=(const SymmetricMatrix<PlainScalar, OtherDimension,
+                                     ComputeScalar>& other) {
+        scatter(other, Eigen::internal::add_assign_op<PlainScalar,
+                                                      PlainScalar>());
+        return *this;
+    }
+
+    /**
+     * \brief Subtract a matrix from the submatrix in the parent matrix
+     * \param other Matrix with dimension dim()
+     * \return Reference to this view
+     */
+    template<int OtherDimension>
+    SymmetricMatrixView<Scalar, ComputeScalar>&
+    operator-=(const SymmetricMatrix<PlainScalar, OtherDimension,
+                                     ComputeScalar>& other) {
+        scatter(other, Eigen::internal::sub_assign_op<PlainScalar,
+                                                      PlainScalar>());
+        return *this;
+    }
+
+ private:
+    const int* indexData() const {
+        return indices.empty() ? 0 : indices.data();
+    }
+
+    size_t index(int row, int col) const {
+        if (indices.empty()) {
+            return symmat_internal::packedIndex(row, col, parentDimension);
+        }
+        return symmat_internal::packedIndex(indices[row], indices[col],
+                                            parentDimension);
+    }
+
+    template<int OtherDimension, typename Op>
+    void scatter(const SymmetricMatrix<PlainScalar, OtherDimension,
+                                       ComputeScalar>& other, const Op& op) {
+        eigen_assert(other.dim() == dimension
+            && "Dimension of the matrix does not match the view");
+        invalidateParent();
+        symmat_internal::packedScatter(other.data(), dimension, parent,
+                                       parentDimension, indexData(), op);
+    }
+
+    void invalidateParent() {
+        if (parentCache) {
+            parentCache->invalidate();
+        }
+    }
+
+    Scalar* parent;
+    size_t parentDimension;
+    size_t dimension;
+    std::vector<int> indices;
+    symmat_internal::FactorizationCache<ComputeScalar>* parentCache;
 };
 
 /**
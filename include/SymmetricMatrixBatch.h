@@ -0,0 +1,1060 @@
+#ifndef GSOC_SYMMAT_BATCH_H
+#define GSOC_SYMMAT_BATCH_H
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include "SymmetricMatrix.h"
+
+namespace symmat_internal {
+
+/**
+ * \brief Operations on the lane type T that batched kernels are written for.
+ *
+ * Batched kernels are written once for a generic lane type T. If T is Scalar
+ * the kernel processes a single matrix. If T is Eigen::Array<Scalar, Width, 1>
+ * every coefficient of the array belongs to a different matrix and Eigen maps
+ * all arithmetic to its packet operations (SSE, AVX2, AVX-512, ...), so each
+ * SIMD lane processes one matrix. Loads and stores convert from and to the
+ * storage type, so kernels can compute in a wider type than they store.
+ */
+template<typename T>
+struct LaneTraits {
+    typedef T Scalar;
+    typedef bool Mask;
+    enum { Width = 1 };
+
+    static T constant(const Scalar& value) { return value; }
+    static Mask mask(bool value) { return value; }
+    template<typename Src>
+    static T load(const Src* ptr) { return static_cast<T>(*ptr); }
+    template<typename Dst>
+    static void store(Dst* ptr, const T& value) {
+        *ptr = static_cast<Dst>(value);
+    }
+    static T sqrt(const T& value) { return std::sqrt(value); }
+    static T abs(const T& value) { return std::abs(value); }
+    static T log(const T& value) { return std::log(value); }
+    static T atan(const T& value) { return std::atan(value); }
+    static T cos(const T& value) { return std::cos(value); }
+    static T sin(const T& value) { return std::sin(value); }
+    static T min(const T& lhs, const T& rhs) { return std::min(lhs, rhs); }
+    static T max(const T& lhs, const T& rhs) { return std::max(lhs, rhs); }
+    static T select(const Mask& mask, const T& lhs, const T& rhs) {
+        return mask ? lhs : rhs;
+    }
+    static bool lane(const Mask& mask, int) { return mask; }
+    static bool all(const Mask& mask) { return mask; }
+};
+
+template<typename _Scalar, int _Width>
+struct LaneTraits<Eigen::Array<_Scalar, _Width, 1> > {
+    typedef _Scalar Scalar;
+    typedef Eigen::Array<_Scalar, _Width, 1> T;
+    typedef Eigen::Array<bool, _Width, 1> Mask;
+    enum { Width = _Width };
+
+    static T constant(const Scalar& value) { return T::Constant(value); }
+    static Mask mask(bool value) { return Mask::Constant(value); }
+    // cast() has no packet access, so lanes of the same type are mapped
+    // directly to keep loads and stores vectorized
+    static T load(const Scalar* ptr) {
+        return Eigen::Map<const T>(ptr);
+    }
+    template<typename Src>
+    static T load(const Src* ptr) {
+        return Eigen::Map<const Eigen::Array<Src, _Width, 1> >(ptr)
+            .template cast<Scalar>();
+    }
+    static void store(Scalar* ptr, const T& value) {
+        Eigen::Map<T> dst(ptr);
+        dst = value;
+    }
+    template<typename Dst>
+    static void store(Dst* ptr, const T& value) {
+        Eigen::Map<Eigen::Array<Dst, _Width, 1> > dst(ptr);
+        dst = value.template cast<Dst>();
+    }
+    static T sqrt(const T& value) { return value.sqrt(); }
+    static T abs(const T& value) { return value.abs(); }
+    static T log(const T& value) { return value.log(); }
+    static T atan(const T& value) { return value.atan(); }
+    static T cos(const T& value) { return value.cos(); }
+    static T sin(const T& value) { return value.sin(); }
+    static T min(const T& lhs, const T& rhs) { return lhs.min(rhs); }
+    static T max(const T& lhs, const T& rhs) { return lhs.max(rhs); }
+    static T select(const Mask& mask, const T& lhs, const T& rhs) {
+        return mask.select(lhs, rhs);
+    }
+    static bool lane(const Mask& mask, int i) { return mask(i); }
+    static bool all(const Mask& mask) { return mask.all(); }
+};
+
+/**
+ * \brief Number of matrices processed at once by batched kernels.
+ *
+ * This is the packet size Eigen uses for Scalar with the current compiler
+ * flags, e.g., 4 doubles for AVX2 and 8 doubles for AVX-512.
+ */
+template<typename Scalar>
+struct BatchWidth {
+    enum { value = Eigen::internal::packet_traits<Scalar>::size };
+};
+
+/**
+ * \brief Packed index that is evaluated at compile-time for constant
+ * arguments
+ */
+template<int Dim>
+inline int
+fixedIndex(int row, int col) {
+    return (row <= col) ? row * Dim - row * (row - 1) / 2 + col - row
+                        : col * Dim - col * (col - 1) / 2 + row - col;
+}
+
+/**
+ * \brief Cholesky factorization A = U^T U of packed storage with fixed
+ * dimension for any lane type.
+ *
+ * Contrary to packedCholesky() the factorization does not stop at a
+ * non-positive pivot, since other lanes may still succeed.
+ *
+ * \param a Packed storage of A, overwritten by U
+ * \return Smallest pivot, i.e., A is positive definite if it is positive
+ */
+template<int Dim, typename T>
+inline T
+fixedCholesky(T* a) {
+    typedef LaneTraits<T> Lane;
+    T minPivot = a[0];
+    for (int i = 0; i < Dim; ++i) {
+        const int ii = fixedIndex<Dim>(i, i);
+        minPivot = Lane::min(minPivot, a[ii]);
+        const T pivot = Lane::sqrt(a[ii]);
+        const T invPivot = Lane::constant(1) / pivot;
+        a[ii] = pivot;
+        for (int j = i + 1; j < Dim; ++j) {
+            a[ii + j - i] = a[ii + j - i] * invPivot;
+        }
+        for (int j = i + 1; j < Dim; ++j) {
+            for (int k = j; k < Dim; ++k) {
+                a[fixedIndex<Dim>(j, k)] = a[fixedIndex<Dim>(j, k)]
+                    - a[ii + j - i] * a[ii + k - i];
+            }
+        }
+    }
+    return minPivot;
+}
+
+/**
+ * \brief Logarithm of the determinant 2 sum_i log U_ii of A = U^T U from the
+ * packed factor U with fixed dimension
+ */
+template<int Dim, typename T>
+inline T
+fixedLogDeterminant(const T* u) {
+    typedef LaneTraits<T> Lane;
+    T ret = Lane::log(u[0]);
+    for (int i = 1; i < Dim; ++i) {
+        ret = ret + Lane::log(u[fixedIndex<Dim>(i, i)]);
+    }
+    return Lane::constant(2) * ret;
+}
+
+/**
+ * \brief Solve U^T y = b in place for a packed factor U with fixed dimension
+ */
+template<int Dim, typename T>
+inline void
+fixedForwardSolve(const T* u, T* b) {
+    for (int i = 0; i < Dim; ++i) {
+        T sum = b[i];
+        for (int k = 0; k < i; ++k) {
+            sum = sum - u[fixedIndex<Dim>(k, i)] * b[k];
+        }
+        b[i] = sum / u[fixedIndex<Dim>(i, i)];
+    }
+}
+
+/**
+ * \brief Solve U x = y in place for a packed factor U with fixed dimension
+ */
+template<int Dim, typename T>
+inline void
+fixedBackSolve(const T* u, T* y) {
+    for (int i = Dim - 1; i >= 0; --i) {
+        T sum = y[i];
+        for (int j = i + 1; j < Dim; ++j) {
+            sum = sum - u[fixedIndex<Dim>(i, j)] * y[j];
+        }
+        y[i] = sum / u[fixedIndex<Dim>(i, i)];
+    }
+}
+
+/**
+ * \brief Solve U^T U X = B in place for a packed factor U with fixed
+ * dimension and Cols right-hand sides.
+ *
+ * Contrary to calling fixedForwardSolve() and fixedBackSolve() per column,
+ * every pivot is inverted only once, which matters for lane types whose
+ * division is several times slower than a multiplication.
+ *
+ * \param u Packed factor U
+ * \param b Dim x Cols matrix B, overwritten by X
+ */
+template<int Dim, int Cols, typename T>
+inline void
+fixedSolveColumns(const T* u, T (*b)[Cols]) {
+    typedef LaneTraits<T> Lane;
+    T invPivot[Dim];
+    for (int i = 0; i < Dim; ++i) {
+        invPivot[i] = Lane::constant(1) / u[fixedIndex<Dim>(i, i)];
+    }
+    for (int i = 0; i < Dim; ++i) {
+        for (int j = 0; j < Cols; ++j) {
+            T sum = b[i][j];
+            for (int k = 0; k < i; ++k) {
+                sum = sum - u[fixedIndex<Dim>(k, i)] * b[k][j];
+            }
+            b[i][j] = sum * invPivot[i];
+        }
+    }
+    for (int i = Dim - 1; i >= 0; --i) {
+        for (int j = 0; j < Cols; ++j) {
+            T sum = b[i][j];
+            for (int k = i + 1; k < Dim; ++k) {
+                sum = sum - u[fixedIndex<Dim>(i, k)] * b[k][j];
+            }
+            b[i][j] = sum * invPivot[i];
+        }
+    }
+}
+
+/**
+ * \brief Similarity transform out = J A J^T of a packed matrix A with fixed
+ * dimension for any lane type.
+ *
+ * Only the upper triangular part of the result is computed.
+ *
+ * \param j Dense Dim x Dim matrix, stored row by row
+ * \param a Packed storage of A
+ * \param out Packed storage of the result
+ */
+template<int Dim, typename T>
+inline void
+fixedSimilarity(const T* j, const T* a, T* out) {
+    T ja[Dim][Dim];
+    for (int r = 0; r < Dim; ++r) {
+        for (int c = 0; c < Dim; ++c) {
+            T sum = j[r * Dim] * a[fixedIndex<Dim>(0, c)];
+            for (int k = 1; k < Dim; ++k) {
+                sum = sum + j[r * Dim + k] * a[fixedIndex<Dim>(k, c)];
+            }
+            ja[r][c] = sum;
+        }
+    }
+    for (int r = 0; r < Dim; ++r) {
+        for (int c = r; c < Dim; ++c) {
+            T sum = ja[r][0] * j[c * Dim];
+            for (int k = 1; k < Dim; ++k) {
+                sum = sum + ja[r][k] * j[c * Dim + k];
+            }
+            out[fixedIndex<Dim>(r, c)] = sum;
+        }
+    }
+}
+
+/**
+ * \brief Squared norm of U^-T r for a packed factor U and any lane type
+ * \param u Packed factor U
+ * \param r Vector r, overwritten by U^-T r
+ */
+template<int Dim, typename T>
+inline T
+fixedMahalanobis(const T* u, T* r) {
+    fixedForwardSolve<Dim>(u, r);
+    T sum = r[0] * r[0];
+    for (int i = 1; i < Dim; ++i) {
+        sum += r[i] * r[i];
+    }
+    return sum;
+}
+
+/**
+ * \brief 1-norm of a packed matrix with fixed dimension for any lane type
+ */
+template<int Dim, typename T>
+inline T
+fixedNorm1(const T* a) {
+    typedef LaneTraits<T> Lane;
+    T norm = Lane::constant(0);
+    for (int j = 0; j < Dim; ++j) {
+        T sum = Lane::abs(a[fixedIndex<Dim>(0, j)]);
+        for (int i = 1; i < Dim; ++i) {
+            sum += Lane::abs(a[fixedIndex<Dim>(i, j)]);
+        }
+        norm = Lane::max(norm, sum);
+    }
+    return norm;
+}
+
+/**
+ * \brief Estimate the 1-norm of A^-1 from the packed Cholesky factor U of A
+ * with fixed dimension for any lane type.
+ *
+ * Same estimator as packedInverseNorm1Estimate(). Since lanes may converge at
+ * different iterations, all five iterations are run and converged lanes are
+ * masked instead of leaving the loop.
+ */
+template<int Dim, typename T>
+inline T
+fixedInverseNorm1Estimate(const T* u) {
+    typedef LaneTraits<T> Lane;
+    typedef typename Lane::Mask Mask;
+    T x[Dim], y[Dim];
+    for (int i = 0; i < Dim; ++i) {
+        x[i] = Lane::constant(1) / Lane::constant(Dim);
+    }
+    T est = Lane::constant(0);
+    Mask done = Lane::mask(false);
+    for (int iter = 0; iter < 5; ++iter) {
+        for (int i = 0; i < Dim; ++i) {
+            y[i] = x[i];
+        }
+        fixedForwardSolve<Dim>(u, y);
+        fixedBackSolve<Dim>(u, y);
+        T norm = Lane::abs(y[0]);
+        for (int i = 1; i < Dim; ++i) {
+            norm += Lane::abs(y[i]);
+        }
+        if (iter > 0) {
+            done = done || (norm <= est);
+        }
+        est = Lane::select(done, est, norm);
+
+        for (int i = 0; i < Dim; ++i) {
+            y[i] = Lane::select(y[i] >= Lane::constant(0), Lane::constant(1),
+                                Lane::constant(-1));
+        }
+        fixedForwardSolve<Dim>(u, y);
+        fixedBackSolve<Dim>(u, y);
+        T zmax = Lane::abs(y[0]);
+        T j = Lane::constant(0);
+        T ztx = y[0] * x[0];
+        for (int i = 1; i < Dim; ++i) {
+            Mask larger = (Lane::abs(y[i]) > zmax);
+            zmax = Lane::select(larger, Lane::abs(y[i]), zmax);
+            j = Lane::select(larger, Lane::constant(i), j);
+            ztx += y[i] * x[i];
+        }
+        if (iter > 0) {
+            done = done || (zmax <= ztx);
+        }
+        for (int i = 0; i < Dim; ++i) {
+            x[i] = Lane::select(done, x[i],
+                Lane::select(j == Lane::constant(i), Lane::constant(1),
+                             Lane::constant(0)));
+        }
+    }
+
+    for (int i = 0; i < Dim; ++i) {
+        const double value = 1.0 + ((Dim > 1) ? double(i) / (Dim - 1) : 0.0);
+        x[i] = Lane::constant((i % 2 == 0) ? value : -value);
+    }
+    fixedForwardSolve<Dim>(u, x);
+    fixedBackSolve<Dim>(u, x);
+    T alt = Lane::abs(x[0]);
+    for (int i = 1; i < Dim; ++i) {
+        alt += Lane::abs(x[i]);
+    }
+    alt = Lane::constant(2) * alt / Lane::constant(3 * Dim);
+    return Lane::max(est, alt);
+}
+
+/**
+ * \brief Scale the matrices in the columns [t, t + s.cols()) of a batch from
+ * both sides, i.e., dst_ij = s_i * src_ij * s_j for every matrix.
+ *
+ * Element k = (i, j) of all matrices is contiguous, so it is rescaled by one
+ * vectorized multiply with the rows i and j of s. src and dst may be the same.
+ */
+template<int Dim, typename ComputeScalar, typename Src, typename Dst>
+inline void
+batchScale(const Src& src, const Eigen::Array<ComputeScalar, Dim,
+           Eigen::Dynamic, Eigen::RowMajor>& s, Dst& dst, Eigen::Index t) {
+    typedef typename Dst::Scalar Scalar;
+    const Eigen::Index len = s.cols();
+    for (int i = 0; i < Dim; ++i) {
+        for (int j = i; j < Dim; ++j) {
+            const int k = fixedIndex<Dim>(i, j);
+            dst.row(k).segment(t, len) = (src.row(k).segment(t, len)
+                .template cast<ComputeScalar>() * s.row(i) * s.row(j))
+                .template cast<Scalar>();
+        }
+    }
+}
+
+/**
+ * \brief Number of matrices batchCorrelation(), batchCovariance() and
+ * batchTraceOfProduct() process at once, so the scaling factors and partial
+ * sums stay in the L1 cache
+ */
+enum { ScaleBlockSize = 256 };
+
+/**
+ * \brief Convert a batch of covariance matrices to correlation matrices.
+ *
+ * For every block of matrices the diagonals are extracted once and their
+ * reciprocal square roots computed in one vectorized pass. src and dst may be
+ * the same.
+ */
+template<int Dim, typename ComputeScalar, typename Src, typename Dst>
+inline void
+batchCorrelation(const Src& src, Dst& dst) {
+    typedef typename Dst::Scalar Scalar;
+    Eigen::Array<ComputeScalar, Dim, Eigen::Dynamic, Eigen::RowMajor> s;
+    for (Eigen::Index t = 0; t < src.cols(); t += ScaleBlockSize) {
+        const Eigen::Index len = std::min<Eigen::Index>(ScaleBlockSize,
+                                                        src.cols() - t);
+        s.resize(Dim, len);
+        for (int i = 0; i < Dim; ++i) {
+            s.row(i) = src.row(fixedIndex<Dim>(i, i)).segment(t, len)
+                .template cast<ComputeScalar>().rsqrt();
+        }
+        batchScale(src, s, dst, t);
+        for (int i = 0; i < Dim; ++i) {
+            dst.row(fixedIndex<Dim>(i, i)).segment(t, len).setConstant(
+                Scalar(1));
+        }
+    }
+}
+
+/**
+ * \brief Convert a batch of correlation matrices to covariance matrices with
+ * the standard deviations stddev. src and dst may be the same.
+ */
+template<int Dim, typename ComputeScalar, typename Src, typename Dst,
+         typename StdDev>
+inline void
+batchCovariance(const Src& src, const StdDev& stddev, Dst& dst) {
+    Eigen::Array<ComputeScalar, Dim, Eigen::Dynamic, Eigen::RowMajor> s;
+    for (Eigen::Index t = 0; t < src.cols(); t += ScaleBlockSize) {
+        const Eigen::Index len = std::min<Eigen::Index>(ScaleBlockSize,
+                                                        src.cols() - t);
+        s = stddev.middleCols(t, len).template cast<ComputeScalar>();
+        batchScale(src, s, dst, t);
+    }
+}
+
+}  // namespace symmat_internal
+
+/**
+ * \class SymmetricMatrixBatch<typename Scalar, int Dimension,
+ * typename ComputeScalar>
+ * \brief Batch of symmetric matrices with fixed dimension stored as
+ * structure of arrays
+ *
+ * The batch stores the packed element k of all matrices contiguously, i.e.,
+ * row k of packed() contains the element k of every matrix. Batched kernels
+ * therefore load the same element of several consecutive matrices with a
+ * single SIMD load and process one matrix per SIMD lane.
+ *
+ * As for SymmetricMatrix, ComputeScalar is the type batched kernels compute
+ * in. A SymmetricMatrixBatch<float, 5, double> is half the size of a batch of
+ * doubles, which matters since batched kernels are bound by memory bandwidth.
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar = Scalar>
+class SymmetricMatrixBatch {
+ public:
+    enum { PackedSize = (Dimension * Dimension + Dimension) / 2 };
+    typedef Eigen::Array<Scalar, PackedSize, Eigen::Dynamic, Eigen::RowMajor>
+        Storage;
+    /** One vector per matrix, row k contains the element k of every vector */
+    typedef Eigen::Array<Scalar, Dimension, Eigen::Dynamic, Eigen::RowMajor>
+        VectorBatch;
+
+    /**
+     * \brief Construct an empty batch
+     */
+    SymmetricMatrixBatch() {}
+
+    /**
+     * \brief Construct a batch of count matrices with uninitialized elements
+     * \param count Number of matrices
+     */
+    explicit SymmetricMatrixBatch(size_t count)
+    : elements(static_cast<Eigen::Index>(PackedSize), count) {}
+
+    /**
+     * \brief Construct a batch from a vector of symmetric matrices
+     * \param mats Matrices to store in the batch
+     */
+    explicit SymmetricMatrixBatch(
+        const std::vector<SymmetricMatrix<Scalar, Dimension, ComputeScalar> >&
+        mats)
+    : elements(static_cast<Eigen::Index>(PackedSize), mats.size()) {
+        for (size_t i = 0; i < mats.size(); ++i) {
+            set(i, mats[i]);
+        }
+    }
+
+    /**
+     * \brief Number of matrices in the batch
+     */
+    size_t size() const {
+        return elements.cols();
+    }
+
+    /**
+     * \brief Change the number of matrices. The elements are uninitialized.
+     * \param count Number of matrices
+     */
+    void resize(size_t count) {
+        elements.resize(static_cast<Eigen::Index>(PackedSize), count);
+    }
+
+    /**
+     * \brief Copy the i-th matrix out of the batch
+     * \param i Index of the matrix
+     * \return The i-th matrix
+     */
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar> get(size_t i) const {
+        SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret;
+        Scalar* data = ret.data();
+        for (int k = 0; k < PackedSize; ++k) {
+            data[k] = elements(k, i);
+        }
+        return ret;
+    }
+
+    /**
+     * \brief Overwrite the i-th matrix of the batch
+     * \param i Index of the matrix
+     * \param mat New value of the i-th matrix
+     */
+    void set(size_t i,
+             const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& mat) {
+        const Scalar* data = mat.data();
+        for (int k = 0; k < PackedSize; ++k) {
+            elements(k, i) = data[k];
+        }
+    }
+
+    /**
+     * \brief Copy all matrices out of the batch
+     * \return Vector of all matrices
+     */
+    std::vector<SymmetricMatrix<Scalar, Dimension, ComputeScalar> >
+    toMatrices() const {
+        std::vector<SymmetricMatrix<Scalar, Dimension, ComputeScalar> >
+            ret(size());
+        for (size_t i = 0; i < size(); ++i) {
+            ret[i] = get(i);
+        }
+        return ret;
+    }
+
+    /**
+     * \brief Pointer to the packed element k of the first matrix. The element
+     * k of the i-th matrix is located at element(k)[i].
+     */
+    Scalar* element(int k) {
+        return elements.row(k).data();
+    }
+
+    /**
+     * \brief Pointer to the packed element k of the first matrix. The element
+     * k of the i-th matrix is located at element(k)[i].
+     */
+    const Scalar* element(int k) const {
+        return elements.row(k).data();
+    }
+
+    /**
+     * \brief Convert all elements to another scalar type
+     *
+     * The conversion is a single pass over the contiguous storage.
+     *
+     * \return Batch with elements of type NewScalar
+     */
+    template<typename NewScalar>
+    SymmetricMatrixBatch<NewScalar, Dimension> cast() const {
+        return cast<NewScalar, NewScalar>();
+    }
+
+    /**
+     * \brief Convert all elements to another scalar type and choose the
+     * type used for computations
+     * \return Batch with elements of type NewScalar
+     */
+    template<typename NewScalar, typename NewComputeScalar>
+    SymmetricMatrixBatch<NewScalar, Dimension, NewComputeScalar> cast() const {
+        SymmetricMatrixBatch<NewScalar, Dimension, NewComputeScalar>
+            ret(size());
+        symmat_internal::convertElements(elements.data(), elements.size(),
+                                         ret.packed().data());
+        return ret;
+    }
+
+    /**
+     * \brief Correlation matrices C_ij / sqrt(C_ii C_jj) of all covariance
+     * matrices. Variances that are not positive yield non-finite
+     * correlations.
+     * \return Batch of correlation matrices
+     */
+    SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>
+    correlation() const {
+        SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar> ret(size());
+        symmat_internal::batchCorrelation<Dimension, ComputeScalar>(
+            elements, ret.elements);
+        return ret;
+    }
+
+    /**
+     * \brief Convert all covariance matrices to correlation matrices in place
+     * \return Reference to this batch
+     */
+    SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>&
+    toCorrelation() {
+        symmat_internal::batchCorrelation<Dimension, ComputeScalar>(
+            elements, elements);
+        return *this;
+    }
+
+    /**
+     * \brief Covariance matrices R_ij sigma_i sigma_j of all correlation
+     * matrices
+     * \param stddev Standard deviations sigma, one column per matrix
+     * \return Batch of covariance matrices
+     */
+    SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>
+    covariance(const VectorBatch& stddev) const {
+        eigen_assert(static_cast<size_t>(stddev.cols()) == size()
+            && "Number of standard deviations does not match the batch");
+        SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar> ret(size());
+        symmat_internal::batchCovariance<Dimension, ComputeScalar>(
+            elements, stddev, ret.elements);
+        return ret;
+    }
+
+    /**
+     * \brief Convert all correlation matrices to covariance matrices in place
+     * \param stddev Standard deviations sigma, one column per matrix
+     * \return Reference to this batch
+     */
+    SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>&
+    toCovariance(const VectorBatch& stddev) {
+        eigen_assert(static_cast<size_t>(stddev.cols()) == size()
+            && "Number of standard deviations does not match the batch");
+        symmat_internal::batchCovariance<Dimension, ComputeScalar>(
+            elements, stddev, elements);
+        return *this;
+    }
+
+    /**
+     * \brief Underlying storage, one row per packed element
+     */
+    Storage& packed() {
+        return elements;
+    }
+
+    /**
+     * \brief Underlying storage, one row per packed element
+     */
+    const Storage& packed() const {
+        return elements;
+    }
+
+ private:
+    Storage elements;
+};
+
+namespace symmat_internal {
+
+template<typename T, typename Scalar, int Dimension>
+inline void
+chi2Block(const T* u, const Eigen::Array<Scalar, Dimension, Eigen::Dynamic,
+          Eigen::RowMajor>& residuals, Scalar* result, size_t t) {
+    typedef LaneTraits<T> Lane;
+    T r[Dimension];
+    for (int k = 0; k < Dimension; ++k) {
+        r[k] = Lane::load(&residuals(k, t));
+    }
+    Lane::store(result + t, fixedMahalanobis<Dimension>(u, r));
+}
+
+template<typename T, typename Scalar, int Dimension, typename ComputeScalar>
+inline bool
+chi2Block(const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& S,
+          const Eigen::Array<Scalar, Dimension, Eigen::Dynamic,
+          Eigen::RowMajor>& residuals, Scalar* result, size_t t) {
+    typedef LaneTraits<T> Lane;
+    enum { PackedSize = (Dimension * Dimension + Dimension) / 2 };
+    T u[PackedSize], r[Dimension];
+    for (int k = 0; k < PackedSize; ++k) {
+        u[k] = Lane::load(S.element(k) + t);
+    }
+    for (int k = 0; k < Dimension; ++k) {
+        r[k] = Lane::load(&residuals(k, t));
+    }
+    typename Lane::Mask ok = (fixedCholesky<Dimension>(u) > Lane::constant(0));
+    Lane::store(result + t, Lane::select(ok,
+        fixedMahalanobis<Dimension>(u, r),
+        Lane::constant(std::numeric_limits<ComputeScalar>::quiet_NaN())));
+    bool allOk = true;
+    for (int i = 0; i < Lane::Width; ++i) {
+        allOk = allOk && Lane::lane(ok, i);
+    }
+    return allOk;
+}
+
+}  // namespace symmat_internal
+
+/**
+ * \brief Chi-square r^T S^-1 r of many residuals r with the same covariance S
+ *
+ * S is factorized once in packed storage, every residual then only costs a
+ * triangular solve. Residuals are processed one per SIMD lane. All
+ * computations are done in ComputeScalar.
+ *
+ * \param S Covariance of the residuals
+ * \param residuals One residual per column, stored as structure of arrays
+ * \param result Chi-square of every residual
+ * \return Eigen::Success if S is positive definite, Eigen::NumericalIssue
+ * otherwise, in which case result is undefined
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar>
+Eigen::ComputationInfo
+chi2(const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& S,
+     const Eigen::Array<Scalar, Dimension, Eigen::Dynamic, Eigen::RowMajor>&
+     residuals, Eigen::Array<Scalar, Eigen::Dynamic, 1>& result) {
+    typedef Eigen::Array<ComputeScalar,
+        symmat_internal::BatchWidth<ComputeScalar>::value, 1> Packet;
+    enum { PackedSize = (Dimension * Dimension + Dimension) / 2 };
+    const size_t width = symmat_internal::BatchWidth<ComputeScalar>::value;
+    const size_t count = residuals.cols();
+    result.resize(count);
+
+    ComputeScalar u[PackedSize];
+    symmat_internal::convertElements(S.data(), PackedSize, u);
+    if (!(symmat_internal::fixedCholesky<Dimension>(u) > ComputeScalar(0))) {
+        return Eigen::NumericalIssue;
+    }
+    Packet uPacket[PackedSize];
+    for (int k = 0; k < PackedSize; ++k) {
+        uPacket[k] = Packet::Constant(u[k]);
+    }
+
+    size_t t = 0;
+    for (; t + width <= count; t += width) {
+        symmat_internal::chi2Block<Packet>(uPacket, residuals, result.data(),
+                                           t);
+    }
+    for (; t < count; ++t) {
+        symmat_internal::chi2Block<ComputeScalar>(u, residuals, result.data(),
+                                                  t);
+    }
+    return Eigen::Success;
+}
+
+/**
+ * \brief Chi-square r_i^T S_i^-1 r_i for a batch of covariances S_i with one
+ * residual r_i each
+ *
+ * Every S_i is factorized in packed storage and solved against r_i, one
+ * matrix per SIMD lane. All computations are done in ComputeScalar.
+ *
+ * \param S Covariances of the residuals
+ * \param residuals One residual per matrix, stored as structure of arrays
+ * \param result Chi-square of every residual, NaN where S_i is not positive
+ * definite
+ * \return Eigen::Success if all S_i are positive definite,
+ * Eigen::NumericalIssue otherwise
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar>
+Eigen::ComputationInfo
+chi2(const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& S,
+     const Eigen::Array<Scalar, Dimension, Eigen::Dynamic, Eigen::RowMajor>&
+     residuals, Eigen::Array<Scalar, Eigen::Dynamic, 1>& result) {
+    typedef Eigen::Array<ComputeScalar,
+        symmat_internal::BatchWidth<ComputeScalar>::value, 1> Packet;
+    eigen_assert(static_cast<size_t>(residuals.cols()) == S.size()
+        && "Number of residuals does not match the number of matrices");
+    const size_t width = symmat_internal::BatchWidth<ComputeScalar>::value;
+    result.resize(S.size());
+
+    bool ok = true;
+    size_t t = 0;
+    for (; t + width <= S.size(); t += width) {
+        ok = symmat_internal::chi2Block<Packet>(S, residuals, result.data(), t)
+             && ok;
+    }
+    for (; t < S.size(); ++t) {
+        ok = symmat_internal::chi2Block<ComputeScalar>(S, residuals,
+                                                       result.data(), t)
+             && ok;
+    }
+    return ok ? Eigen::Success : Eigen::NumericalIssue;
+}
+
+namespace symmat_internal {
+
+template<typename T, typename Scalar, int Dimension, typename ComputeScalar>
+inline void
+conditionBlock(const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& S,
+               bool* positiveDefinite, Scalar* rcond, size_t t) {
+    typedef LaneTraits<T> Lane;
+    enum { PackedSize = (Dimension * Dimension + Dimension) / 2 };
+    T a[PackedSize];
+    for (int k = 0; k < PackedSize; ++k) {
+        a[k] = Lane::load(S.element(k) + t);
+    }
+    T norm = Lane::constant(0);
+    if (rcond) {
+        norm = fixedNorm1<Dimension>(a);
+    }
+    typename Lane::Mask ok = (fixedCholesky<Dimension>(a) > Lane::constant(0));
+    if (positiveDefinite) {
+        for (int i = 0; i < Lane::Width; ++i) {
+            positiveDefinite[t + i] = Lane::lane(ok, i);
+        }
+    }
+    if (rcond) {
+        Lane::store(rcond + t, Lane::select(ok, Lane::constant(1)
+            / (norm * fixedInverseNorm1Estimate<Dimension>(a)),
+            Lane::constant(0)));
+    }
+}
+
+template<typename Scalar, int Dimension, typename ComputeScalar>
+inline void
+conditionBatch(const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& S,
+               bool* positiveDefinite, Scalar* rcond) {
+    typedef Eigen::Array<ComputeScalar, BatchWidth<ComputeScalar>::value, 1>
+        Packet;
+    const size_t width = BatchWidth<ComputeScalar>::value;
+    size_t t = 0;
+    for (; t + width <= S.size(); t += width) {
+        conditionBlock<Packet>(S, positiveDefinite, rcond, t);
+    }
+    for (; t < S.size(); ++t) {
+        conditionBlock<ComputeScalar>(S, positiveDefinite, rcond, t);
+    }
+}
+
+}  // namespace symmat_internal
+
+/**
+ * \brief Check every matrix of a batch for positive definiteness
+ *
+ * Attempts a Cholesky factorization of all matrices, one matrix per SIMD lane.
+ * No exception is thrown.
+ *
+ * \param S Batch of matrices
+ * \return True for every matrix that is positive definite
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar>
+Eigen::Array<bool, Eigen::Dynamic, 1>
+isPositiveDefinite(
+    const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& S) {
+    Eigen::Array<bool, Eigen::Dynamic, 1> ret(S.size());
+    symmat_internal::conditionBatch(S, ret.data(), static_cast<Scalar*>(0));
+    return ret;
+}
+
+/**
+ * \brief Estimate the reciprocal condition number in the 1-norm of every
+ * matrix of a batch
+ *
+ * Uses the Hager/Higham estimator on the packed Cholesky factors, one matrix
+ * per SIMD lane. No exception is thrown.
+ *
+ * \param S Batch of matrices
+ * \return Estimate of 1 / (|A|_1 |A^-1|_1) for every matrix, 0 for
+ * matrices that are not positive definite
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar>
+Eigen::Array<Scalar, Eigen::Dynamic, 1>
+rcondEstimate(const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& S) {
+    Eigen::Array<Scalar, Eigen::Dynamic, 1> ret(S.size());
+    symmat_internal::conditionBatch(S, static_cast<bool*>(0), ret.data());
+    return ret;
+}
+
+namespace symmat_internal {
+
+template<typename T, typename Scalar, int Dimension, typename ComputeScalar>
+inline void
+logDeterminantBlock(
+    const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& S,
+    Scalar* result, size_t t) {
+    typedef LaneTraits<T> Lane;
+    enum { PackedSize = (Dimension * Dimension + Dimension) / 2 };
+    T u[PackedSize];
+    for (int k = 0; k < PackedSize; ++k) {
+        u[k] = Lane::load(S.element(k) + t);
+    }
+    typename Lane::Mask ok = (fixedCholesky<Dimension>(u) > Lane::constant(0));
+    Lane::store(result + t, fixedLogDeterminant<Dimension>(u));
+
+    // Matrices that are not positive definite are rare, expand them one by one
+    for (int i = 0; i < Lane::Width; ++i) {
+        if (!Lane::lane(ok, i)) {
+            Scalar a[PackedSize];
+            for (int k = 0; k < PackedSize; ++k) {
+                a[k] = S.element(k)[t + i];
+            }
+            result[t + i] = static_cast<Scalar>(std::log(
+                packedDenseDeterminant<ComputeScalar, Dimension>(a,
+                                                                 Dimension)));
+        }
+    }
+}
+
+}  // namespace symmat_internal
+
+/**
+ * \brief Logarithm of the determinant of every matrix of a batch
+ *
+ * Computed from the diagonals of the packed Cholesky factors, one matrix per
+ * SIMD lane. Matrices that are not positive definite fall back to the
+ * determinant of the expanded matrix. No exception is thrown.
+ *
+ * \param S Batch of matrices
+ * \return log det A for every matrix, -infinity for singular matrices and
+ * NaN for matrices with a negative determinant
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar>
+Eigen::Array<Scalar, Eigen::Dynamic, 1>
+logDeterminant(
+    const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& S) {
+    typedef Eigen::Array<ComputeScalar,
+        symmat_internal::BatchWidth<ComputeScalar>::value, 1> Packet;
+    const size_t width = symmat_internal::BatchWidth<ComputeScalar>::value;
+    Eigen::Array<Scalar, Eigen::Dynamic, 1> ret(S.size());
+    size_t t = 0;
+    for (; t + width <= S.size(); t += width) {
+        symmat_internal::logDeterminantBlock<Packet>(S, ret.data(), t);
+    }
+    for (; t < S.size(); ++t) {
+        symmat_internal::logDeterminantBlock<ComputeScalar>(S, ret.data(), t);
+    }
+    return ret;
+}
+
+namespace symmat_internal {
+
+/**
+ * \brief sum_ij op(a_ij) b_ij of every pair of matrices of two batches.
+ *
+ * For every block of matrices the products of the packed elements are
+ * accumulated row by row, i.e., one vectorized pass over contiguous storage
+ * per packed element, with the off-diagonal elements weighted by 2. op is the
+ * identity for tr(A B) and the complex conjugate for <A, B>_F.
+ */
+template<int Dim, typename ComputeScalar, bool Conjugate, typename Src,
+         typename Dst>
+inline void
+batchTraceOfProduct(const Src& a, const Src& b, Dst& dst) {
+    typedef typename Dst::Scalar Scalar;
+    Eigen::Array<ComputeScalar, 1, Eigen::Dynamic> diagonal, offDiagonal;
+    for (Eigen::Index t = 0; t < a.cols(); t += ScaleBlockSize) {
+        const Eigen::Index len = std::min<Eigen::Index>(ScaleBlockSize,
+                                                        a.cols() - t);
+        diagonal.setZero(len);
+        offDiagonal.setZero(len);
+        for (int i = 0; i < Dim; ++i) {
+            for (int j = i; j < Dim; ++j) {
+                const int k = fixedIndex<Dim>(i, j);
+                Eigen::Array<ComputeScalar, 1, Eigen::Dynamic>& acc
+                    = (i == j) ? diagonal : offDiagonal;
+                if (Conjugate) {
+                    acc += a.row(k).segment(t, len)
+                        .template cast<ComputeScalar>().conjugate()
+                        * b.row(k).segment(t, len)
+                        .template cast<ComputeScalar>();
+                } else {
+                    acc += a.row(k).segment(t, len)
+                        .template cast<ComputeScalar>()
+                        * b.row(k).segment(t, len)
+                        .template cast<ComputeScalar>();
+                }
+            }
+        }
+        dst.segment(t, len) = (ComputeScalar(2) * offDiagonal + diagonal)
+            .transpose().template cast<Scalar>();
+    }
+}
+
+}  // namespace symmat_internal
+
+/**
+ * \brief Trace of every matrix of a batch
+ *
+ * Sums the Dimension rows of the storage that hold the diagonal elements, so
+ * every matrix is one SIMD lane. All computations are done in ComputeScalar.
+ *
+ * \param S Batch of matrices
+ * \return tr A for every matrix
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar>
+Eigen::Array<Scalar, Eigen::Dynamic, 1>
+trace(const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& S) {
+    Eigen::Array<ComputeScalar, 1, Eigen::Dynamic> acc
+        = Eigen::Array<ComputeScalar, 1, Eigen::Dynamic>::Zero(S.size());
+    for (int i = 0; i < Dimension; ++i) {
+        acc += S.packed().row(symmat_internal::fixedIndex<Dimension>(i, i))
+            .template cast<ComputeScalar>();
+    }
+    return acc.transpose().template cast<Scalar>();
+}
+
+/**
+ * \brief Trace tr(A_i B_i) of the products of the matrices of two batches
+ *
+ * Computed from the packed storages with the off-diagonal elements weighted
+ * by 2, without forming any product, one matrix per SIMD lane. All
+ * computations are done in ComputeScalar.
+ *
+ * \param A First batch of matrices
+ * \param B Second batch of matrices with the same size
+ * \return tr(A_i B_i) for every pair of matrices
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar>
+Eigen::Array<Scalar, Eigen::Dynamic, 1>
+traceOfProduct(
+    const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& A,
+    const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& B) {
+    eigen_assert(A.size() == B.size()
+        && "Number of matrices of both batches does not match");
+    Eigen::Array<Scalar, Eigen::Dynamic, 1> ret(A.size());
+    symmat_internal::batchTraceOfProduct<Dimension, ComputeScalar, false>(
+        A.packed(), B.packed(), ret);
+    return ret;
+}
+
+/**
+ * \brief Frobenius inner products <A_i, B_i>_F of the matrices of two
+ * batches
+ *
+ * Computed like traceOfProduct(). For real matrices both are the same.
+ *
+ * \param A First batch of matrices
+ * \param B Second batch of matrices with the same size
+ * \return <A_i, B_i>_F for every pair of matrices
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar>
+Eigen::Array<Scalar, Eigen::Dynamic, 1>
+frobeniusDot(
+    const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& A,
+    const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& B) {
+    eigen_assert(A.size() == B.size()
+        && "Number of matrices of both batches does not match");
+    Eigen::Array<Scalar, Eigen::Dynamic, 1> ret(A.size());
+    symmat_internal::batchTraceOfProduct<Dimension, ComputeScalar, true>(
+        A.packed(), B.packed(), ret);
+    return ret;
+}
+
+#endif /* GSOC_SYMMAT_BATCH_H */
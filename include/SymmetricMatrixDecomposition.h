@@ -0,0 +1,1339 @@
+#ifndef GSOC_SYMMAT_DECOMPOSITION_H
+#define GSOC_SYMMAT_DECOMPOSITION_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "SymmetricMatrix.h"
+#include "SymmetricMatrixBatch.h"
+
+namespace symmat_internal {
+
+/**
+ * \brief In-place Householder tridiagonalization A = Q T Q^T of packed
+ * storage, like LAPACK's dsptrd.
+ *
+ * Row i of the packed storage holds the elements A(i, i..n-1), which equal
+ * the column i of the lower triangle. Step i computes the Householder
+ * reflector H(i) = I - tau_i v v^T that annihilates A(i+2..n-1, i) and
+ * applies it from both sides to the trailing submatrix, whose packed rows are
+ * the trailing parts of the rows of a. This needs a packed matrix-vector
+ * product and a packed rank-2 update, both of which process one contiguous
+ * row at a time. Q = H(0) H(1) ... H(n-2) is not formed.
+ *
+ * \param a Packed storage of A. On return row i contains 1 followed by the
+ * essential part of the Householder vector of H(i) from its second element on.
+ * \param n Dimension of A
+ * \param diag Diagonal of T, n elements
+ * \param subdiag Subdiagonal of T, n - 1 elements
+ * \param tau Householder coefficients, n - 1 elements
+ * \param work Workspace of n elements
+ */
+template<typename Scalar>
+inline void
+packedTridiagonalize(Scalar* a, size_t n, Scalar* diag, Scalar* subdiag,
+                     Scalar* tau, Scalar* work) {
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> Vector;
+    size_t start = 0;
+    for (size_t i = 0; i + 1 < n; start += n - i, ++i) {
+        const size_t len = n - i - 1;
+        Eigen::Map<Vector> v(a + start + 1, len);
+        Eigen::Map<Vector> w(work, len);
+        Scalar beta;
+        v.makeHouseholderInPlace(tau[i], beta);
+        diag[i] = a[start];
+        subdiag[i] = beta;
+        v(0) = Scalar(1);
+
+        // w = tau A22 v, with A22 the trailing submatrix of dimension len
+        w.setZero();
+        for (size_t p = 0, row = start + n - i; p < len; row += len - p, ++p) {
+            Eigen::Map<const Vector> r(a + row, len - p);
+            w(p) += r.dot(v.tail(len - p));
+            w.tail(len - p - 1) += v(p) * r.tail(len - p - 1);
+        }
+        w *= tau[i];
+        w += (Scalar(-0.5) * tau[i] * w.dot(v)) * v;
+
+        // A22 = A22 - v w^T - w v^T
+        for (size_t p = 0, row = start + n - i; p < len; row += len - p, ++p) {
+            Eigen::Map<Vector>(a + row, len - p)
+                -= v(p) * w.tail(len - p) + w(p) * v.tail(len - p);
+        }
+    }
+    if (n > 0) {
+        diag[n - 1] = a[start];
+    }
+}
+
+/**
+ * \brief Form Q = H(0) H(1) ... H(n-2) from the output of
+ * packedTridiagonalize()
+ *
+ * The reflectors are applied from the last to the first, so each one only
+ * touches the trailing block it acts on.
+ *
+ * \param a Packed storage returned by packedTridiagonalize()
+ * \param tau Householder coefficients
+ * \param q Square matrix of dimension n, overwritten by Q
+ */
+template<typename Scalar, typename MatrixType>
+inline void
+packedTridiagonalQ(const Scalar* a, const Scalar* tau, MatrixType& q) {
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> Vector;
+    const int n = q.rows();
+    q.setIdentity();
+    Vector workspace(n);
+    for (int i = n - 2; i >= 0; --i) {
+        const int len = n - i - 1;
+        Eigen::Map<const Vector> essential(
+            a + packedIndex(i, i, n) + 2, len - 1);
+        q.bottomRightCorner(len, len).applyHouseholderOnTheLeft(
+            essential, tau[i], workspace.data());
+    }
+}
+
+/**
+ * \brief In-place Bunch-Kaufman factorization P A P^T = L D L^T of packed
+ * storage, like LAPACK's dsptrf.
+ *
+ * Row k of the packed storage holds A(k, k..n-1), which is the column k of
+ * the lower triangle. The factorization therefore runs from the top left to
+ * the bottom right like dsptrf for a lower packed matrix, and both the rank-1
+ * update of a 1x1 pivot and the rank-2 update of a 2x2 pivot subtract from
+ * one contiguous row of the trailing submatrix at a time.
+ *
+ * \param a Packed storage of A. On return the rows hold D and the multipliers
+ * of L below its unit diagonal.
+ * \param n Dimension of A
+ * \param pivots n elements. If pivots[k] >= 0, D(k, k) is a 1x1 block and
+ * rows and columns k and pivots[k] were interchanged. If
+ * pivots[k] = pivots[k + 1] = -p - 1, D(k..k+1, k..k+1) is a 2x2 block and
+ * rows and columns k + 1 and p were interchanged.
+ * \return -1 if D is nonsingular, otherwise the index of the first zero
+ * pivot. The factorization is completed in either case.
+ */
+template<typename Scalar>
+inline int
+packedBunchKaufman(Scalar* a, int n, int* pivots) {
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> Vector;
+    using std::abs;
+    const Scalar alpha = (Scalar(1) + std::sqrt(Scalar(17))) / Scalar(8);
+    int info = -1;
+    for (int k = 0, kstep = 1; k < n; k += kstep) {
+        const size_t kc = packedIndex(k, k, n);
+        int kp = k;
+        kstep = 1;
+
+        // Largest off-diagonal element in column k
+        const Scalar absakk = abs(a[kc]);
+        Scalar colmax(0);
+        int imax = k;
+        if (k < n - 1) {
+            colmax = Eigen::Map<Vector>(a + kc + 1, n - k - 1)
+                .cwiseAbs().maxCoeff(&imax);
+            imax += k + 1;
+        }
+
+        if (std::max(absakk, colmax) == Scalar(0)) {
+            if (info < 0) {
+                info = k;
+            }
+            pivots[k] = k;
+            continue;
+        }
+        if (absakk < alpha * colmax) {
+            // Largest off-diagonal element in row and column imax
+            Scalar rowmax(0);
+            for (int j = k; j < imax; ++j) {
+                rowmax = std::max(rowmax, abs(a[packedIndex(j, imax, n)]));
+            }
+            const size_t ic = packedIndex(imax, imax, n);
+            if (imax < n - 1) {
+                rowmax = std::max(rowmax, Eigen::Map<Vector>(
+                    a + ic + 1, n - imax - 1).cwiseAbs().maxCoeff());
+            }
+            if (absakk >= alpha * colmax * (colmax / rowmax)) {
+                kp = k;
+            } else if (abs(a[ic]) >= alpha * rowmax) {
+                kp = imax;
+            } else {
+                kp = imax;
+                kstep = 2;
+            }
+        }
+
+        // Interchange rows and columns kk and kp of the trailing submatrix
+        const int kk = k + kstep - 1;
+        if (kp != kk) {
+            if (kp < n - 1) {
+                Eigen::Map<Vector>(a + packedIndex(kk, kp + 1, n), n - kp - 1)
+                    .swap(Eigen::Map<Vector>(a + packedIndex(kp, kp + 1, n),
+                                             n - kp - 1));
+            }
+            for (int j = kk + 1; j < kp; ++j) {
+                std::swap(a[packedIndex(kk, j, n)], a[packedIndex(j, kp, n)]);
+            }
+            std::swap(a[packedIndex(kk, kk, n)], a[packedIndex(kp, kp, n)]);
+            if (kstep == 2) {
+                std::swap(a[kc + 1], a[kc + kp - k]);
+            }
+        }
+
+        if (kstep == 1) {
+            // A22 = A22 - x x^T / d with x = A(k+1..n-1, k), then L = x / d
+            if (k < n - 1) {
+                const Scalar r1 = Scalar(1) / a[kc];
+                Eigen::Map<Vector> x(a + kc + 1, n - k - 1);
+                size_t row = kc + n - k;
+                for (int j = k + 1; j < n; row += n - j, ++j) {
+                    Eigen::Map<Vector>(a + row, n - j)
+                        -= (r1 * x(j - k - 1)) * x.tail(n - j);
+                }
+                x *= r1;
+            }
+            pivots[k] = kp;
+        } else {
+            // A22 = A22 - X D^-1 X^T with X = A(k+2..n-1, k..k+1), then
+            // L = X D^-1. Element j of L is written after row j of A22 is
+            // updated, which is the last use of element j of X.
+            if (k < n - 2) {
+                const size_t kc1 = kc + n - k;
+                Scalar d21 = a[kc + 1];
+                const Scalar d11 = a[kc1] / d21;
+                const Scalar d22 = a[kc] / d21;
+                d21 = Scalar(1) / (d11 * d22 - Scalar(1)) / d21;
+                Eigen::Map<Vector> x0(a + kc + 2, n - k - 2);
+                Eigen::Map<Vector> x1(a + kc1 + 1, n - k - 2);
+                size_t row = kc1 + n - k - 1;
+                for (int j = k + 2; j < n; row += n - j, ++j) {
+                    const Scalar wk = d21 * (d11 * x0(j - k - 2)
+                                             - x1(j - k - 2));
+                    const Scalar wkp1 = d21 * (d22 * x1(j - k - 2)
+                                               - x0(j - k - 2));
+                    Eigen::Map<Vector>(a + row, n - j)
+                        -= wk * x0.tail(n - j) + wkp1 * x1.tail(n - j);
+                    x0(j - k - 2) = wk;
+                    x1(j - k - 2) = wkp1;
+                }
+            }
+            pivots[k] = pivots[k + 1] = -kp - 1;
+        }
+    }
+    return info;
+}
+
+/**
+ * \brief Solve A X = B in place with the factorization of
+ * packedBunchKaufman(), like LAPACK's dsptrs.
+ *
+ * \param a Packed factorization
+ * \param pivots Pivots returned by packedBunchKaufman()
+ * \param b Right hand sides with n rows, overwritten by X
+ */
+template<typename Scalar, typename MatrixType>
+inline void
+packedBunchKaufmanSolve(const Scalar* a, const int* pivots, MatrixType& b) {
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> Vector;
+    const int n = b.rows();
+
+    // Solve L D Y = P B
+    size_t kc = 0;
+    for (int k = 0; k < n;) {
+        if (pivots[k] >= 0) {
+            if (pivots[k] != k) {
+                b.row(k).swap(b.row(pivots[k]));
+            }
+            if (k < n - 1) {
+                b.bottomRows(n - k - 1).noalias()
+                    -= Eigen::Map<const Vector>(a + kc + 1, n - k - 1)
+                       * b.row(k);
+            }
+            b.row(k) /= a[kc];
+            kc += n - k;
+            k += 1;
+        } else {
+            const int kp = -pivots[k] - 1;
+            const size_t kc1 = kc + n - k;
+            if (kp != k + 1) {
+                b.row(k + 1).swap(b.row(kp));
+            }
+            if (k < n - 2) {
+                b.bottomRows(n - k - 2).noalias()
+                    -= Eigen::Map<const Vector>(a + kc + 2, n - k - 2)
+                       * b.row(k);
+                b.bottomRows(n - k - 2).noalias()
+                    -= Eigen::Map<const Vector>(a + kc1 + 1, n - k - 2)
+                       * b.row(k + 1);
+            }
+            const Scalar d21 = a[kc + 1];
+            const Scalar d11 = a[kc] / d21;
+            const Scalar d22 = a[kc1] / d21;
+            const Scalar denom = d11 * d22 - Scalar(1);
+            for (int c = 0; c < b.cols(); ++c) {
+                const Scalar b0 = b(k, c) / d21;
+                const Scalar b1 = b(k + 1, c) / d21;
+                b(k, c) = (d22 * b0 - b1) / denom;
+                b(k + 1, c) = (d11 * b1 - b0) / denom;
+            }
+            kc = kc1 + n - k - 1;
+            k += 2;
+        }
+    }
+
+    // Solve L^T P X = Y
+    for (int k = n - 1; k >= 0;) {
+        const size_t kc = packedIndex(k, k, n);
+        if (k < n - 1) {
+            b.row(k).noalias()
+                -= Eigen::Map<const Vector>(a + kc + 1, n - k - 1).transpose()
+                   * b.bottomRows(n - k - 1);
+        }
+        if (pivots[k] >= 0) {
+            if (pivots[k] != k) {
+                b.row(k).swap(b.row(pivots[k]));
+            }
+            k -= 1;
+        } else {
+            const int kp = -pivots[k] - 1;
+            if (k < n - 1) {
+                b.row(k - 1).noalias()
+                    -= Eigen::Map<const Vector>(
+                           a + packedIndex(k - 1, k + 1, n), n - k - 1)
+                       .transpose() * b.bottomRows(n - k - 1);
+            }
+            if (kp != k) {
+                b.row(k).swap(b.row(kp));
+            }
+            k -= 2;
+        }
+    }
+}
+
+/**
+ * \brief Rank-1 update U'^T U' = U^T U + sigma w w^T of a packed Cholesky
+ * factor in O(n^2), like Eigen's LLT::rankUpdate().
+ *
+ * Row j of the packed U is the column j of L = U^T, so both variants of
+ * Eigen's internal::llt_rank_update_lower() work on one contiguous row and
+ * the matching tail of w per step: An update (sigma > 0) applies a Givens
+ * rotation to each row, which is unconditionally stable. A downdate
+ * (sigma < 0) uses the hyperbolic recurrence, which fails as soon as the
+ * downdated matrix is not positive definite.
+ *
+ * \param u Packed storage of U, overwritten by U'
+ * \param n Dimension of U
+ * \param w Vector of size n, overwritten
+ * \param sigma Weight of the update, negative for a downdate
+ * \return -1 on success, otherwise the index of the first row whose pivot
+ * would not be positive. U is then only partially updated.
+ */
+template<typename Scalar>
+inline int
+packedCholeskyUpdate(Scalar* u, size_t n, Scalar* w, Scalar sigma) {
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> Vector;
+    if (sigma > Scalar(0)) {
+        Eigen::Map<Vector>(w, n) *= std::sqrt(sigma);
+        for (size_t j = 0; j < n; u += n - j, ++j) {
+            Eigen::JacobiRotation<Scalar> g;
+            g.makeGivens(u[0], -w[j], &u[0]);
+            if (j + 1 < n) {
+                Eigen::Map<Vector> row(u + 1, n - j - 1);
+                Eigen::Map<Vector> tail(w + j + 1, n - j - 1);
+                Eigen::internal::apply_rotation_in_the_plane(row, tail, g);
+            }
+        }
+        return -1;
+    }
+
+    Scalar beta(1);
+    for (size_t j = 0; j < n; u += n - j, ++j) {
+        const Scalar ujj = u[0];
+        const Scalar dj = ujj * ujj;
+        const Scalar wj = w[j];
+        const Scalar swj2 = sigma * wj * wj;
+        const Scalar gamma = dj * beta + swj2;
+        const Scalar pivot = dj + swj2 / beta;
+        if (!(pivot > Scalar(0))) {
+            return static_cast<int>(j);
+        }
+        const Scalar newUjj = std::sqrt(pivot);
+        u[0] = newUjj;
+        beta += swj2 / dj;
+        if (j + 1 < n) {
+            Eigen::Map<Vector> row(u + 1, n - j - 1);
+            Eigen::Map<Vector> tail(w + j + 1, n - j - 1);
+            tail -= (wj / ujj) * row;
+            if (gamma != Scalar(0)) {
+                row = (newUjj / ujj) * row
+                    + (newUjj * sigma * wj / gamma) * tail;
+            }
+        }
+    }
+    return -1;
+}
+
+/**
+ * \brief Closed-form eigendecomposition of packed symmetric matrices of
+ * dimension 2 and 3 for any lane type.
+ *
+ * The formulas follow Eigen::SelfAdjointEigenSolver::computeDirect(): The
+ * matrix is shifted by the mean eigenvalue and scaled to [-1, 1], the
+ * eigenvalues are the roots of the characteristic polynomial and the
+ * eigenvectors are cross products of rows of A - lambda I. Every branch of
+ * computeDirect() is replaced by a select, so each SIMD lane may take a
+ * different path.
+ */
+template<int Dim, typename T>
+struct EigenDirectKernel;
+
+template<typename T>
+struct EigenDirectKernel<2, T> {
+    typedef LaneTraits<T> Lane;
+    typedef typename Lane::Scalar Scalar;
+
+    /**
+     * \param a Packed storage of the matrix
+     * \param values Eigenvalues in increasing order
+     * \param vectors Eigenvectors stored row by row, the column k belongs to
+     * the k-th eigenvalue, or null
+     */
+    static void run(const T* a, T* values, T* vectors) {
+        const T shift = Lane::constant(0.5) * (a[0] + a[2]);
+        T m00 = a[0] - shift;
+        T m01 = a[1];
+        T m11 = a[2] - shift;
+        T scale = Lane::max(Lane::max(Lane::abs(m00), Lane::abs(m01)),
+                            Lane::abs(m11));
+        scale = Lane::select(scale > Lane::constant(0), scale,
+                             Lane::constant(1));
+        const T invScale = Lane::constant(1) / scale;
+        m00 = m00 * invScale;
+        m01 = m01 * invScale;
+        m11 = m11 * invScale;
+
+        const T t0 = Lane::constant(0.5) * Lane::sqrt((m00 - m11) * (m00 - m11)
+            + Lane::constant(4) * m01 * m01);
+        const T t1 = Lane::constant(0.5) * (m00 + m11);
+        const T r0 = t1 - t0;
+        const T r1 = t1 + t0;
+
+        if (vectors) {
+            const T eps = Lane::constant(Eigen::NumTraits<Scalar>::epsilon());
+            const typename Lane::Mask equal = (r1 - r0 <= Lane::abs(r1) * eps);
+            const T n00 = m00 - r1;
+            const T n11 = m11 - r1;
+            const T a2 = n00 * n00;
+            const T b2 = m01 * m01;
+            const T c2 = n11 * n11;
+            const typename Lane::Mask first = (a2 > c2);
+            const T norm = Lane::constant(1) / Lane::sqrt(
+                Lane::select(first, a2, c2) + b2);
+            // Eigenvector of r1, the one of r0 is orthogonal to it
+            T v0 = Lane::select(first, -m01, -n11) * norm;
+            T v1 = Lane::select(first, n00, m01) * norm;
+            v0 = Lane::select(equal, Lane::constant(0), v0);
+            v1 = Lane::select(equal, Lane::constant(1), v1);
+            vectors[0] = Lane::select(equal, Lane::constant(1), -v1);
+            vectors[1] = v0;
+            vectors[2] = v0;
+            vectors[3] = v1;
+        }
+        values[0] = r0 * scale + shift;
+        values[1] = r1 * scale + shift;
+    }
+};
+
+template<typename T>
+struct EigenDirectKernel<3, T> {
+    typedef LaneTraits<T> Lane;
+    typedef typename Lane::Scalar Scalar;
+    typedef typename Lane::Mask Mask;
+
+    static T dot(const T* x, const T* y) {
+        return x[0] * y[0] + x[1] * y[1] + x[2] * y[2];
+    }
+
+    static void cross(const T* x, const T* y, T* res) {
+        res[0] = x[1] * y[2] - x[2] * y[1];
+        res[1] = x[2] * y[0] - x[0] * y[2];
+        res[2] = x[0] * y[1] - x[1] * y[0];
+    }
+
+    static void select(const Mask& mask, const T* x, const T* y, T* res) {
+        for (int i = 0; i < 3; ++i) {
+            res[i] = Lane::select(mask, x[i], y[i]);
+        }
+    }
+
+    static void normalize(T* x) {
+        const T inv = Lane::constant(1) / Lane::sqrt(dot(x, x));
+        for (int i = 0; i < 3; ++i) {
+            x[i] = x[i] * inv;
+        }
+    }
+
+    /**
+     * \brief Kernel of the rank 2 matrix m - lambda I like extract_kernel()
+     * of Eigen. Also returns a column of m - lambda I that is orthogonal to
+     * the kernel.
+     */
+    static void kernel(const T* m, const T& lambda, T* res,
+                       T* representative) {
+        T cols[3][3];
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                cols[j][i] = m[fixedIndex<3>(i, j)];
+            }
+            cols[i][i] = cols[i][i] - lambda;
+        }
+        const T d0 = Lane::abs(cols[0][0]);
+        const T d1 = Lane::abs(cols[1][1]);
+        const T d2 = Lane::abs(cols[2][2]);
+        const Mask is0 = (d0 >= d1 && d0 >= d2);
+        const Mask is1 = (d1 >= d2);
+        T other1[3], other2[3], tmp[3];
+        select(is1, cols[1], cols[2], tmp);
+        select(is0, cols[0], tmp, representative);
+        select(is1, cols[2], cols[0], tmp);
+        select(is0, cols[1], tmp, other1);
+        select(is1, cols[0], cols[1], tmp);
+        select(is0, cols[2], tmp, other2);
+
+        T c0[3], c1[3];
+        cross(representative, other1, c0);
+        cross(representative, other2, c1);
+        const T n0 = dot(c0, c0);
+        const T n1 = dot(c1, c1);
+        select(n0 > n1, c0, c1, res);
+        const T inv = Lane::constant(1) / Lane::sqrt(Lane::max(n0, n1));
+        for (int i = 0; i < 3; ++i) {
+            res[i] = res[i] * inv;
+        }
+    }
+
+    /**
+     * \param a Packed storage of the matrix
+     * \param values Eigenvalues in increasing order
+     * \param vectors Eigenvectors stored row by row, the column k belongs to
+     * the k-th eigenvalue, or null
+     */
+    static void run(const T* a, T* values, T* vectors) {
+        const T shift = (a[0] + a[3] + a[5]) * Lane::constant(Scalar(1) / 3);
+        T m[6];
+        T scale = Lane::constant(0);
+        for (int k = 0; k < 6; ++k) {
+            m[k] = a[k];
+            if (k == 0 || k == 3 || k == 5) {
+                m[k] = m[k] - shift;
+            }
+            scale = Lane::max(scale, Lane::abs(m[k]));
+        }
+        scale = Lane::select(scale > Lane::constant(0), scale,
+                             Lane::constant(1));
+        const T invScale = Lane::constant(1) / scale;
+        for (int k = 0; k < 6; ++k) {
+            m[k] = m[k] * invScale;
+        }
+
+        // Roots of x^3 - c2 x^2 + c1 x - c0
+        const T c0 = m[0] * m[3] * m[5] + Lane::constant(2) * m[1] * m[2] * m[4]
+            - m[0] * m[4] * m[4] - m[3] * m[2] * m[2] - m[5] * m[1] * m[1];
+        const T c1 = m[0] * m[3] - m[1] * m[1] + m[0] * m[5] - m[2] * m[2]
+            + m[3] * m[5] - m[4] * m[4];
+        const T c2 = m[0] + m[3] + m[5];
+        const T c2Over3 = c2 * Lane::constant(Scalar(1) / 3);
+        const T aOver3 = Lane::max((c2 * c2Over3 - c1)
+            * Lane::constant(Scalar(1) / 3), Lane::constant(0));
+        const T halfB = Lane::constant(0.5) * (c0 + c2Over3
+            * (Lane::constant(2) * c2Over3 * c2Over3 - c1));
+        const T q = Lane::max(aOver3 * aOver3 * aOver3 - halfB * halfB,
+                              Lane::constant(0));
+        const T rho = Lane::sqrt(aOver3);
+        // atan2(sqrt(q), halfB) in [0, pi] since sqrt(q) >= 0
+        const T pi = Lane::constant(Scalar(EIGEN_PI));
+        const T angle = Lane::select(halfB == Lane::constant(0),
+            pi * Lane::constant(0.5),
+            Lane::atan(Lane::sqrt(q) / halfB)
+            + Lane::select(halfB < Lane::constant(0), pi,
+                           Lane::constant(0)));
+        const T theta = angle * Lane::constant(Scalar(1) / 3);
+        const T cosTheta = Lane::cos(theta);
+        const T sinTheta = Lane::sin(theta);
+        const T sqrt3 = Lane::constant(std::sqrt(Scalar(3)));
+        T r[3];
+        r[0] = c2Over3 - rho * (cosTheta + sqrt3 * sinTheta);
+        r[1] = c2Over3 - rho * (cosTheta - sqrt3 * sinTheta);
+        r[2] = c2Over3 + Lane::constant(2) * rho * cosTheta;
+
+        if (vectors) {
+            const T eps = Lane::constant(Eigen::NumTraits<Scalar>::epsilon());
+            const Mask equal = (r[2] - r[0] <= eps);
+            const T d0 = r[2] - r[1];
+            const T d1 = r[1] - r[0];
+            // k is the index of the most distinct eigenvalue, l the other end
+            const Mask swap = (d0 > d1);
+            const T lambdaK = Lane::select(swap, r[2], r[0]);
+            const T lambdaL = Lane::select(swap, r[0], r[2]);
+            T vk[3], vl[3], representative[3], other[3];
+            kernel(m, lambdaK, vk, representative);
+
+            // If the two other eigenvalues are numerically equal, the saved
+            // column only has to be orthonormalized against vk
+            const T proj = dot(vk, representative);
+            for (int i = 0; i < 3; ++i) {
+                representative[i] = representative[i] - proj * vk[i];
+            }
+            normalize(representative);
+            kernel(m, lambdaL, other, vl);
+            const Mask close = (Lane::min(d0, d1)
+                <= Lane::constant(2) * eps * Lane::max(d0, d1));
+            select(close, representative, other, vl);
+
+            T v[3][3];
+            select(swap, vk, vl, v[2]);
+            select(swap, vl, vk, v[0]);
+            cross(v[2], v[0], v[1]);
+            normalize(v[1]);
+            for (int i = 0; i < 3; ++i) {
+                for (int j = 0; j < 3; ++j) {
+                    vectors[i * 3 + j] = Lane::select(equal,
+                        Lane::constant(i == j ? 1 : 0), v[j][i]);
+                }
+            }
+        }
+        for (int i = 0; i < 3; ++i) {
+            values[i] = r[i] * scale + shift;
+        }
+    }
+};
+
+}  // namespace symmat_internal
+
+/**
+ * \class SymmetricEigenSolver<typename Scalar, typename ComputeScalar>
+ * \brief Eigendecomposition of a SymmetricMatrix that starts from packed
+ * storage
+ *
+ * The matrix is reduced to tridiagonal form by Householder reflections
+ * directly in packed storage (see symmat_internal::packedTridiagonalize()).
+ * The eigenvalues of the tridiagonal matrix are then found by the implicit
+ * QR iteration of Eigen::SelfAdjointEigenSolver. Compared to
+ * constructEigenMatrix() followed by Eigen::SelfAdjointEigenSolver, the
+ * solver needs half the memory if only eigenvalues are requested, since
+ * neither the dense matrix nor a dense working copy is formed. If
+ * eigenvectors are requested the only dense matrix is the matrix of
+ * eigenvectors itself.
+ *
+ * Computations are carried out in ComputeScalar. The eigenvalues are sorted
+ * in increasing order.
+ */
+template<typename Scalar, typename ComputeScalar = Scalar>
+class SymmetricEigenSolver {
+ public:
+    typedef Eigen::Matrix<ComputeScalar, Eigen::Dynamic, 1> RealVectorType;
+    typedef Eigen::Matrix<ComputeScalar, Eigen::Dynamic, Eigen::Dynamic>
+        EigenvectorsType;
+
+    /**
+     * \brief Default constructor, compute() has to be called before use
+     */
+    SymmetricEigenSolver() : status(Eigen::InvalidInput),
+                             hasEigenvectors(false) {}
+
+    /**
+     * \brief Construct and compute the eigendecomposition
+     * \see compute()
+     */
+    template<int Dimension>
+    explicit SymmetricEigenSolver(
+        const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& mat,
+        int options = Eigen::ComputeEigenvectors) {
+        compute(mat, options);
+    }
+
+    /**
+     * \brief Compute the eigendecomposition of a symmetric matrix
+     * \param mat Symmetric matrix
+     * \param options Eigen::ComputeEigenvectors or Eigen::EigenvaluesOnly
+     * \return Reference to the current instance
+     */
+    template<int Dimension>
+    SymmetricEigenSolver&
+    compute(const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& mat,
+            int options = Eigen::ComputeEigenvectors) {
+        eigen_assert((options == Eigen::ComputeEigenvectors
+                      || options == Eigen::EigenvaluesOnly)
+            && "Invalid option parameter");
+        const int n = mat.dim();
+        const size_t packedSize = (size_t(n) * n + n) / 2;
+        hasEigenvectors = (options == Eigen::ComputeEigenvectors);
+
+        // Scale to avoid over- and underflow like SelfAdjointEigenSolver
+        std::vector<ComputeScalar> packed(packedSize);
+        symmat_internal::convertElements(mat.data(), packedSize,
+                                         packed.data());
+        Eigen::Map<RealVectorType> elements(packed.data(), packedSize);
+        ComputeScalar scale = (n > 0) ? elements.cwiseAbs().maxCoeff()
+                                      : ComputeScalar(0);
+        if (scale == ComputeScalar(0)) {
+            scale = ComputeScalar(1);
+        }
+        elements /= scale;
+
+        values.resize(n);
+        RealVectorType subdiag(std::max(n - 1, 0));
+        RealVectorType tau(std::max(n - 1, 0));
+        RealVectorType work(n);
+        symmat_internal::packedTridiagonalize(packed.data(), n, values.data(),
+                                              subdiag.data(), tau.data(),
+                                              work.data());
+        if (hasEigenvectors) {
+            vectors.resize(n, n);
+            symmat_internal::packedTridiagonalQ(packed.data(), tau.data(),
+                                                vectors);
+        } else {
+            vectors.resize(0, 0);
+        }
+        // Free the packed copy before the QR iteration
+        std::vector<ComputeScalar>().swap(packed);
+
+        status = Eigen::Success;
+        if (n > 1) {
+            status = Eigen::internal::computeFromTridiagonal_impl(values,
+                subdiag, Eigen::SelfAdjointEigenSolver<EigenvectorsType>
+                ::m_maxIterations, hasEigenvectors, vectors);
+        }
+        values *= scale;
+        return *this;
+    }
+
+    /**
+     * \brief Eigenvalues in increasing order
+     */
+    const RealVectorType& eigenvalues() const {
+        eigen_assert(status != Eigen::InvalidInput
+            && "SymmetricEigenSolver is not initialized.");
+        return values;
+    }
+
+    /**
+     * \brief Normalized eigenvectors, the column k belongs to the k-th
+     * eigenvalue
+     */
+    const EigenvectorsType& eigenvectors() const {
+        eigen_assert(status != Eigen::InvalidInput
+            && "SymmetricEigenSolver is not initialized.");
+        eigen_assert(hasEigenvectors
+            && "The eigenvectors have not been computed together with the "
+            && "eigenvalues.");
+        return vectors;
+    }
+
+    /**
+     * \brief Eigen::Success if the QR iteration converged,
+     * Eigen::NoConvergence otherwise
+     */
+    Eigen::ComputationInfo info() const {
+        return status;
+    }
+
+ private:
+    RealVectorType values;
+    EigenvectorsType vectors;
+    Eigen::ComputationInfo status;
+    bool hasEigenvectors;
+};
+
+/**
+ * \class SymmetricLDLT<typename Scalar, typename ComputeScalar>
+ * \brief Bunch-Kaufman factorization P A P^T = L D L^T of a symmetric,
+ * possibly indefinite SymmetricMatrix in packed storage
+ *
+ * D is block diagonal with blocks of dimension 1 and 2, which makes the
+ * factorization stable for indefinite matrices like the KKT systems of
+ * constrained fits, for which LLT fails. The factorization works in a packed
+ * copy of the matrix (see symmat_internal::packedBunchKaufman()), so it needs
+ * half the memory of constructEigenMatrix() followed by Eigen::LDLT. Since D
+ * is congruent to A, the inertia of A follows from the blocks of D.
+ *
+ * Computations are carried out in ComputeScalar.
+ */
+template<typename Scalar, typename ComputeScalar = Scalar>
+class SymmetricLDLT {
+ public:
+    /**
+     * \brief Default constructor, compute() has to be called before use
+     */
+    SymmetricLDLT() : status(Eigen::InvalidInput), dimension(0) {}
+
+    /**
+     * \brief Construct and compute the factorization
+     * \see compute()
+     */
+    template<int Dimension>
+    explicit SymmetricLDLT(
+        const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& mat) {
+        compute(mat);
+    }
+
+    /**
+     * \brief Compute the factorization of a symmetric matrix
+     * \param mat Symmetric matrix
+     * \return Reference to the current instance
+     */
+    template<int Dimension>
+    SymmetricLDLT&
+    compute(const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& mat) {
+        dimension = mat.dim();
+        const size_t packedSize = (size_t(dimension) * dimension
+                                   + dimension) / 2;
+        packed.resize(packedSize);
+        pivots.resize(dimension);
+        symmat_internal::convertElements(mat.data(), packedSize,
+                                         packed.data());
+        status = symmat_internal::packedBunchKaufman(packed.data(), dimension,
+                                                     pivots.data()) < 0
+                 ? Eigen::Success : Eigen::NumericalIssue;
+        return *this;
+    }
+
+    /**
+     * \brief Solve A x = b
+     *
+     * If the matrix is singular (info() returns Eigen::NumericalIssue) the
+     * result contains infinities or NaNs.
+     *
+     * \param b Right hand side, a vector or a matrix with one right hand side
+     * per column
+     */
+    template<typename Rhs>
+    Eigen::Matrix<ComputeScalar, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+    solve(const Eigen::MatrixBase<Rhs>& b) const {
+        eigen_assert(status != Eigen::InvalidInput
+            && "SymmetricLDLT is not initialized.");
+        eigen_assert(b.rows() == dimension
+            && "Dimensions of matrix and right hand side do not match");
+        Eigen::Matrix<ComputeScalar, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+            x = b.template cast<ComputeScalar>();
+        symmat_internal::packedBunchKaufmanSolve(packed.data(), pivots.data(),
+                                                 x);
+        return x;
+    }
+
+    /**
+     * \brief Number of positive, negative and zero eigenvalues of the matrix
+     *
+     * A 1x1 block of D contributes its sign. A 2x2 block contributes one
+     * positive and one negative eigenvalue if its determinant is negative,
+     * and otherwise two (or, if the determinant is zero, one) eigenvalues
+     * with the sign of its trace.
+     */
+    void inertia(int& positive, int& negative, int& zero) const {
+        eigen_assert(status != Eigen::InvalidInput
+            && "SymmetricLDLT is not initialized.");
+        positive = negative = zero = 0;
+        size_t kc = 0;
+        for (int k = 0; k < dimension;) {
+            if (pivots[k] >= 0) {
+                const ComputeScalar d = packed[kc];
+                (d > ComputeScalar(0) ? positive
+                 : d < ComputeScalar(0) ? negative : zero) += 1;
+                kc += dimension - k;
+                k += 1;
+            } else {
+                // The determinant has the sign of d11 d22 / d21^2 - 1
+                const size_t kc1 = kc + dimension - k;
+                const ComputeScalar d21 = packed[kc + 1];
+                const ComputeScalar det = (packed[kc] / d21)
+                    * (packed[kc1] / d21) - ComputeScalar(1);
+                const ComputeScalar trace = packed[kc] + packed[kc1];
+                if (det < ComputeScalar(0)) {
+                    positive += 1;
+                    negative += 1;
+                } else {
+                    const int count = (det > ComputeScalar(0)) ? 2 : 1;
+                    zero += 2 - count;
+                    (trace > ComputeScalar(0) ? positive : negative) += count;
+                }
+                kc = kc1 + dimension - k - 1;
+                k += 2;
+            }
+        }
+    }
+
+    /**
+     * \brief Eigen::Success if D is nonsingular, Eigen::NumericalIssue
+     * otherwise
+     */
+    Eigen::ComputationInfo info() const {
+        return status;
+    }
+
+ private:
+    std::vector<ComputeScalar> packed;
+    std::vector<int> pivots;
+    Eigen::ComputationInfo status;
+    int dimension;
+};
+
+/**
+ * \class SymmetricLLT<typename Scalar, typename ComputeScalar>
+ * \brief Cholesky factorization A = U^T U of a positive definite
+ * SymmetricMatrix in packed storage that supports rank-1 updates
+ *
+ * The factor is kept in packed storage (see symmat_internal::packedCholesky()),
+ * so it needs half the memory of Eigen::LLT. choleskyUpdate() adds or removes
+ * a rank-1 term sigma x x^T in O(n^2) instead of refactorizing in O(n^3),
+ * e.g., to remove the contribution of an outlier from the normal equations
+ * of a fit.
+ *
+ * Computations are carried out in ComputeScalar.
+ */
+template<typename Scalar, typename ComputeScalar = Scalar>
+class SymmetricLLT {
+ public:
+    /**
+     * \brief Default constructor, compute() has to be called before use
+     */
+    SymmetricLLT() : status(Eigen::InvalidInput), dimension(0) {}
+
+    /**
+     * \brief Construct and compute the factorization
+     * \see compute()
+     */
+    template<int Dimension>
+    explicit SymmetricLLT(
+        const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& mat) {
+        compute(mat);
+    }
+
+    /**
+     * \brief Compute the factorization of a symmetric matrix
+     * \param mat Symmetric matrix
+     * \return Reference to the current instance
+     */
+    template<int Dimension>
+    SymmetricLLT&
+    compute(const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& mat) {
+        dimension = mat.dim();
+        const size_t packedSize = (size_t(dimension) * dimension
+                                   + dimension) / 2;
+        packed.resize(packedSize);
+        work.resize(dimension);
+        symmat_internal::convertElements(mat.data(), packedSize,
+                                         packed.data());
+        status = symmat_internal::packedCholesky(packed.data(), dimension) < 0
+                 ? Eigen::Success : Eigen::NumericalIssue;
+        return *this;
+    }
+
+    /**
+     * \brief Update the factorization to the one of A + sigma x x^T
+     *
+     * If a downdate (sigma < 0) leaves a matrix that is not positive
+     * definite, info() returns Eigen::NumericalIssue afterwards and compute()
+     * has to be called again before the factorization can be used.
+     *
+     * \param x Vector of size dim()
+     * \param sigma Weight of the update, negative for a downdate
+     * \return Reference to the current instance
+     */
+    template<typename Derived>
+    SymmetricLLT& choleskyUpdate(const Eigen::MatrixBase<Derived>& x,
+                                 const ComputeScalar& sigma) {
+        eigen_assert(status != Eigen::InvalidInput
+            && "SymmetricLLT is not initialized.");
+        eigen_assert(x.size() == dimension
+            && "Dimensions of matrix and update vector do not match");
+        Eigen::Map<Eigen::Matrix<ComputeScalar, Eigen::Dynamic, 1> >(
+            work.data(), dimension) = x.template cast<ComputeScalar>();
+        if (symmat_internal::packedCholeskyUpdate(packed.data(), dimension,
+                                                  work.data(), sigma) >= 0) {
+            status = Eigen::NumericalIssue;
+        }
+        return *this;
+    }
+
+    /**
+     * \brief Solve A x = b
+     * \param b Right hand side, a vector or a matrix with one right hand side
+     * per column
+     */
+    template<typename Rhs>
+    Eigen::Matrix<ComputeScalar, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+    solve(const Eigen::MatrixBase<Rhs>& b) const {
+        eigen_assert(status != Eigen::InvalidInput
+            && "SymmetricLLT is not initialized.");
+        eigen_assert(b.rows() == dimension
+            && "Dimensions of matrix and right hand side do not match");
+        Eigen::Matrix<ComputeScalar, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+            x = b.template cast<ComputeScalar>();
+        for (Eigen::Index c = 0; c < x.cols(); ++c) {
+            symmat_internal::packedForwardSolve(packed.data(), dimension,
+                                                x.col(c).data());
+            symmat_internal::packedBackSolve(packed.data(), dimension,
+                                             x.col(c).data());
+        }
+        return x;
+    }
+
+    /**
+     * \brief Upper triangular factor U as Eigen::Matrix, the strictly lower
+     * part is zero
+     */
+    Eigen::Matrix<ComputeScalar, Eigen::Dynamic, Eigen::Dynamic>
+    matrixU() const {
+        eigen_assert(status != Eigen::InvalidInput
+            && "SymmetricLLT is not initialized.");
+        Eigen::Matrix<ComputeScalar, Eigen::Dynamic, Eigen::Dynamic> ret
+            = Eigen::Matrix<ComputeScalar, Eigen::Dynamic,
+                            Eigen::Dynamic>::Zero(dimension, dimension);
+        const ComputeScalar* row = packed.data();
+        for (int i = 0; i < dimension; row += dimension - i, ++i) {
+            for (int j = i; j < dimension; ++j) {
+                ret(i, j) = row[j - i];
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * \brief Logarithm of the determinant of A
+     */
+    ComputeScalar logDeterminant() const {
+        eigen_assert(status == Eigen::Success
+            && "SymmetricLLT has no valid factorization.");
+        return symmat_internal::packedLogDeterminant(packed.data(), dimension);
+    }
+
+    /**
+     * \brief Eigen::Success if the matrix is positive definite,
+     * Eigen::NumericalIssue otherwise
+     */
+    Eigen::ComputationInfo info() const {
+        return status;
+    }
+
+ private:
+    std::vector<ComputeScalar> packed;
+    std::vector<ComputeScalar> work;
+    Eigen::ComputationInfo status;
+    int dimension;
+};
+
+/**
+ * \class DirectEigenSolver<typename Scalar, int Dimension,
+ * typename ComputeScalar>
+ * \brief Closed-form eigendecomposition of a SymmetricMatrix of dimension 2
+ * or 3
+ *
+ * The counterpart of Eigen::SelfAdjointEigenSolver::computeDirect() that reads
+ * the packed storage directly. All results have fixed dimensions, so nothing
+ * is allocated. The eigenvalues are sorted in increasing order. For many
+ * matrices use eigenDirect() on a SymmetricMatrixBatch, which processes one
+ * matrix per SIMD lane.
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar = Scalar>
+class DirectEigenSolver {
+ public:
+    typedef Eigen::Matrix<Scalar, Dimension, 1> RealVectorType;
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> EigenvectorsType;
+
+    /**
+     * \brief Default constructor, compute() has to be called before use
+     */
+    DirectEigenSolver() : hasEigenvectors(false) {}
+
+    /**
+     * \brief Construct and compute the eigendecomposition
+     * \see compute()
+     */
+    explicit DirectEigenSolver(
+        const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& mat,
+        int options = Eigen::ComputeEigenvectors) {
+        compute(mat, options);
+    }
+
+    /**
+     * \brief Compute the eigendecomposition in closed form
+     * \param mat Symmetric matrix
+     * \param options Eigen::ComputeEigenvectors or Eigen::EigenvaluesOnly
+     * \return Reference to the current instance
+     */
+    DirectEigenSolver&
+    compute(const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& mat,
+            int options = Eigen::ComputeEigenvectors) {
+        EIGEN_STATIC_ASSERT(Dimension == 2 || Dimension == 3,
+                            THIS_METHOD_IS_ONLY_FOR_MATRICES_OF_A_SPECIFIC_SIZE)
+        enum { PackedSize = (Dimension * Dimension + Dimension) / 2 };
+        eigen_assert((options == Eigen::ComputeEigenvectors
+                      || options == Eigen::EigenvaluesOnly)
+            && "Invalid option parameter");
+        ComputeScalar a[PackedSize];
+        ComputeScalar eivals[Dimension];
+        ComputeScalar eivecs[Dimension * Dimension];
+        symmat_internal::convertElements(mat.data(), PackedSize, a);
+        hasEigenvectors = (options == Eigen::ComputeEigenvectors);
+        symmat_internal::EigenDirectKernel<Dimension, ComputeScalar>::run(
+            a, eivals, hasEigenvectors ? eivecs : 0);
+        for (int i = 0; i < Dimension; ++i) {
+            values(i) = static_cast<Scalar>(eivals[i]);
+            for (int j = 0; hasEigenvectors && j < Dimension; ++j) {
+                vectors(i, j) = static_cast<Scalar>(eivecs[i * Dimension + j]);
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * \brief Eigenvalues in increasing order
+     */
+    const RealVectorType& eigenvalues() const {
+        return values;
+    }
+
+    /**
+     * \brief Normalized eigenvectors, the column k belongs to the k-th
+     * eigenvalue
+     */
+    const EigenvectorsType& eigenvectors() const {
+        eigen_assert(hasEigenvectors
+            && "The eigenvectors have not been computed together with the "
+            && "eigenvalues.");
+        return vectors;
+    }
+
+ private:
+    RealVectorType values;
+    EigenvectorsType vectors;
+    bool hasEigenvectors;
+};
+
+namespace symmat_internal {
+
+template<typename T, typename Scalar, int Dimension, typename ComputeScalar>
+inline void
+eigenDirectBlock(
+    const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& mats,
+    Eigen::Array<Scalar, Dimension, Eigen::Dynamic, Eigen::RowMajor>& values,
+    Eigen::Array<Scalar, Dimension * Dimension, Eigen::Dynamic,
+                 Eigen::RowMajor>* vectors, size_t t) {
+    typedef LaneTraits<T> Lane;
+    enum { PackedSize = (Dimension * Dimension + Dimension) / 2 };
+    T a[PackedSize], eivals[Dimension], eivecs[Dimension * Dimension];
+    for (int k = 0; k < PackedSize; ++k) {
+        a[k] = Lane::load(mats.element(k) + t);
+    }
+    EigenDirectKernel<Dimension, T>::run(a, eivals, vectors ? eivecs : 0);
+    for (int i = 0; i < Dimension; ++i) {
+        Lane::store(&values(i, t), eivals[i]);
+    }
+    for (int k = 0; vectors && k < Dimension * Dimension; ++k) {
+        Lane::store(&(*vectors)(k, t), eivecs[k]);
+    }
+}
+
+}  // namespace symmat_internal
+
+/**
+ * \brief Closed-form eigendecomposition of every matrix of a batch of
+ * dimension 2 or 3
+ *
+ * Uses the same formulas as DirectEigenSolver, one matrix per SIMD lane.
+ *
+ * \param mats Batch of matrices
+ * \param values Eigenvalues in increasing order, one column per matrix
+ * \param vectors If not null, the eigenvectors. Element (r, c) of the
+ * eigenvector matrix of a matrix is stored in row r * Dimension + c, the
+ * column c belongs to the c-th eigenvalue.
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar>
+void
+eigenDirect(const SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar>& mats,
+            Eigen::Array<Scalar, Dimension, Eigen::Dynamic, Eigen::RowMajor>&
+            values,
+            Eigen::Array<Scalar, Dimension * Dimension, Eigen::Dynamic,
+                         Eigen::RowMajor>* vectors = 0) {
+    EIGEN_STATIC_ASSERT(Dimension == 2 || Dimension == 3,
+                        THIS_METHOD_IS_ONLY_FOR_MATRICES_OF_A_SPECIFIC_SIZE)
+    typedef Eigen::Array<ComputeScalar, symmat_internal::BatchWidth<
+        ComputeScalar>::value, 1> Packet;
+    const size_t width = symmat_internal::BatchWidth<ComputeScalar>::value;
+    values.resize(Dimension, mats.size());
+    if (vectors) {
+        vectors->resize(Dimension * Dimension, mats.size());
+    }
+    size_t t = 0;
+    for (; t + width <= mats.size(); t += width) {
+        symmat_internal::eigenDirectBlock<Packet>(mats, values, vectors, t);
+    }
+    for (; t < mats.size(); ++t) {
+        symmat_internal::eigenDirectBlock<ComputeScalar>(mats, values,
+                                                         vectors, t);
+    }
+}
+
+namespace symmat_internal {
+
+/**
+ * \brief Packed storage of V diag(f) V^T
+ *
+ * Row i of the packed result holds the products of the rows i..n-1 of V with
+ * the row i of V scaled by f, so only the upper triangle is computed and no
+ * dense result is formed.
+ *
+ * \param vectors Matrix V
+ * \param f Diagonal
+ * \param dst Packed storage of the result
+ */
+template<typename VectorsType, typename ValuesType, typename Scalar>
+inline void
+packedSpectralProduct(const VectorsType& vectors, const ValuesType& f,
+                      Scalar* dst) {
+    typedef Eigen::Matrix<typename VectorsType::Scalar,
+                          VectorsType::RowsAtCompileTime, 1> Vector;
+    const int n = vectors.rows();
+    Vector w(n), row(n);
+    for (int i = 0; i < n; dst += n - i, ++i) {
+        w = vectors.row(i).transpose().cwiseProduct(f);
+        row.head(n - i).noalias() = vectors.bottomRows(n - i) * w;
+        convertElements(row.data(), n - i, dst);
+    }
+}
+
+/**
+ * \brief Evaluate V f(L) V^T from the eigendecomposition of a packed matrix,
+ * computed by SymmetricEigenSolver
+ */
+template<typename ComputeScalar, int Dimension>
+struct MatrixFunction {
+    template<typename Scalar, typename Op>
+    static void
+    run(const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& mat,
+        const Op& op, Scalar* dst) {
+        SymmetricEigenSolver<Scalar, ComputeScalar> solver(mat);
+        packedSpectralProduct(solver.eigenvectors(),
+                              solver.eigenvalues().unaryExpr(op).eval(), dst);
+    }
+};
+
+/**
+ * \brief Evaluate V f(L) V^T from the closed-form eigendecomposition of a
+ * packed matrix of dimension 2 or 3
+ *
+ * A single matrix uses Eigen::SelfAdjointEigenSolver::computeDirect() on the
+ * expanded matrix, which branches instead of evaluating the selects of
+ * EigenDirectKernel, and is cheaper when there is only one lane.
+ */
+template<typename ComputeScalar, int Dimension>
+struct DirectMatrixFunction {
+    template<typename Scalar, typename Op>
+    static void
+    run(const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& mat,
+        const Op& op, Scalar* dst) {
+        typedef Eigen::Matrix<ComputeScalar, Dimension, Dimension> Matrix;
+        Matrix dense;
+        const Scalar* a = mat.data();
+        for (int i = 0; i < Dimension; ++i) {
+            for (int j = i; j < Dimension; ++j, ++a) {
+                dense(i, j) = dense(j, i) = static_cast<ComputeScalar>(*a);
+            }
+        }
+        Eigen::SelfAdjointEigenSolver<Matrix> solver;
+        solver.computeDirect(dense);
+        const Matrix& v = solver.eigenvectors();
+        const Eigen::Matrix<ComputeScalar, Dimension, 1> f
+            = solver.eigenvalues().unaryExpr(op);
+        for (int i = 0; i < Dimension; ++i) {
+            for (int j = i; j < Dimension; ++j, ++dst) {
+                *dst = static_cast<Scalar>(
+                    v.row(i).cwiseProduct(f.transpose()).dot(v.row(j)));
+            }
+        }
+    }
+};
+
+template<typename ComputeScalar>
+struct MatrixFunction<ComputeScalar, 2>
+    : DirectMatrixFunction<ComputeScalar, 2> {};
+
+template<typename ComputeScalar>
+struct MatrixFunction<ComputeScalar, 3>
+    : DirectMatrixFunction<ComputeScalar, 3> {};
+
+}  // namespace symmat_internal
+
+template<typename Scalar, int Dimension, typename ComputeScalar>
+SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+SymmetricMatrix<Scalar, Dimension, ComputeScalar>::sqrt() const {
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret;
+    symmat_internal::MatrixFunction<ComputeScalar, Dimension>::run(*this,
+        Eigen::internal::scalar_sqrt_op<ComputeScalar>(), ret.data());
+    return ret;
+}
+
+template<typename Scalar, int Dimension, typename ComputeScalar>
+SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+SymmetricMatrix<Scalar, Dimension, ComputeScalar>::inverseSqrt() const {
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret;
+    symmat_internal::MatrixFunction<ComputeScalar, Dimension>::run(*this,
+        Eigen::internal::scalar_rsqrt_op<ComputeScalar>(), ret.data());
+    return ret;
+}
+
+template<typename Scalar, int Dimension, typename ComputeScalar>
+SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+SymmetricMatrix<Scalar, Dimension, ComputeScalar>::exp() const {
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret;
+    symmat_internal::MatrixFunction<ComputeScalar, Dimension>::run(*this,
+        Eigen::internal::scalar_exp_op<ComputeScalar>(), ret.data());
+    return ret;
+}
+
+template<typename Scalar, int Dimension, typename ComputeScalar>
+SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+SymmetricMatrix<Scalar, Dimension, ComputeScalar>::log() const {
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret;
+    symmat_internal::MatrixFunction<ComputeScalar, Dimension>::run(*this,
+        Eigen::internal::scalar_log_op<ComputeScalar>(), ret.data());
+    return ret;
+}
+
+template<typename Scalar, typename ComputeScalar>
+SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>::sqrt() const {
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> ret(*this);
+    symmat_internal::MatrixFunction<ComputeScalar, Eigen::Dynamic>::run(*this,
+        Eigen::internal::scalar_sqrt_op<ComputeScalar>(), ret.data());
+    return ret;
+}
+
+template<typename Scalar, typename ComputeScalar>
+SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>::inverseSqrt() const {
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> ret(*this);
+    symmat_internal::MatrixFunction<ComputeScalar, Eigen::Dynamic>::run(*this,
+        Eigen::internal::scalar_rsqrt_op<ComputeScalar>(), ret.data());
+    return ret;
+}
+
+template<typename Scalar, typename ComputeScalar>
+SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>::exp() const {
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> ret(*this);
+    symmat_internal::MatrixFunction<ComputeScalar, Eigen::Dynamic>::run(*this,
+        Eigen::internal::scalar_exp_op<ComputeScalar>(), ret.data());
+    return ret;
+}
+
+template<typename Scalar, typename ComputeScalar>
+SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>
+SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>::log() const {
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> ret(*this);
+    symmat_internal::MatrixFunction<ComputeScalar, Eigen::Dynamic>::run(*this,
+        Eigen::internal::scalar_log_op<ComputeScalar>(), ret.data());
+    return ret;
+}
+
+#endif /* GSOC_SYMMAT_DECOMPOSITION_H */
@@ -0,0 +1,825 @@
+#ifndef GSOC_SYMMAT_KALMAN_H
+#define GSOC_SYMMAT_KALMAN_H
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <vector>
+#include "SymmetricMatrix.h"
+#include "SymmetricMatrixBatch.h"
+
+/**
+ * \brief Formulas for the updated covariance of KalmanUpdate
+ *
+ * StandardForm computes C' = C - K H C. JosephForm computes
+ * C' = (I - K H) C (I - K H)^T + K V K^T, which costs more operations but
+ * keeps C' positive semi-definite in the presence of rounding errors.
+ */
+enum KalmanUpdateForm {
+    StandardForm,
+    JosephForm
+};
+
+namespace symmat_internal {
+
+/**
+ * \brief Kalman filter prediction x = F x, C = F C F^T + Q for any lane type
+ * \param f Transport Jacobian F, stored row by row
+ * \param q Packed process noise Q
+ * \param x State, overwritten by the predicted state
+ * \param c Packed covariance, overwritten by the predicted covariance
+ */
+template<int StateDim, typename T>
+inline void
+kalmanPredictKernel(const T* f, const T* q, T* x, T* c) {
+    enum { PackedSize = (StateDim * StateDim + StateDim) / 2 };
+    T fx[StateDim];
+    for (int i = 0; i < StateDim; ++i) {
+        T sum = f[i * StateDim] * x[0];
+        for (int k = 1; k < StateDim; ++k) {
+            sum += f[i * StateDim + k] * x[k];
+        }
+        fx[i] = sum;
+    }
+    for (int i = 0; i < StateDim; ++i) {
+        x[i] = fx[i];
+    }
+    T fcf[PackedSize];
+    fixedSimilarity<StateDim>(f, c, fcf);
+    for (int k = 0; k < PackedSize; ++k) {
+        c[k] = fcf[k] + q[k];
+    }
+}
+
+/**
+ * \brief Kalman filter measurement update for any lane type
+ *
+ * See KalmanUpdate for the formulas.
+ *
+ * \param c Packed predicted covariance C
+ * \param x Predicted state x
+ * \param h Projection H, stored row by row
+ * \param v Packed measurement covariance V
+ * \param m Measurement m
+ * \param form Formula for the updated covariance
+ * \param cOut Packed updated covariance
+ * \param xOut Updated state
+ * \param kt Transposed gain K^T, stored row by row
+ * \param chi2 Chi-square of the residual
+ * \return Smallest pivot of the Cholesky factorization of S, i.e., the
+ * results are only valid if it is positive
+ */
+template<int StateDim, int MeasDim, typename T>
+inline T
+kalmanUpdateKernel(const T* c, const T* x, const T* h, const T* v,
+                   const T* m, KalmanUpdateForm form, T* cOut, T* xOut,
+                   T* kt, T& chi2) {
+    typedef LaneTraits<T> Lane;
+
+    // HC = H C
+    T hc[MeasDim][StateDim];
+    for (int a = 0; a < MeasDim; ++a) {
+        for (int j = 0; j < StateDim; ++j) {
+            T sum = h[a * StateDim] * c[fixedIndex<StateDim>(0, j)];
+            for (int k = 1; k < StateDim; ++k) {
+                sum += h[a * StateDim + k] * c[fixedIndex<StateDim>(k, j)];
+            }
+            hc[a][j] = sum;
+        }
+    }
+
+    // S = HC H^T + V, then S = U^T U
+    T u[(MeasDim * MeasDim + MeasDim) / 2];
+    for (int a = 0; a < MeasDim; ++a) {
+        for (int b = a; b < MeasDim; ++b) {
+            T sum = v[fixedIndex<MeasDim>(a, b)];
+            for (int k = 0; k < StateDim; ++k) {
+                sum += hc[a][k] * h[b * StateDim + k];
+            }
+            u[fixedIndex<MeasDim>(a, b)] = sum;
+        }
+    }
+    T minPivot = fixedCholesky<MeasDim>(u);
+
+    // K^T = S^-1 HC, solved for all columns at once
+    T ktRows[MeasDim][StateDim];
+    for (int a = 0; a < MeasDim; ++a) {
+        for (int j = 0; j < StateDim; ++j) {
+            ktRows[a][j] = hc[a][j];
+        }
+    }
+    fixedSolveColumns<MeasDim, StateDim>(u, ktRows);
+    for (int a = 0; a < MeasDim; ++a) {
+        for (int j = 0; j < StateDim; ++j) {
+            kt[a * StateDim + j] = ktRows[a][j];
+        }
+    }
+
+    // r = m - H x, chi2 = |U^-T r|^2, x' = x + K r
+    T r[MeasDim];
+    T w[MeasDim];
+    for (int a = 0; a < MeasDim; ++a) {
+        T sum = m[a];
+        for (int k = 0; k < StateDim; ++k) {
+            sum -= h[a * StateDim + k] * x[k];
+        }
+        r[a] = sum;
+        w[a] = sum;
+    }
+    fixedForwardSolve<MeasDim>(u, w);
+    chi2 = w[0] * w[0];
+    for (int a = 1; a < MeasDim; ++a) {
+        chi2 += w[a] * w[a];
+    }
+    for (int i = 0; i < StateDim; ++i) {
+        T sum = x[i];
+        for (int a = 0; a < MeasDim; ++a) {
+            sum += kt[a * StateDim + i] * r[a];
+        }
+        xOut[i] = sum;
+    }
+
+    if (form == StandardForm) {
+        // C' = C - K HC
+        for (int i = 0; i < StateDim; ++i) {
+            for (int j = i; j < StateDim; ++j) {
+                T sum = c[fixedIndex<StateDim>(i, j)];
+                for (int a = 0; a < MeasDim; ++a) {
+                    sum -= kt[a * StateDim + i] * hc[a][j];
+                }
+                cOut[fixedIndex<StateDim>(i, j)] = sum;
+            }
+        }
+        return minPivot;
+    }
+
+    // A = I - K H
+    T A[StateDim * StateDim];
+    for (int i = 0; i < StateDim; ++i) {
+        for (int k = 0; k < StateDim; ++k) {
+            T sum = Lane::constant((i == k) ? 1 : 0);
+            for (int a = 0; a < MeasDim; ++a) {
+                sum -= kt[a * StateDim + i] * h[a * StateDim + k];
+            }
+            A[i * StateDim + k] = sum;
+        }
+    }
+    // KV = K V
+    T kv[StateDim][MeasDim];
+    for (int i = 0; i < StateDim; ++i) {
+        for (int b = 0; b < MeasDim; ++b) {
+            T sum = kt[i] * v[fixedIndex<MeasDim>(0, b)];
+            for (int a = 1; a < MeasDim; ++a) {
+                sum += kt[a * StateDim + i] * v[fixedIndex<MeasDim>(a, b)];
+            }
+            kv[i][b] = sum;
+        }
+    }
+    // C' = A C A^T + KV K^T
+    fixedSimilarity<StateDim>(A, c, cOut);
+    for (int i = 0; i < StateDim; ++i) {
+        for (int j = i; j < StateDim; ++j) {
+            T sum = cOut[fixedIndex<StateDim>(i, j)];
+            for (int b = 0; b < MeasDim; ++b) {
+                sum += kv[i][b] * kt[b * StateDim + j];
+            }
+            cOut[fixedIndex<StateDim>(i, j)] = sum;
+        }
+    }
+    return minPivot;
+}
+
+/**
+ * \brief Weighted mean of two Gaussian estimates for any lane type
+ *
+ * With S = C1 + C2 = U^T U and W = U^-T C1 the combination is
+ *
+ *      C = (C1^-1 + C2^-1)^-1 = C1 - C1 S^-1 C1 = C1 - W^T W
+ *      x = x1 + C1 S^-1 (x2 - x1) = x1 + W^T U^-T (x2 - x1)
+ *
+ * so only S is factorized and neither C1 nor C2 is inverted.
+ *
+ * \param c1 Packed covariance of the first estimate
+ * \param x1 First estimate
+ * \param c2 Packed covariance of the second estimate
+ * \param x2 Second estimate
+ * \param cOut Packed combined covariance
+ * \param xOut Combined estimate
+ * \param chi2 Compatibility (x2 - x1)^T S^-1 (x2 - x1) of both estimates
+ * \return Smallest pivot of the factorization of S
+ */
+template<int Dim, typename T>
+inline T
+kalmanCombineKernel(const T* c1, const T* x1, const T* c2, const T* x2,
+                    T* cOut, T* xOut, T& chi2) {
+    enum { PackedSize = (Dim * Dim + Dim) / 2 };
+
+    // U^T U = C1 + C2
+    T u[PackedSize];
+    for (int k = 0; k < PackedSize; ++k) {
+        u[k] = c1[k] + c2[k];
+    }
+    T minPivot = fixedCholesky<Dim>(u);
+
+    // W = U^-T C1, solved column by column
+    T w[Dim][Dim];
+    for (int j = 0; j < Dim; ++j) {
+        T col[Dim];
+        for (int i = 0; i < Dim; ++i) {
+            col[i] = c1[fixedIndex<Dim>(i, j)];
+        }
+        fixedForwardSolve<Dim>(u, col);
+        for (int i = 0; i < Dim; ++i) {
+            w[i][j] = col[i];
+        }
+    }
+
+    // y = U^-T (x2 - x1)
+    T y[Dim];
+    for (int i = 0; i < Dim; ++i) {
+        y[i] = x2[i] - x1[i];
+    }
+    fixedForwardSolve<Dim>(u, y);
+    chi2 = y[0] * y[0];
+    for (int i = 1; i < Dim; ++i) {
+        chi2 += y[i] * y[i];
+    }
+
+    // x = x1 + W^T y
+    for (int j = 0; j < Dim; ++j) {
+        T sum = x1[j];
+        for (int i = 0; i < Dim; ++i) {
+            sum += w[i][j] * y[i];
+        }
+        xOut[j] = sum;
+    }
+
+    // C = C1 - W^T W, upper triangular part only
+    for (int i = 0; i < Dim; ++i) {
+        for (int j = i; j < Dim; ++j) {
+            T sum = c1[fixedIndex<Dim>(i, j)];
+            for (int k = 0; k < Dim; ++k) {
+                sum -= w[k][i] * w[k][j];
+            }
+            cOut[fixedIndex<Dim>(i, j)] = sum;
+        }
+    }
+    return minPivot;
+}
+
+}  // namespace symmat_internal
+
+/**
+ * \class KalmanUpdate<typename Scalar, int StateDim, int MeasDim>
+ * \brief Measurement update of a Kalman filter on packed covariances
+ *
+ * Given the predicted state x with covariance C, a measurement m with
+ * covariance V and the projection H from state to measurement space,
+ * compute() calculates
+ *
+ *      r  = m - H x                    (residual)
+ *      S  = H C H^T + V                (residual covariance)
+ *      K  = C H^T S^-1                 (gain)
+ *      x' = x + K r                    (updated state)
+ *      C' = C - K H C                  (updated covariance)
+ *      chi2 = r^T S^-1 r
+ *
+ * C, V and C' stay in packed storage. All intermediate results are small
+ * arrays on the stack whose dimensions are known at compile-time, so the
+ * compiler can unroll every loop. S is inverted via a Cholesky factorization
+ * in packed storage. If S is not positive definite, info() returns
+ * Eigen::NumericalIssue and the results are undefined.
+ *
+ * To update many tracks at once use BatchKalmanFilter, which runs the same
+ * kernel with one track per SIMD lane.
+ *
+ * Typical usage in a track fit is StateDim = 5 and MeasDim = 1 or 2.
+ */
+template<typename Scalar, int StateDim = 5, int MeasDim = 2>
+class KalmanUpdate {
+ public:
+    typedef Eigen::Matrix<Scalar, StateDim, 1> StateVector;
+    typedef Eigen::Matrix<Scalar, MeasDim, 1> MeasurementVector;
+    typedef Eigen::Matrix<Scalar, MeasDim, StateDim> ProjectionMatrix;
+    typedef Eigen::Matrix<Scalar, StateDim, MeasDim> GainMatrix;
+    typedef SymmetricMatrix<Scalar, StateDim> StateCovariance;
+    typedef SymmetricMatrix<Scalar, MeasDim> MeasurementCovariance;
+
+    /**
+     * \brief Construct an empty update, info() is Eigen::InvalidInput until
+     * compute() is called
+     */
+    KalmanUpdate() : chiSquare(0), status(Eigen::InvalidInput) {}
+
+    /**
+     * \brief Construct and compute the update
+     * \see compute()
+     */
+    KalmanUpdate(const StateCovariance& C, const StateVector& x,
+                 const ProjectionMatrix& H, const MeasurementCovariance& V,
+                 const MeasurementVector& m, KalmanUpdateForm form
+                 = StandardForm) {
+        compute(C, x, H, V, m, form);
+    }
+
+    /**
+     * \brief Compute the measurement update
+     * \param C Predicted covariance
+     * \param x Predicted state
+     * \param H Projection from state to measurement space
+     * \param V Covariance of the measurement
+     * \param m Measurement
+     * \param form Formula for the updated covariance
+     * \return Reference to the current instance
+     */
+    KalmanUpdate&
+    compute(const StateCovariance& C, const StateVector& x,
+            const ProjectionMatrix& H, const MeasurementCovariance& V,
+            const MeasurementVector& m, KalmanUpdateForm form = StandardForm) {
+        Scalar h[MeasDim * StateDim];
+        for (int a = 0; a < MeasDim; ++a) {
+            for (int k = 0; k < StateDim; ++k) {
+                h[a * StateDim + k] = H(a, k);
+            }
+        }
+        Scalar kt[MeasDim * StateDim];
+        Scalar minPivot = symmat_internal::kalmanUpdateKernel<StateDim,
+                                                              MeasDim>(
+            C.data(), x.data(), h, V.data(), m.data(), form,
+            updatedCovariance.data(), updatedState.data(), kt, chiSquare);
+        status = (minPivot > Scalar(0)) ? Eigen::Success
+                                        : Eigen::NumericalIssue;
+        for (int a = 0; a < MeasDim; ++a) {
+            for (int j = 0; j < StateDim; ++j) {
+                gainMatrix(j, a) = kt[a * StateDim + j];
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * \brief Kalman gain K = C H^T S^-1
+     */
+    const GainMatrix& gain() const {
+        return gainMatrix;
+    }
+
+    /**
+     * \brief Updated state x' = x + K r
+     */
+    const StateVector& state() const {
+        return updatedState;
+    }
+
+    /**
+     * \brief Updated covariance in packed storage
+     */
+    const StateCovariance& covariance() const {
+        return updatedCovariance;
+    }
+
+    /**
+     * \brief Chi-square r^T S^-1 r of the residual
+     */
+    Scalar chi2() const {
+        return chiSquare;
+    }
+
+    /**
+     * \brief Eigen::Success if the residual covariance S is positive
+     * definite, Eigen::NumericalIssue otherwise and Eigen::InvalidInput if
+     * compute() was not called
+     */
+    Eigen::ComputationInfo info() const {
+        return status;
+    }
+
+ private:
+    GainMatrix gainMatrix;
+    StateVector updatedState;
+    StateCovariance updatedCovariance;
+    Scalar chiSquare;
+    Eigen::ComputationInfo status;
+};
+
+/**
+ * \class KalmanCombination<typename Scalar, int Dimension>
+ * \brief Weighted mean of two Gaussian estimates on packed covariances
+ *
+ * Combines two independent estimates x1, x2 of the same state with
+ * covariances C1, C2, e.g., the forward and backward fit of a smoother:
+ *
+ *      C = (C1^-1 + C2^-1)^-1
+ *      x = C (C1^-1 x1 + C2^-1 x2)
+ *      chi2 = (x2 - x1)^T (C1 + C2)^-1 (x2 - x1)
+ *
+ * Instead of the two inverses only C1 + C2 is factorized in packed storage.
+ * All intermediate results are small arrays on the stack whose dimensions
+ * are known at compile-time, so every loop is unrolled for the common
+ * dimensions 5 and 6. If C1 + C2 is not positive definite, info() returns
+ * Eigen::NumericalIssue and the results are undefined.
+ *
+ * \see combine()
+ */
+template<typename Scalar, int Dimension = 5>
+class KalmanCombination {
+ public:
+    typedef Eigen::Matrix<Scalar, Dimension, 1> StateVector;
+    typedef SymmetricMatrix<Scalar, Dimension> StateCovariance;
+
+    /**
+     * \brief Construct an empty combination, info() is Eigen::InvalidInput
+     * until compute() is called
+     */
+    KalmanCombination() : chiSquare(0), status(Eigen::InvalidInput) {}
+
+    /**
+     * \brief Construct and compute the combination
+     * \see compute()
+     */
+    KalmanCombination(const StateCovariance& C1, const StateVector& x1,
+                      const StateCovariance& C2, const StateVector& x2) {
+        compute(C1, x1, C2, x2);
+    }
+
+    /**
+     * \brief Compute the weighted mean of two estimates
+     * \param C1 Covariance of the first estimate
+     * \param x1 First estimate
+     * \param C2 Covariance of the second estimate
+     * \param x2 Second estimate
+     * \return Reference to the current instance
+     */
+    KalmanCombination&
+    compute(const StateCovariance& C1, const StateVector& x1,
+            const StateCovariance& C2, const StateVector& x2) {
+        Scalar minPivot = symmat_internal::kalmanCombineKernel<Dimension>(
+            C1.data(), x1.data(), C2.data(), x2.data(),
+            combinedCovariance.data(), combinedState.data(), chiSquare);
+        status = (minPivot > Scalar(0)) ? Eigen::Success
+                                        : Eigen::NumericalIssue;
+        return *this;
+    }
+
+    /**
+     * \brief Combined state
+     */
+    const StateVector& state() const {
+        return combinedState;
+    }
+
+    /**
+     * \brief Combined covariance in packed storage
+     */
+    const StateCovariance& covariance() const {
+        return combinedCovariance;
+    }
+
+    /**
+     * \brief Chi-square of the difference of both estimates
+     */
+    Scalar chi2() const {
+        return chiSquare;
+    }
+
+    /**
+     * \brief Eigen::Success if C1 + C2 is positive definite,
+     * Eigen::NumericalIssue otherwise and Eigen::InvalidInput if compute()
+     * was not called
+     */
+    Eigen::ComputationInfo info() const {
+        return status;
+    }
+
+ private:
+    StateVector combinedState;
+    StateCovariance combinedCovariance;
+    Scalar chiSquare;
+    Eigen::ComputationInfo status;
+};
+
+/**
+ * \brief Weighted mean of two Gaussian estimates
+ * \param C1 Covariance of the first estimate
+ * \param x1 First estimate
+ * \param C2 Covariance of the second estimate
+ * \param x2 Second estimate
+ * \return Combined state, covariance and chi-square
+ */
+template<typename Scalar, int Dimension>
+KalmanCombination<Scalar, Dimension>
+combine(const SymmetricMatrix<Scalar, Dimension>& C1,
+        const Eigen::Matrix<Scalar, Dimension, 1>& x1,
+        const SymmetricMatrix<Scalar, Dimension>& C2,
+        const Eigen::Matrix<Scalar, Dimension, 1>& x2) {
+    return KalmanCombination<Scalar, Dimension>(C1, x1, C2, x2);
+}
+
+/**
+ * \brief Propagate a packed covariance through a chain of Jacobians
+ *
+ * Computes C' = J_k ... J_1 C J_1^T ... J_k^T for the Jacobians J_1, ..., J_k
+ * in [first, last), e.g., for the extrapolation through several material
+ * layers. The chain J = J_k ... J_1 is always formed first and C' = J C J^T
+ * is computed once: for square Jacobians this costs
+ * (k - 1) n^3 + n^3 + n^2 (n + 1) / 2 multiplications, which never exceeds
+ * the k (n^3 + n^2 (n + 1) / 2) of applying the similarity transforms step by
+ * step. The covariance is kept in packed storage on the stack and only the
+ * upper triangular part of the result is computed, so no dense temporaries
+ * of dynamic size are created. All products are accumulated in
+ * ComputeScalar.
+ *
+ * \param C Covariance to propagate
+ * \param first Iterator to J_1
+ * \param last Iterator past J_k
+ * \return Propagated covariance
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar,
+         typename JacobianIterator>
+SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+propagate(const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& C,
+          JacobianIterator first, JacobianIterator last) {
+    typedef Eigen::Matrix<ComputeScalar, Dimension, Dimension,
+                          Eigen::RowMajor> Jacobian;
+    enum { PackedSize = (Dimension * Dimension + Dimension) / 2 };
+
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar> ret(C);
+    if (first == last) {
+        return ret;
+    }
+    Jacobian J = (*first).template cast<ComputeScalar>();
+    for (++first; first != last; ++first) {
+        J = (*first).template cast<ComputeScalar>() * J;
+    }
+    ComputeScalar src[PackedSize], dst[PackedSize];
+    symmat_internal::convertElements(C.data(), PackedSize, src);
+    symmat_internal::fixedSimilarity<Dimension>(J.data(), src, dst);
+    symmat_internal::convertElements(dst, PackedSize, ret.data());
+    return ret;
+}
+
+/**
+ * \brief Propagate a packed covariance through a chain of Jacobians
+ * \param C Covariance to propagate
+ * \param jacobians J_1, ..., J_k in the order they are applied
+ * \return Propagated covariance J_k ... J_1 C J_1^T ... J_k^T
+ * \see propagate(const SymmetricMatrix&, JacobianIterator, JacobianIterator)
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar,
+         typename JacobianScalar, typename Allocator>
+SymmetricMatrix<Scalar, Dimension, ComputeScalar>
+propagate(const SymmetricMatrix<Scalar, Dimension, ComputeScalar>& C,
+          const std::vector<Eigen::Matrix<JacobianScalar, Dimension,
+                                          Dimension>, Allocator>& jacobians) {
+    return propagate(C, jacobians.begin(), jacobians.end());
+}
+
+/**
+ * \class BatchKalmanFilter<typename Scalar, int StateDim, int MeasDim,
+ * typename ComputeScalar>
+ * \brief Kalman filter that predicts and updates many tracks at once
+ *
+ * States, covariances and all per-track inputs are stored as structure of
+ * arrays: row k of each batch contains the k-th (packed) element of every
+ * track. predict() and update() run the kernels of KalmanUpdate on blocks of
+ * consecutive tracks, where each SIMD lane processes one track. The block
+ * width is the packet size of Eigen for ComputeScalar, so compiling with,
+ * e.g., -mavx2 processes 4 tracks of doubles or 8 tracks of floats at once.
+ * Remaining tracks are processed one by one.
+ *
+ * All batches store elements of type Scalar while the kernels compute in
+ * ComputeScalar. BatchKalmanFilter<float, 5, 2, double> therefore moves half
+ * the bytes of a filter on doubles but accumulates in double precision.
+ *
+ * Tracks whose residual covariance is not positive definite keep their
+ * predicted state and covariance and are marked by info().
+ */
+template<typename Scalar, int StateDim = 5, int MeasDim = 2,
+         typename ComputeScalar = Scalar>
+class BatchKalmanFilter {
+ public:
+    typedef SymmetricMatrixBatch<Scalar, StateDim, ComputeScalar>
+        CovarianceBatch;
+    typedef SymmetricMatrixBatch<Scalar, MeasDim, ComputeScalar>
+        MeasurementCovarianceBatch;
+    typedef Eigen::Array<Scalar, StateDim, Eigen::Dynamic, Eigen::RowMajor>
+        StateBatch;
+    typedef Eigen::Array<Scalar, MeasDim, Eigen::Dynamic, Eigen::RowMajor>
+        MeasurementBatch;
+    /** Element (r, c) of the Jacobian of a track is stored in row
+     *  r * StateDim + c */
+    typedef Eigen::Array<Scalar, StateDim * StateDim, Eigen::Dynamic,
+                         Eigen::RowMajor> JacobianBatch;
+    /** Element (a, k) of the projection of a track is stored in row
+     *  a * StateDim + k */
+    typedef Eigen::Array<Scalar, MeasDim * StateDim, Eigen::Dynamic,
+                         Eigen::RowMajor> ProjectionBatch;
+    typedef Eigen::Matrix<Scalar, StateDim, 1> StateVector;
+
+    /**
+     * \brief Construct a filter for count tracks with uninitialized states
+     * \param count Number of tracks
+     */
+    explicit BatchKalmanFilter(size_t count)
+    : x(StateDim, count), C(count), chiSquare(count),
+      status(count, Eigen::Success) {
+        chiSquare.setZero();
+    }
+
+    /**
+     * \brief Number of tracks
+     */
+    size_t size() const {
+        return C.size();
+    }
+
+    /**
+     * \brief Set state and covariance of the i-th track
+     */
+    void setTrack(size_t i, const StateVector& state,
+                  const SymmetricMatrix<Scalar, StateDim, ComputeScalar>&
+                  covariance) {
+        x.col(i) = state;
+        C.set(i, covariance);
+    }
+
+    /**
+     * \brief State of the i-th track
+     */
+    StateVector state(size_t i) const {
+        return x.col(i);
+    }
+
+    /**
+     * \brief Covariance of the i-th track
+     */
+    SymmetricMatrix<Scalar, StateDim, ComputeScalar>
+    covariance(size_t i) const {
+        return C.get(i);
+    }
+
+    /**
+     * \brief States of all tracks, one row per component
+     */
+    StateBatch& states() {
+        return x;
+    }
+
+    /**
+     * \brief Covariances of all tracks
+     */
+    CovarianceBatch& covariances() {
+        return C;
+    }
+
+    /**
+     * \brief Predict all tracks: x = F x, C = F C F^T + Q
+     * \param F Transport Jacobians
+     * \param Q Process noise
+     */
+    void predict(const JacobianBatch& F, const CovarianceBatch& Q) {
+        eigen_assert(static_cast<size_t>(F.cols()) == size()
+            && Q.size() == size()
+            && "Batch sizes do not match the number of tracks");
+        const size_t width = Packet::SizeAtCompileTime;
+        size_t t = 0;
+        for (; t + width <= size(); t += width) {
+            predictBlock<Packet>(t, F, Q);
+        }
+        for (; t < size(); ++t) {
+            predictBlock<ComputeScalar>(t, F, Q);
+        }
+    }
+
+    /**
+     * \brief Update all tracks with one measurement each
+     * \param H Projections from state to measurement space
+     * \param V Measurement covariances
+     * \param m Measurements
+     * \param form Formula for the updated covariances
+     */
+    void update(const ProjectionBatch& H, const MeasurementCovarianceBatch& V,
+                const MeasurementBatch& m,
+                KalmanUpdateForm form = StandardForm) {
+        eigen_assert(static_cast<size_t>(H.cols()) == size()
+            && V.size() == size()
+            && static_cast<size_t>(m.cols()) == size()
+            && "Batch sizes do not match the number of tracks");
+        const size_t width = Packet::SizeAtCompileTime;
+        size_t t = 0;
+        for (; t + width <= size(); t += width) {
+            updateBlock<Packet>(t, H, V, m, form);
+        }
+        for (; t < size(); ++t) {
+            updateBlock<ComputeScalar>(t, H, V, m, form);
+        }
+    }
+
+    /**
+     * \brief Chi-square of the last update of every track
+     */
+    const Eigen::Array<Scalar, Eigen::Dynamic, 1>& chi2() const {
+        return chiSquare;
+    }
+
+    /**
+     * \brief Eigen::Success if the last update of the i-th track succeeded,
+     * Eigen::NumericalIssue if its residual covariance was not positive
+     * definite
+     */
+    Eigen::ComputationInfo info(size_t i) const {
+        return status[i];
+    }
+
+ private:
+    typedef Eigen::Array<ComputeScalar,
+        symmat_internal::BatchWidth<ComputeScalar>::value, 1> Packet;
+
+    template<typename T>
+    void predictBlock(size_t t, const JacobianBatch& F,
+                      const CovarianceBatch& Q) {
+        typedef symmat_internal::LaneTraits<T> Lane;
+        enum { PackedSize = CovarianceBatch::PackedSize };
+        T f[StateDim * StateDim], q[PackedSize], xt[StateDim], c[PackedSize];
+        for (int k = 0; k < StateDim * StateDim; ++k) {
+            f[k] = Lane::load(&F(k, t));
+        }
+        for (int k = 0; k < PackedSize; ++k) {
+            q[k] = Lane::load(Q.element(k) + t);
+            c[k] = Lane::load(C.element(k) + t);
+        }
+        for (int k = 0; k < StateDim; ++k) {
+            xt[k] = Lane::load(&x(k, t));
+        }
+        symmat_internal::kalmanPredictKernel<StateDim>(f, q, xt, c);
+        for (int k = 0; k < PackedSize; ++k) {
+            Lane::store(C.element(k) + t, c[k]);
+        }
+        for (int k = 0; k < StateDim; ++k) {
+            Lane::store(&x(k, t), xt[k]);
+        }
+    }
+
+    template<typename T>
+    void updateBlock(size_t t, const ProjectionBatch& H,
+                     const MeasurementCovarianceBatch& V,
+                     const MeasurementBatch& m, KalmanUpdateForm form) {
+        typedef symmat_internal::LaneTraits<T> Lane;
+        enum { PackedSize = CovarianceBatch::PackedSize,
+               MeasPackedSize = MeasurementCovarianceBatch::PackedSize };
+        T c[PackedSize], xt[StateDim], h[MeasDim * StateDim];
+        T v[MeasPackedSize], mt[MeasDim];
+        for (int k = 0; k < PackedSize; ++k) {
+            c[k] = Lane::load(C.element(k) + t);
+        }
+        for (int k = 0; k < StateDim; ++k) {
+            xt[k] = Lane::load(&x(k, t));
+        }
+        for (int k = 0; k < MeasDim * StateDim; ++k) {
+            h[k] = Lane::load(&H(k, t));
+        }
+        for (int k = 0; k < MeasPackedSize; ++k) {
+            v[k] = Lane::load(V.element(k) + t);
+        }
+        for (int k = 0; k < MeasDim; ++k) {
+            mt[k] = Lane::load(&m(k, t));
+        }
+
+        T cOut[PackedSize], xOut[StateDim], kt[MeasDim * StateDim], chi2;
+        T minPivot = symmat_internal::kalmanUpdateKernel<StateDim, MeasDim>(
+            c, xt, h, v, mt, form, cOut, xOut, kt, chi2);
+
+        // Tracks that failed keep their predicted state and covariance. The
+        // selects are only needed if any track failed.
+        typename Lane::Mask ok = (minPivot > Lane::constant(0));
+        if (!Lane::all(ok)) {
+            for (int k = 0; k < PackedSize; ++k) {
+                cOut[k] = Lane::select(ok, cOut[k], c[k]);
+            }
+            for (int k = 0; k < StateDim; ++k) {
+                xOut[k] = Lane::select(ok, xOut[k], xt[k]);
+            }
+            chi2 = Lane::select(ok, chi2, Lane::constant(
+                std::numeric_limits<ComputeScalar>::quiet_NaN()));
+        }
+        for (int k = 0; k < PackedSize; ++k) {
+            Lane::store(C.element(k) + t, cOut[k]);
+        }
+        for (int k = 0; k < StateDim; ++k) {
+            Lane::store(&x(k, t), xOut[k]);
+        }
+        Lane::store(&chiSquare(t), chi2);
+        for (int i = 0; i < Lane::Width; ++i) {
+            status[t + i] = Lane::lane(ok, i) ? Eigen::Success
+                                              : Eigen::NumericalIssue;
+        }
+    }
+
+    StateBatch x;
+    CovarianceBatch C;
+    Eigen::Array<Scalar, Eigen::Dynamic, 1> chiSquare;
+    std::vector<Eigen::ComputationInfo> status;
+};
+
+#endif /* GSOC_SYMMAT_KALMAN_H */
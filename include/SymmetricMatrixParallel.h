@@ -0,0 +1,1016 @@
+#ifndef GSOC_SYMMAT_PARALLEL_H
+#define GSOC_SYMMAT_PARALLEL_H
+
+#include <vector>
+#include <atomic>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include "SymmetricMatrix.h"
+
+namespace symmat_internal {
+
+/**
+ * \brief Number of packed elements that form one tile.
+ *
+ * The packed storage of large symmetric matrices is split into contiguous
+ * tiles of this size. Tiles are the unit of work for merging partial sums and
+ * the unit of locking for concurrent updates.
+ */
+const size_t TileSize = 4096;
+
+/**
+ * \brief Size of a cache line in bytes
+ */
+const size_t CacheLineSize = 64;
+
+/**
+ * \class CacheLineAllocator<typename T>
+ * \brief Allocator that aligns its storage to CacheLineSize.
+ *
+ * Before C++17 std::allocator ignores alignments larger than the one of
+ * std::max_align_t, so containers of cache-line aligned types need this
+ * allocator. Like Eigen's handmade_aligned_malloc() the storage is
+ * over-allocated and the original pointer is stored right before the
+ * aligned one.
+ */
+template<typename T>
+struct CacheLineAllocator {
+    typedef T value_type;
+
+    CacheLineAllocator() {}
+
+    template<typename U>
+    CacheLineAllocator(const CacheLineAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        void* original = ::operator new(n * sizeof(T) + CacheLineSize);
+        void* aligned = reinterpret_cast<void*>(
+            (reinterpret_cast<size_t>(original) & ~(CacheLineSize - 1))
+            + CacheLineSize);
+        *(reinterpret_cast<void**>(aligned) - 1) = original;
+        return static_cast<T*>(aligned);
+    }
+
+    void deallocate(T* ptr, size_t) {
+        ::operator delete(*(reinterpret_cast<void**>(ptr) - 1));
+    }
+};
+
+template<typename T, typename U>
+inline bool
+operator==(const CacheLineAllocator<T>&, const CacheLineAllocator<U>&) {
+    return true;
+}
+
+template<typename T, typename U>
+inline bool
+operator!=(const CacheLineAllocator<T>&, const CacheLineAllocator<U>&) {
+    return false;
+}
+
+/**
+ * \brief Number of tiles needed to cover the packed storage of a symmetric
+ * matrix of dimension dim.
+ */
+inline size_t
+tileCount(size_t dim) {
+    return ((dim * dim + dim) / 2 + TileSize - 1) / TileSize;
+}
+
+/**
+ * \brief Number of worker threads to use if nThreads are requested.
+ */
+inline int
+workerCount(int nThreads) {
+    int hw = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, (hw > 0) ? std::min(nThreads, hw) : nThreads);
+}
+
+/**
+ * \brief Atomically add value to *address.
+ *
+ * Implemented as compare-and-swap loop using the __atomic builtins of GCC and
+ * Clang, which also work for float and double.
+ */
+template<typename Scalar>
+inline void
+atomicAdd(Scalar* address, const Scalar& value) {
+#if defined(__GNUC__)
+    Scalar expected;
+    Scalar desired;
+    __atomic_load(address, &expected, __ATOMIC_RELAXED);
+    do {
+        desired = expected + value;
+    } while (!__atomic_compare_exchange(address, &expected, &desired, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+#else
+    eigen_assert(false && "Atomic updates are not supported by this compiler");
+#endif
+}
+
+}  // namespace symmat_internal
+
+/**
+ * \brief Modes of SymmetricMatrixAccumulator
+ *
+ * DenseAccumulation allocates the complete packed storage for every thread
+ * up front and merges all of it. SparseTouchAccumulation allocates tiles on
+ * first write and only merges the tiles a thread actually touched.
+ */
+enum AccumulationMode {
+    DenseAccumulation,
+    SparseTouchAccumulation
+};
+
+/**
+ * \class SymmetricMatrixAccumulator<typename Scalar>
+ * \brief Per-thread partial sums of a SymmetricMatrix with dynamic dimension
+ *
+ * Every thread adds its contributions to its own partial sum that is obtained
+ * by local(thread), hence no locking is needed while accumulating. The partial
+ * sums are stored in packed tiles and are combined by reduce() in a parallel
+ * tree reduction: In each round the partial sum i + stride is merged into the
+ * partial sum i and the tiles of all merges of a round are shared among the
+ * worker threads.
+ *
+ * In SparseTouchAccumulation mode tiles are allocated on first write. Tiles
+ * only one of both partial sums has touched are moved instead of added, so
+ * threads working on disjoint parts of the matrix cause almost no merge work.
+ */
+template<typename Scalar>
+class SymmetricMatrixAccumulator {
+ public:
+    /**
+     * \class Partial
+     * \brief Partial sum owned by a single thread
+     */
+    class Partial {
+     public:
+        /**
+         * \brief Add value to the element (row, col) and (col, row)
+         * \param row The row index of the element
+         * \param col The column index of the element
+         * \param value The value to add
+         */
+        void add(int row, int col, const Scalar& value) {
+            size_t idx = symmat_internal::packedIndex(row, col, dimension);
+            tile(idx / symmat_internal::TileSize)
+                [idx % symmat_internal::TileSize] += value;
+        }
+
+        /**
+         * \brief Add a dense symmetric block at the given index set.
+         *
+         * The element block(a, b) is added to the element
+         * (indices[a], indices[b]). Only the upper triangular part of block is
+         * read and the indices have to be distinct.
+         *
+         * \param indices Indices of the rows and columns of the block
+         * \param block Symmetric matrix of dimension indices.size()
+         */
+        template<typename Derived>
+        void addBlock(const std::vector<int>& indices,
+                      const Eigen::MatrixBase<Derived>& block) {
+            eigen_assert(block.rows() == indices.size()
+                && block.cols() == indices.size()
+                && "Block dimension does not match the number of indices");
+            for (int a = 0; a < indices.size(); ++a) {
+                for (int b = a; b < indices.size(); ++b) {
+                    add(indices[a], indices[b], block(a, b));
+                }
+            }
+        }
+
+     private:
+        friend class SymmetricMatrixAccumulator<Scalar>;
+
+        Partial(size_t dimension, AccumulationMode mode)
+        : dimension(dimension),
+          tiles(symmat_internal::tileCount(dimension)) {
+            if (mode == DenseAccumulation) {
+                for (size_t t = 0; t < tiles.size(); ++t) {
+                    tile(t);
+                }
+            }
+        }
+
+        /**
+         * \brief Tile t, allocated and set to zero on first access
+         */
+        std::vector<Scalar>& tile(size_t t) {
+            if (tiles[t].empty()) {
+                tiles[t].assign(symmat_internal::TileSize, Scalar(0));
+            }
+            return tiles[t];
+        }
+
+        /**
+         * \brief Merge tile t of other into the current partial sum
+         */
+        void merge(Partial& other, size_t t) {
+            if (other.tiles[t].empty()) {
+                return;
+            }
+            if (tiles[t].empty()) {
+                tiles[t].swap(other.tiles[t]);
+                return;
+            }
+            typedef Eigen::Map<Eigen::Matrix<Scalar, Eigen::Dynamic, 1> > Map;
+            Map(tiles[t].data(), symmat_internal::TileSize)
+                += Map(other.tiles[t].data(), symmat_internal::TileSize);
+            std::vector<Scalar>().swap(other.tiles[t]);
+        }
+
+        size_t dimension;
+        std::vector<std::vector<Scalar> > tiles;
+    };
+
+    /**
+     * \brief Construct an accumulator for nThreads threads
+     * \param dimension Dimension of the accumulated matrix
+     * \param nThreads Number of threads that contribute
+     * \param mode Dense or sparse-touch accumulation
+     */
+    SymmetricMatrixAccumulator(size_t dimension, int nThreads,
+                               AccumulationMode mode = DenseAccumulation)
+    : dimension(dimension) {
+        eigen_assert(nThreads > 0
+            && "SymmetricMatrixAccumulator needs at least one thread");
+        partials.reserve(nThreads);
+        for (int i = 0; i < nThreads; ++i) {
+            partials.push_back(Partial(dimension, mode));
+        }
+    }
+
+    /**
+     * \brief Partial sum of the given thread
+     *
+     * Each thread must only use its own partial sum. Partial sums must not be
+     * used while reduce() is running.
+     *
+     * \param thread Index of the thread in [0, number of threads)
+     * \return Reference to the partial sum
+     */
+    Partial& local(int thread) {
+        return partials[thread];
+    }
+
+    /**
+     * \brief Sum up all partial sums using a parallel tree reduction.
+     *
+     * The partial sums are consumed, i.e., afterwards the accumulator behaves
+     * like a newly constructed one in SparseTouchAccumulation mode.
+     *
+     * \return Sum of all contributions
+     */
+    SymmetricMatrix<Scalar> reduce() {
+        const size_t nTiles = symmat_internal::tileCount(dimension);
+        const int nWorkers = symmat_internal::workerCount(partials.size());
+
+        for (size_t stride = 1; stride < partials.size(); stride *= 2) {
+            // Tiles of all merges of this round are distributed round robin
+            // over the workers, so the last rounds still use all threads
+            std::vector<std::thread> workers;
+            for (int w = 0; w < nWorkers; ++w) {
+                workers.push_back(std::thread([this, stride, nTiles,
+                                               nWorkers, w]() {
+                    for (size_t i = 0; i + stride < partials.size();
+                         i += 2 * stride) {
+                        for (size_t t = w; t < nTiles; t += nWorkers) {
+                            partials[i].merge(partials[i + stride], t);
+                        }
+                    }
+                }));
+            }
+            for (size_t w = 0; w < workers.size(); ++w) {
+                workers[w].join();
+            }
+        }
+
+        SymmetricMatrix<Scalar> ret = SymmetricMatrix<Scalar>::Zero(dimension);
+        const size_t size = (dimension * dimension + dimension) / 2;
+        for (size_t t = 0; t < nTiles; ++t) {
+            std::vector<Scalar>& tile = partials[0].tiles[t];
+            if (!tile.empty()) {
+                size_t begin = t * symmat_internal::TileSize;
+                size_t end = std::min(begin + symmat_internal::TileSize, size);
+                std::copy(tile.begin(), tile.begin() + (end - begin),
+                          ret.data() + begin);
+                std::vector<Scalar>().swap(tile);
+            }
+        }
+        return ret;
+    }
+
+ private:
+    size_t dimension;
+    std::vector<Partial> partials;
+};
+
+/**
+ * \brief Modes of SymmetricMatrixScatter
+ *
+ * StripedLockScatter protects each tile of the packed storage by one of a
+ * fixed number of mutexes. AtomicScatter updates every element with an atomic
+ * compare-and-swap and is only available for arithmetic types on compilers
+ * that support the __atomic builtins, otherwise striped locks are used.
+ */
+enum ScatterMode {
+    StripedLockScatter,
+    AtomicScatter
+};
+
+/**
+ * \class SymmetricMatrixScatter<typename Scalar>
+ * \brief Concurrent scatter-add into a shared SymmetricMatrix
+ *
+ * Several threads may call scatterAdd() at the same time to add small dense
+ * symmetric blocks at arbitrary index sets to one shared SymmetricMatrix with
+ * dynamic dimension. Contrary to SymmetricMatrixAccumulator no copy of the
+ * matrix is needed per thread.
+ *
+ * Tile t of the packed storage is protected by the mutex t % nStripes. The
+ * elements of a block are sorted by their packed position so that every
+ * touched tile is locked exactly once per block, hence threads only contend
+ * if they write to the same tile (or tiles sharing a stripe).
+ *
+ * The target matrix must not be read, written or queried otherwise (e.g. by
+ * solve() or chi2()) while a scatter is in flight. Its cached factorization
+ * is discarded once when the scatter interface is constructed, since the
+ * scatters only write through the pointer obtained there.
+ */
+template<typename Scalar>
+class SymmetricMatrixScatter {
+ public:
+    /**
+     * \brief Construct a scatter-add interface for target
+     * \param target Shared matrix the blocks are added to
+     * \param mode Striped locks or atomic updates
+     * \param nStripes Number of mutexes in StripedLockScatter mode
+     */
+    explicit SymmetricMatrixScatter(SymmetricMatrix<Scalar>& target,
+                                    ScatterMode mode = StripedLockScatter,
+                                    int nStripes = 64)
+    : data(target.data()), dimension(target.dim()), stripes(nStripes),
+      mode(mode) {
+        eigen_assert(nStripes > 0
+            && "SymmetricMatrixScatter needs at least one stripe");
+#if !defined(__GNUC__)
+        this->mode = StripedLockScatter;
+#endif
+        if (!std::is_arithmetic<Scalar>::value) {
+            this->mode = StripedLockScatter;
+        }
+    }
+
+    /**
+     * \brief Add a dense symmetric block at the given index set.
+     *
+     * The element block(a, b) is added to the element
+     * (indices[a], indices[b]). Only the upper triangular part of block is
+     * read and the indices have to be distinct.
+     *
+     * \param indices Indices of the rows and columns of the block
+     * \param block Symmetric matrix of dimension indices.size()
+     */
+    template<typename Derived>
+    void scatterAdd(const std::vector<int>& indices,
+                    const Eigen::MatrixBase<Derived>& block) {
+        eigen_assert(block.rows() == indices.size()
+            && block.cols() == indices.size()
+            && "Block dimension does not match the number of indices");
+        if (mode == AtomicScatter) {
+            scatterAtomic(indices, block,
+                          typename std::is_arithmetic<Scalar>::type());
+            return;
+        }
+
+        std::vector<std::pair<size_t, Scalar> > entries;
+        entries.reserve(indices.size() * (indices.size() + 1) / 2);
+        for (int a = 0; a < indices.size(); ++a) {
+            for (int b = a; b < indices.size(); ++b) {
+                entries.push_back(std::make_pair(
+                    symmat_internal::packedIndex(indices[a], indices[b],
+                                                 dimension),
+                    static_cast<Scalar>(block(a, b))));
+            }
+        }
+        std::sort(entries.begin(), entries.end(), lessIndex);
+
+        // Lock the stripe of each touched tile once and apply all elements
+        // that belong to this tile
+        size_t i = 0;
+        while (i < entries.size()) {
+            size_t tile = entries[i].first / symmat_internal::TileSize;
+            std::lock_guard<std::mutex> lock(
+                stripes[tile % stripes.size()].mutex);
+            for (; i < entries.size()
+                   && entries[i].first / symmat_internal::TileSize == tile;
+                 ++i) {
+                data[entries[i].first] += entries[i].second;
+            }
+        }
+    }
+
+ private:
+    /**
+     * \brief Mutex aligned to its own cache line to avoid false sharing
+     */
+    struct alignas(symmat_internal::CacheLineSize) Stripe {
+        std::mutex mutex;
+    };
+
+    template<typename Derived>
+    void scatterAtomic(const std::vector<int>& indices,
+                       const Eigen::MatrixBase<Derived>& block,
+                       std::true_type) {
+        for (int a = 0; a < indices.size(); ++a) {
+            for (int b = a; b < indices.size(); ++b) {
+                symmat_internal::atomicAdd(data
+                    + symmat_internal::packedIndex(indices[a], indices[b],
+                                                   dimension),
+                    static_cast<Scalar>(block(a, b)));
+            }
+        }
+    }
+
+    // Never called since the constructor falls back to StripedLockScatter
+    template<typename Derived>
+    void scatterAtomic(const std::vector<int>&,
+                       const Eigen::MatrixBase<Derived>&, std::false_type) {}
+
+    static bool lessIndex(const std::pair<size_t, Scalar>& lhs,
+                          const std::pair<size_t, Scalar>& rhs) {
+        return lhs.first < rhs.first;
+    }
+
+    Scalar* data;
+    size_t dimension;
+    std::vector<Stripe, symmat_internal::CacheLineAllocator<Stripe> > stripes;
+    ScatterMode mode;
+};
+
+/**
+ * \class SymmetricMatrixThreadPool
+ * \brief Fixed set of worker threads that run submitted tasks in FIFO order
+ *
+ * All asynchronous operations on SymmetricMatrix share the pool returned by
+ * SymmetricMatrixThreadPool::shared(), which has one worker per hardware
+ * thread.
+ */
+class SymmetricMatrixThreadPool {
+ public:
+    /**
+     * \brief Start nThreads worker threads
+     * \param nThreads Number of workers
+     */
+    explicit SymmetricMatrixThreadPool(int nThreads) : stopping(false) {
+        eigen_assert(nThreads > 0
+            && "SymmetricMatrixThreadPool needs at least one thread");
+        for (int i = 0; i < nThreads; ++i) {
+            workers.push_back(std::thread([this]() { work(); }));
+        }
+    }
+
+    /**
+     * \brief Finish all queued tasks and join the workers
+     */
+    ~SymmetricMatrixThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition.notify_all();
+        for (size_t i = 0; i < workers.size(); ++i) {
+            workers[i].join();
+        }
+    }
+
+    /**
+     * \brief Pool that is shared by all asynchronous operations
+     * \return Reference to the shared pool
+     */
+    static SymmetricMatrixThreadPool& shared() {
+        static SymmetricMatrixThreadPool pool(
+            std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+        return pool;
+    }
+
+    /**
+     * \brief Queue a task
+     * \param task Callable without arguments
+     * \return Future that holds the result of task or the exception it threw
+     */
+    template<typename Task>
+    std::future<typename std::result_of<Task()>::type>
+    submit(Task task) {
+        typedef typename std::result_of<Task()>::type Result;
+        std::shared_ptr<std::packaged_task<Result()> > packaged
+            = std::make_shared<std::packaged_task<Result()> >(task);
+        std::future<Result> ret = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push([packaged]() { (*packaged)(); });
+        }
+        condition.notify_one();
+        return ret;
+    }
+
+    /**
+     * \brief Number of workers
+     */
+    size_t size() const {
+        return workers.size();
+    }
+
+ private:
+    void work() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this]() {
+                    return stopping || !queue.empty();
+                });
+                if (queue.empty()) {
+                    return;
+                }
+                task = std::move(queue.front());
+                queue.pop();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()> > queue;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping;
+};
+
+/**
+ * \brief Run an arbitrary task on the shared pool
+ *
+ * Use this to run any composition of SymmetricMatrix operations in the
+ * background. All operands must stay alive until the future is ready, so
+ * prefer capturing them by value.
+ *
+ * \param task Callable without arguments
+ * \return Future that holds the result of task
+ */
+template<typename Task>
+std::future<typename std::result_of<Task()>::type>
+runAsync(Task task) {
+    return SymmetricMatrixThreadPool::shared().submit(task);
+}
+
+namespace symmat_internal {
+
+/**
+ * \brief y = A x for a packed symmetric matrix on the shared thread pool
+ *
+ * The rows are split into ranges with about the same number of packed
+ * elements. The calling thread and nThreads - 1 tasks on
+ * SymmetricMatrixThreadPool::shared() claim ranges until none is left, so the
+ * product also finishes if all workers of the pool are busy, e.g., if it is
+ * called from a task. The first range is accumulated into y and every other
+ * range into its own vector of partials, which are summed up afterwards, so
+ * no locking is needed. Small matrices are split into fewer ranges, since
+ * each range should at least read a few tiles.
+ *
+ * \param a Packed storage of A
+ * \param n Dimension of A
+ * \param x Vector of size n
+ * \param y Vector of size n, overwritten by A x
+ * \param nThreads Maximum number of threads
+ * \param partials Partial vectors, resized as needed, so that callers can
+ * reuse them across products
+ */
+template<typename Scalar, typename ComputeScalar>
+inline void
+packedSymvParallel(const Scalar* a, size_t n, const ComputeScalar* x,
+                   ComputeScalar* y, int nThreads,
+                   std::vector<ComputeScalar>& partials) {
+    const size_t size = (n * n + n) / 2;
+    const int nRanges = std::max(1, std::min(workerCount(nThreads),
+        static_cast<int>(size / (16 * TileSize))));
+    std::fill(y, y + n, ComputeScalar(0));
+    if (nRanges == 1) {
+        packedSymvRows(a, n, x, y, 0, n);
+        return;
+    }
+
+    // Row r * size / nRanges of the packed elements starts the range r
+    std::vector<size_t> rows(nRanges + 1, n);
+    std::vector<size_t> offsets(nRanges + 1, size);
+    rows[0] = offsets[0] = 0;
+    for (size_t i = 0, start = 0, r = 1; i < n && r < size_t(nRanges);
+         start += n - i, ++i) {
+        if (start >= r * size / nRanges) {
+            rows[r] = i;
+            offsets[r] = start;
+            ++r;
+        }
+    }
+    partials.resize((nRanges - 1) * n);
+
+    // Tasks that start after the product is finished find no range left and
+    // only touch the job, which they therefore share
+    struct Job {
+        std::atomic<int> next;
+        int remaining;
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+    std::shared_ptr<Job> job = std::make_shared<Job>();
+    job->next = 0;
+    job->remaining = nRanges;
+    const size_t* rowPtr = rows.data();
+    const size_t* offsetPtr = offsets.data();
+    ComputeScalar* partialPtr = partials.data();
+    std::function<void()> claim = [=]() {
+        for (int r = job->next++; r < nRanges; r = job->next++) {
+            ComputeScalar* z = y;
+            if (r > 0) {
+                z = partialPtr + (r - 1) * n;
+                std::fill(z + rowPtr[r], z + n, ComputeScalar(0));
+            }
+            packedSymvRows(a + offsetPtr[r], n, x, z, rowPtr[r],
+                           rowPtr[r + 1]);
+            std::lock_guard<std::mutex> lock(job->mutex);
+            if (--job->remaining == 0) {
+                job->condition.notify_all();
+            }
+        }
+    };
+    for (int r = 1; r < nRanges; ++r) {
+        SymmetricMatrixThreadPool::shared().submit(claim);
+    }
+    claim();
+    {
+        std::unique_lock<std::mutex> lock(job->mutex);
+        job->condition.wait(lock, [&job]() { return job->remaining == 0; });
+    }
+
+    typedef Eigen::Map<Eigen::Matrix<ComputeScalar, Eigen::Dynamic, 1> > Map;
+    for (int r = 1; r < nRanges; ++r) {
+        Map(y + rows[r], n - rows[r])
+            += Map(partials.data() + (r - 1) * n + rows[r], n - rows[r]);
+    }
+}
+
+/**
+ * \brief Whether T is a SymmetricMatrix
+ */
+template<typename T>
+struct IsSymmetricMatrix : std::false_type {};
+
+template<typename Scalar, int Dimension, typename ComputeScalar>
+struct IsSymmetricMatrix<SymmetricMatrix<Scalar, Dimension, ComputeScalar> >
+    : std::true_type {};
+
+/**
+ * \brief Plain type that addAsync(), subtractAsync() and multiplyAsync()
+ * return for the result type T of the operator.
+ *
+ * Operators with an Eigen operand return lazy expressions that refer to
+ * their operands. Since the operands are copies owned by the task, the
+ * expression is evaluated into its PlainObject inside the task. Other results,
+ * including SymmetricMatrix, are returned as they are.
+ */
+template<typename T, typename Plain = typename std::decay<T>::type,
+         bool Lazy = std::is_base_of<Eigen::EigenBase<Plain>, Plain>::value
+             && !std::is_base_of<Eigen::PlainObjectBase<Plain>, Plain>::value
+             && !IsSymmetricMatrix<Plain>::value>
+struct AsyncResult {
+    typedef Plain type;
+};
+
+template<typename T, typename Plain>
+struct AsyncResult<T, Plain, true> {
+    typedef typename Plain::PlainObject type;
+};
+
+}  // namespace symmat_internal
+
+/**
+ * \brief Compute lhs + rhs on the shared pool
+ *
+ * Both operands are copied, so they can be changed or destroyed while the
+ * operation is running. rhs can be any type operator + of SymmetricMatrix
+ * accepts. Eigen expressions are evaluated on the pool.
+ *
+ * \param lhs Symmetric matrix
+ * \param rhs Matrix to add
+ * \return Future that holds the sum
+ */
+template<typename Scalar, int Dimension, typename Rhs>
+std::future<typename symmat_internal::AsyncResult<
+    decltype(std::declval<SymmetricMatrix<Scalar, Dimension>&>()
+             + std::declval<const Rhs&>())>::type>
+addAsync(const SymmetricMatrix<Scalar, Dimension>& lhs, const Rhs& rhs) {
+    typedef typename symmat_internal::AsyncResult<
+        decltype(std::declval<SymmetricMatrix<Scalar, Dimension>&>()
+                 + std::declval<const Rhs&>())>::type Result;
+    SymmetricMatrix<Scalar, Dimension> lhsCopy(lhs);
+    Rhs rhsCopy(rhs);
+    return runAsync([lhsCopy, rhsCopy]() mutable {
+        return Result(lhsCopy + rhsCopy);
+    });
+}
+
+/**
+ * \brief Compute lhs - rhs on the shared pool
+ *
+ * Both operands are copied, so they can be changed or destroyed while the
+ * operation is running. rhs can be any type operator - of SymmetricMatrix
+ * accepts. Eigen expressions are evaluated on the pool.
+ *
+ * \param lhs Symmetric matrix
+ * \param rhs Matrix to subtract
+ * \return Future that holds the difference
+ */
+template<typename Scalar, int Dimension, typename Rhs>
+std::future<typename symmat_internal::AsyncResult<
+    decltype(std::declval<SymmetricMatrix<Scalar, Dimension>&>()
+             - std::declval<const Rhs&>())>::type>
+subtractAsync(const SymmetricMatrix<Scalar, Dimension>& lhs, const Rhs& rhs) {
+    typedef typename symmat_internal::AsyncResult<
+        decltype(std::declval<SymmetricMatrix<Scalar, Dimension>&>()
+                 - std::declval<const Rhs&>())>::type Result;
+    SymmetricMatrix<Scalar, Dimension> lhsCopy(lhs);
+    Rhs rhsCopy(rhs);
+    return runAsync([lhsCopy, rhsCopy]() mutable {
+        return Result(lhsCopy - rhsCopy);
+    });
+}
+
+/**
+ * \brief Compute lhs * rhs on the shared pool
+ *
+ * Both operands are copied, so they can be changed or destroyed while the
+ * operation is running. rhs can be any type operator * of SymmetricMatrix
+ * accepts. Eigen expressions are evaluated on the pool.
+ *
+ * \param lhs Symmetric matrix
+ * \param rhs Matrix to multiply
+ * \return Future that holds the product
+ */
+template<typename Scalar, int Dimension, typename Rhs>
+std::future<typename symmat_internal::AsyncResult<
+    decltype(std::declval<SymmetricMatrix<Scalar, Dimension>&>()
+             * std::declval<Rhs&>())>::type>
+multiplyAsync(const SymmetricMatrix<Scalar, Dimension>& lhs, const Rhs& rhs) {
+    typedef typename symmat_internal::AsyncResult<
+        decltype(std::declval<SymmetricMatrix<Scalar, Dimension>&>()
+                 * std::declval<Rhs&>())>::type Result;
+    SymmetricMatrix<Scalar, Dimension> lhsCopy(lhs);
+    Rhs rhsCopy(rhs);
+    return runAsync([lhsCopy, rhsCopy]() mutable {
+        return Result(lhsCopy * rhsCopy);
+    });
+}
+
+/**
+ * \brief Compute the Cholesky factorization of mat on the shared pool
+ *
+ * mat is copied, so it can be changed or destroyed while the factorization is
+ * running. Check info() of the result to see if mat is positive definite.
+ *
+ * \param mat Symmetric matrix
+ * \return Future that holds the factorization
+ */
+template<typename Scalar, int Dimension>
+std::future<Eigen::LLT<Eigen::Matrix<Scalar, Dimension, Dimension> > >
+factorizeAsync(const SymmetricMatrix<Scalar, Dimension>& mat) {
+    SymmetricMatrix<Scalar, Dimension> matCopy(mat);
+    return runAsync([matCopy]() mutable {
+        return Eigen::LLT<Eigen::Matrix<Scalar, Dimension, Dimension> >(
+            matCopy.constructEigenMatrix());
+    });
+}
+
+/**
+ * \brief Compute the inverse of mat on the shared pool
+ *
+ * mat is copied, so it can be changed or destroyed while the inversion is
+ * running. Since the inverse of a symmetric matrix is symmetric, the result
+ * is a SymmetricMatrix again.
+ *
+ * \param mat Invertible symmetric matrix
+ * \return Future that holds the inverse
+ */
+template<typename Scalar, int Dimension>
+std::future<SymmetricMatrix<Scalar, Dimension> >
+inverseAsync(const SymmetricMatrix<Scalar, Dimension>& mat) {
+    SymmetricMatrix<Scalar, Dimension> matCopy(mat);
+    return runAsync([matCopy]() mutable {
+        typedef Eigen::Matrix<Scalar, Dimension, Dimension> MatrixType;
+        MatrixType eigenmat = matCopy.constructEigenMatrix();
+        return SymmetricMatrix<Scalar, Dimension>(MatrixType(
+            eigenmat.ldlt().solve(
+                MatrixType::Identity(eigenmat.rows(), eigenmat.cols()))));
+    });
+}
+
+template<typename _Scalar, typename _ComputeScalar>
+class SymmetricMatrixOperator;
+
+namespace Eigen {
+namespace internal {
+
+template<typename _Scalar, typename _ComputeScalar>
+struct traits<SymmetricMatrixOperator<_Scalar, _ComputeScalar> >
+    : public traits<SparseMatrix<_ComputeScalar> > {};
+
+}  // namespace internal
+}  // namespace Eigen
+
+/**
+ * \class SymmetricMatrixOperator<typename _Scalar, typename _ComputeScalar>
+ * \brief Matrix-free operator that lets Eigen's iterative solvers work on a
+ * SymmetricMatrix with dynamic dimension
+ *
+ * Eigen::ConjugateGradient (with UpLo = Eigen::Lower | Eigen::Upper),
+ * Eigen::MINRES and the other iterative solvers only need the product with a
+ * vector, which is evaluated by a multithreaded product on the packed
+ * storage (see symmat_internal::packedSymvParallel()) that runs on
+ * SymmetricMatrixThreadPool::shared(). The matrix is never expanded. Use SymmetricJacobiPreconditioner, which reads the diagonal
+ * directly from packed storage, as preconditioner.
+ *
+ * The operator holds a reference to the matrix, which therefore has to
+ * outlive the operator and every solver that uses it. The solver works in
+ * _ComputeScalar. The buffers of the product are owned by the operator and
+ * reused, so an operator must not be used by several threads at once.
+ */
+template<typename _Scalar, typename _ComputeScalar = _Scalar>
+class SymmetricMatrixOperator
+    : public Eigen::EigenBase<SymmetricMatrixOperator<_Scalar,
+                                                      _ComputeScalar> > {
+ public:
+    typedef _ComputeScalar Scalar;
+    typedef _ComputeScalar RealScalar;
+    typedef int StorageIndex;
+    typedef Eigen::Matrix<_ComputeScalar, Eigen::Dynamic, 1> VectorType;
+    enum {
+        ColsAtCompileTime = Eigen::Dynamic,
+        MaxColsAtCompileTime = Eigen::Dynamic,
+        IsRowMajor = false
+    };
+
+    /**
+     * \brief Wrap a symmetric matrix
+     * \param mat Symmetric matrix with dynamic dimension
+     * \param nThreads Maximum number of threads used by the product
+     */
+    explicit SymmetricMatrixOperator(
+        const SymmetricMatrix<_Scalar, Eigen::Dynamic, _ComputeScalar>& mat,
+        int nThreads = std::max(1, static_cast<int>(
+            std::thread::hardware_concurrency())))
+    : mat(mat), nThreads(nThreads) {}
+
+    Eigen::Index rows() const {
+        return mat.dim();
+    }
+
+    Eigen::Index cols() const {
+        return mat.dim();
+    }
+
+    /**
+     * \brief Lazy product with a vector that is evaluated by Eigen into
+     * multiply()
+     */
+    template<typename Rhs>
+    Eigen::Product<SymmetricMatrixOperator, Rhs, Eigen::AliasFreeProduct>
+    operator*(const Eigen::MatrixBase<Rhs>& x) const {
+        return Eigen::Product<SymmetricMatrixOperator, Rhs,
+                              Eigen::AliasFreeProduct>(*this, x.derived());
+    }
+
+    /**
+     * \brief y = A x
+     * \param x Vector of size dim()
+     * \param y Vector of size dim(), overwritten by A x
+     */
+    void multiply(const VectorType& x, VectorType& y) const {
+        eigen_assert(x.size() == rows()
+            && "Dimensions of matrix and vector do not match");
+        y.resize(rows());
+        symmat_internal::packedSymvParallel(mat.data(), mat.dim(), x.data(),
+                                            y.data(), nThreads, partials);
+    }
+
+    /**
+     * \brief Diagonal of the matrix, read from packed storage
+     */
+    VectorType diagonal() const {
+        VectorType ret(rows());
+        const _Scalar* a = mat.data();
+        for (Eigen::Index i = 0; i < rows(); a += rows() - i, ++i) {
+            ret(i) = static_cast<_ComputeScalar>(a[0]);
+        }
+        return ret;
+    }
+
+    /**
+     * \brief The wrapped matrix
+     */
+    const SymmetricMatrix<_Scalar, Eigen::Dynamic, _ComputeScalar>&
+    matrix() const {
+        return mat;
+    }
+
+ private:
+    const SymmetricMatrix<_Scalar, Eigen::Dynamic, _ComputeScalar>& mat;
+    int nThreads;
+    // Partial vectors of the product, kept to avoid allocating them in every
+    // iteration of a solver
+    mutable std::vector<_ComputeScalar> partials;
+};
+
+namespace Eigen {
+namespace internal {
+
+/**
+ * \brief Evaluation of SymmetricMatrixOperator * vector, which is all Eigen's
+ * iterative solvers need from a matrix-free operator
+ */
+template<typename _Scalar, typename _ComputeScalar, typename Rhs>
+struct generic_product_impl<SymmetricMatrixOperator<_Scalar, _ComputeScalar>,
+                            Rhs, SparseShape, DenseShape, GemvProduct>
+    : generic_product_impl_base<
+          SymmetricMatrixOperator<_Scalar, _ComputeScalar>, Rhs,
+          generic_product_impl<SymmetricMatrixOperator<_Scalar,
+                                                       _ComputeScalar>,
+                               Rhs> > {
+    typedef SymmetricMatrixOperator<_Scalar, _ComputeScalar> Lhs;
+    typedef typename Lhs::Scalar Scalar;
+
+    template<typename Dest>
+    static void scaleAndAddTo(Dest& dst, const Lhs& lhs, const Rhs& rhs,
+                              const Scalar& alpha) {
+        typename Lhs::VectorType x = rhs;
+        typename Lhs::VectorType y;
+        lhs.multiply(x, y);
+        dst.noalias() += alpha * y;
+    }
+};
+
+}  // namespace internal
+}  // namespace Eigen
+
+/**
+ * \class SymmetricJacobiPreconditioner<typename Scalar>
+ * \brief Diagonal (Jacobi) preconditioner for SymmetricMatrixOperator
+ *
+ * Eigen::DiagonalPreconditioner needs the sparse iterators of the matrix.
+ * This preconditioner instead reads the diagonal of the wrapped
+ * SymmetricMatrix directly from packed storage. Zero diagonal elements are
+ * replaced by one, like in Eigen::DiagonalPreconditioner.
+ */
+template<typename Scalar>
+class SymmetricJacobiPreconditioner
+    : public Eigen::DiagonalPreconditioner<Scalar> {
+    typedef Eigen::DiagonalPreconditioner<Scalar> Base;
+
+ public:
+    SymmetricJacobiPreconditioner() {}
+
+    template<typename MatType>
+    explicit SymmetricJacobiPreconditioner(const MatType& op) {
+        compute(op);
+    }
+
+    template<typename MatType>
+    SymmetricJacobiPreconditioner& analyzePattern(const MatType&) {
+        return *this;
+    }
+
+    template<typename MatType>
+    SymmetricJacobiPreconditioner& factorize(const MatType& op) {
+        Base::m_invdiag = op.diagonal();
+        for (Eigen::Index i = 0; i < Base::m_invdiag.size(); ++i) {
+            Base::m_invdiag(i) = (Base::m_invdiag(i) != Scalar(0))
+                ? Scalar(1) / Base::m_invdiag(i) : Scalar(1);
+        }
+        Base::m_isInitialized = true;
+        return *this;
+    }
+
+    template<typename MatType>
+    SymmetricJacobiPreconditioner& compute(const MatType& op) {
+        return factorize(op);
+    }
+};
+
+#endif /* GSOC_SYMMAT_PARALLEL_H */
@@ -0,0 +1,470 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Test - Batch                                                               *
+ *  Batched kernels on symmetric matrices stored as structure of arrays        *
+ ******************************************************************************/
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <SymmetricMatrixBatch.h>
+#include <eigen3/Eigen/Eigen>
+
+#include "test_helpers.h"
+
+/**
+ * Compare two chi-square values
+ */
+template<typename Scalar>
+bool chi2Approx(Scalar lhs, Scalar rhs) {
+    return std::abs(lhs - rhs)
+        <= Eigen::NumTraits<Scalar>::dummy_precision() * std::abs(rhs);
+}
+
+/**
+ * Chi-square of many residuals with one covariance
+ */
+template<typename Scalar, int Dimension>
+int TEST_CHI2_SHARED() {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    const int count = 37;
+    Matrix S = randomPositiveDefinite<Scalar, Dimension>();
+    typename SymmetricMatrixBatch<Scalar, Dimension>::VectorBatch residuals
+        = SymmetricMatrixBatch<Scalar, Dimension>::VectorBatch::Random(
+            Dimension, count);
+    SymmetricMatrix<Scalar, Dimension> symS(S);
+    Eigen::Array<Scalar, Eigen::Dynamic, 1> result;
+
+    if (chi2(symS, residuals, result) != Eigen::Success
+        || result.size() != count) {
+        return 1;
+    }
+    Matrix inv = S.inverse();
+    for (int t = 0; t < count; ++t) {
+        Eigen::Matrix<Scalar, Dimension, 1> r = residuals.col(t);
+        if (!chi2Approx(result(t), r.dot(inv * r))) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Chi-square of one residual per covariance, one covariance is not positive
+ * definite
+ */
+template<typename Scalar, int Dimension>
+int TEST_CHI2_BATCH() {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    const int count = 37;
+    const int failing = 5;
+    SymmetricMatrixBatch<Scalar, Dimension> S(count);
+    std::vector<Matrix> dense(count);
+    for (int t = 0; t < count; ++t) {
+        dense[t] = randomPositiveDefinite<Scalar, Dimension>();
+        if (t == failing) {
+            dense[t](0, 0) = -dense[t](0, 0);
+        }
+        S.set(t, SymmetricMatrix<Scalar, Dimension>(dense[t]));
+    }
+    typename SymmetricMatrixBatch<Scalar, Dimension>::VectorBatch residuals
+        = SymmetricMatrixBatch<Scalar, Dimension>::VectorBatch::Random(
+            Dimension, count);
+    Eigen::Array<Scalar, Eigen::Dynamic, 1> result;
+
+    if (chi2(S, residuals, result) != Eigen::NumericalIssue) {
+        return 1;
+    }
+    for (int t = 0; t < count; ++t) {
+        Eigen::Matrix<Scalar, Dimension, 1> r = residuals.col(t);
+        if (t == failing) {
+            if (!std::isnan(result(t))) {
+                return 1;
+            }
+        } else if (!chi2Approx(result(t), r.dot(dense[t].inverse() * r))) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Conversion between single and double precision storage
+ */
+int TEST_MIXED_CAST() {
+    Eigen::Matrix<double, 5, 5> mat = randomPositiveDefinite<double, 5>();
+    SymmetricMatrix<double, 5> fixed(mat);
+    SymmetricMatrix<float, 5, double> mixed = fixed.cast<float, double>();
+    SymmetricMatrix<double, 5> back = mixed.cast<double>();
+
+    Eigen::Matrix<double, -1, -1> dynMat = mat;
+    SymmetricMatrix<double> dyn(dynMat);
+    SymmetricMatrix<float, Eigen::Dynamic, double> dynMixed
+        = dyn.cast<float, double>();
+
+    std::vector<SymmetricMatrix<double, 5> > mats(9, fixed);
+    SymmetricMatrixBatch<double, 5> batch(mats);
+    SymmetricMatrixBatch<float, 5, double> batchMixed
+        = batch.cast<float, double>();
+
+    Eigen::Matrix<float, 5, 5> matf = mat.cast<float>();
+    if (mixed.constructEigenMatrix() != matf
+        || !back.constructEigenMatrix().isApprox(mat, 1e-6)
+        || dynMixed.constructEigenMatrix() != Eigen::Matrix<float, -1, -1>(matf)
+        || batchMixed.get(8).constructEigenMatrix() != matf) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Product of symmetric matrices with float storage accumulates in double
+ */
+int TEST_MIXED_PRODUCT() {
+    Eigen::Matrix<double, 6, 6> mat1 = randomPositiveDefinite<double, 6>();
+    Eigen::Matrix<double, 6, 6> mat2 = randomPositiveDefinite<double, 6>();
+    SymmetricMatrix<float, 6, double> sym1
+        = SymmetricMatrix<double, 6>(mat1).cast<float, double>();
+    SymmetricMatrix<float, 6, double> sym2
+        = SymmetricMatrix<double, 6>(mat2).cast<float, double>();
+    Eigen::Matrix<double, 6, 6> exact
+        = sym1.constructEigenMatrix().cast<double>()
+          * sym2.constructEigenMatrix().cast<double>();
+    Eigen::Matrix<float, 6, 6> res = sym1 * sym2;
+    return res.isApprox(exact.cast<float>(), 1e-6f) ? 0 : 1;
+}
+
+/**
+ * Chi-square of covariances with float storage computed in double precision
+ */
+int TEST_CHI2_MIXED() {
+    const int count = 37;
+    SymmetricMatrixBatch<double, 3> S(count);
+    for (int t = 0; t < count; ++t) {
+        S.set(t, SymmetricMatrix<double, 3>(
+            randomPositiveDefinite<double, 3>()));
+    }
+    SymmetricMatrixBatch<double, 3>::VectorBatch residuals
+        = SymmetricMatrixBatch<double, 3>::VectorBatch::Random(3, count);
+    SymmetricMatrixBatch<float, 3, double> mixed = S.cast<float, double>();
+    SymmetricMatrixBatch<float, 3>::VectorBatch mixedResiduals
+        = residuals.cast<float>();
+
+    // Reference computed in double from the same single precision inputs
+    Eigen::Array<double, Eigen::Dynamic, 1> reference;
+    Eigen::Array<float, Eigen::Dynamic, 1> result;
+    if (chi2(mixed.cast<double>(), SymmetricMatrixBatch<double, 3>::VectorBatch(
+            mixedResiduals.cast<double>()), reference) != Eigen::Success
+        || chi2(mixed, mixedResiduals, result) != Eigen::Success) {
+        return 1;
+    }
+    return ((result.cast<double>() - reference).abs()
+            <= 1e-6 * reference.abs()).all() ? 0 : 1;
+}
+
+/**
+ * Exact reciprocal condition number in the 1-norm
+ */
+template<typename Scalar, int Dimension>
+Scalar exactRcond(const Eigen::Matrix<Scalar, Dimension, Dimension>& mat) {
+    return Scalar(1) / (mat.cwiseAbs().colwise().sum().maxCoeff()
+                        * mat.inverse().cwiseAbs().colwise().sum().maxCoeff());
+}
+
+/**
+ * Positive definiteness check of single matrices and of a batch
+ */
+template<typename Scalar, int Dimension>
+int TEST_POSITIVE_DEFINITE() {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    const int count = 37;
+    const int failing = 5;
+    SymmetricMatrixBatch<Scalar, Dimension> S(count);
+    for (int t = 0; t < count; ++t) {
+        Matrix mat = randomPositiveDefinite<Scalar, Dimension>();
+        if (t == failing) {
+            mat(Dimension - 1, Dimension - 1) = -mat(Dimension - 1,
+                                                     Dimension - 1);
+        }
+        SymmetricMatrix<Scalar, Dimension> fixed(mat);
+        SymmetricMatrix<Scalar> dyn{Eigen::Matrix<Scalar, -1, -1>(mat)};
+        if (fixed.isPositiveDefinite() != (t != failing)
+            || dyn.isPositiveDefinite() != (t != failing)) {
+            return 1;
+        }
+        S.set(t, fixed);
+    }
+    Eigen::Array<bool, Eigen::Dynamic, 1> result = isPositiveDefinite(S);
+    for (int t = 0; t < count; ++t) {
+        if (result(t) != (t != failing)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Condition estimate of single matrices and of a batch. The estimate of
+ * |A^-1|_1 is a lower bound, so rcond may only be overestimated and is
+ * usually exact or within a small factor.
+ */
+template<typename Scalar, int Dimension>
+int TEST_RCOND() {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    const int count = 37;
+    const int failing = 5;
+    const Scalar eps = 100 * Eigen::NumTraits<Scalar>::epsilon();
+    SymmetricMatrixBatch<Scalar, Dimension> S(count);
+    std::vector<Matrix, Eigen::aligned_allocator<Matrix> > dense(count);
+    for (int t = 0; t < count; ++t) {
+        dense[t] = randomPositiveDefinite<Scalar, Dimension>();
+        // Make some matrices badly conditioned
+        dense[t].row(0) *= Scalar(1 + t);
+        dense[t].col(0) *= Scalar(1 + t);
+        if (t == failing) {
+            dense[t](0, 0) = -dense[t](0, 0);
+        }
+        S.set(t, SymmetricMatrix<Scalar, Dimension>(dense[t]));
+    }
+    Eigen::Array<Scalar, Eigen::Dynamic, 1> result = rcondEstimate(S);
+    for (int t = 0; t < count; ++t) {
+        SymmetricMatrix<Scalar, Dimension> fixed(dense[t]);
+        SymmetricMatrix<Scalar> dyn{Eigen::Matrix<Scalar, -1, -1>(dense[t])};
+        if (t == failing) {
+            if (result(t) != 0 || fixed.rcondEstimate() != 0
+                || dyn.rcondEstimate() != 0) {
+                return 1;
+            }
+            continue;
+        }
+        const Scalar exact = exactRcond(dense[t]);
+        if (result(t) < exact * (1 - eps) || result(t) > 3 * exact
+            || std::abs(fixed.rcondEstimate() - result(t)) > eps * result(t)
+            || std::abs(dyn.rcondEstimate() - result(t)) > eps * result(t)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Compare a log-determinant with a reference that may be -infinity or NaN
+ */
+template<typename Scalar>
+bool sameLogDeterminant(Scalar result, Scalar expected) {
+    if (std::isnan(expected) || std::isinf(expected)) {
+        return (std::isnan(expected) && std::isnan(result))
+            || result == expected;
+    }
+    return std::abs(result - expected)
+        <= Eigen::NumTraits<Scalar>::dummy_precision()
+           * std::max(Scalar(1), std::abs(expected));
+}
+
+/**
+ * Log-determinant and determinant of single matrices and of a batch,
+ * including indefinite and singular matrices
+ */
+template<typename Scalar, int Dimension>
+int TEST_LOG_DETERMINANT() {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    const int count = 37;
+    SymmetricMatrixBatch<Scalar, Dimension> S(count);
+    std::vector<Matrix, Eigen::aligned_allocator<Matrix> > dense(count);
+    for (int t = 0; t < count; ++t) {
+        dense[t] = randomPositiveDefinite<Scalar, Dimension>();
+        if (t == 5) {
+            dense[t] = -dense[t];
+        } else if (t == 9) {
+            dense[t].row(1).setZero();
+            dense[t].col(1).setZero();
+        }
+        S.set(t, SymmetricMatrix<Scalar, Dimension>(dense[t]));
+    }
+    Eigen::Array<Scalar, Eigen::Dynamic, 1> result = logDeterminant(S);
+    for (int t = 0; t < count; ++t) {
+        SymmetricMatrix<Scalar, Dimension> fixed(dense[t]);
+        SymmetricMatrix<Scalar> dyn{Eigen::Matrix<Scalar, -1, -1>(dense[t])};
+        const Scalar det = dense[t].determinant();
+        const Scalar logDet = std::log(det);
+        const Scalar precision = Eigen::NumTraits<Scalar>::dummy_precision()
+            * std::max(Scalar(1), std::abs(det));
+        if (!sameLogDeterminant(result(t), logDet)
+            || !sameLogDeterminant(fixed.logDeterminant(), logDet)
+            || !sameLogDeterminant(dyn.logDeterminant(), logDet)
+            || std::abs(fixed.determinant() - det) > precision
+            || std::abs(dyn.determinant() - det) > precision) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Conversion between covariance and correlation matrices of single matrices
+ * and of a batch, in place and out of place
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar>
+int TEST_CORRELATION() {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    typedef Eigen::Matrix<Scalar, Dimension, 1> Vector;
+    typedef SymmetricMatrix<Scalar, Dimension, ComputeScalar> Symmetric;
+    typedef SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> Dynamic;
+    typedef SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar> Batch;
+    const int count = 300;
+    const Scalar precision = Eigen::NumTraits<Scalar>::dummy_precision();
+    Batch C(count);
+    typename Batch::VectorBatch stddev(Dimension, count);
+    std::vector<Matrix, Eigen::aligned_allocator<Matrix> > dense(count);
+    for (int t = 0; t < count; ++t) {
+        dense[t] = randomPositiveDefinite<Scalar, Dimension>();
+        C.set(t, Symmetric(dense[t]));
+        stddev.col(t) = dense[t].diagonal().cwiseSqrt();
+    }
+    Batch R = C.correlation();
+    Batch back = R.covariance(stddev);
+    Batch inPlace = C;
+    inPlace.toCorrelation();
+    if ((inPlace.packed() != R.packed()).any()) {
+        return 1;
+    }
+    inPlace.toCovariance(stddev);
+    if ((inPlace.packed() != back.packed()).any()) {
+        return 1;
+    }
+    for (int t = 0; t < count; ++t) {
+        const Vector s = stddev.col(t);
+        const Matrix expected = s.asDiagonal().inverse() * dense[t]
+            * s.asDiagonal().inverse();
+        Symmetric fixed(dense[t]);
+        Dynamic dyn{Eigen::Matrix<Scalar, -1, -1>(dense[t])};
+        Symmetric fixedR = fixed.correlation();
+        Dynamic dynR = dyn.correlation();
+        if (!fixedR.constructEigenMatrix().isApprox(expected, precision)
+            || !dynR.constructEigenMatrix().isApprox(expected, precision)
+            || !R.get(t).constructEigenMatrix().isApprox(expected, precision)
+            || fixedR.constructEigenMatrix().diagonal() != Vector::Ones()
+            || !back.get(t).constructEigenMatrix().isApprox(dense[t],
+                                                            precision)) {
+            return 1;
+        }
+        fixed.toCorrelation().toCovariance(s);
+        dyn.toCorrelation().toCovariance(s);
+        if (!fixed.constructEigenMatrix().isApprox(dense[t], precision)
+            || !dyn.constructEigenMatrix().isApprox(dense[t], precision)
+            || !fixed.correlation().covariance(s).constructEigenMatrix()
+                .isApprox(dense[t], precision)
+            || !dyn.correlation().covariance(s).constructEigenMatrix()
+                .isApprox(dense[t], precision)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Traces, traces of products and Frobenius inner products of a batch,
+ * including tr(S1^-1 S2) as in the Kullback-Leibler divergence
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar>
+int TEST_TRACE() {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    typedef SymmetricMatrix<Scalar, Dimension, ComputeScalar> Symmetric;
+    typedef SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> Dynamic;
+    typedef SymmetricMatrixBatch<Scalar, Dimension, ComputeScalar> Batch;
+    const int count = 300;
+    Batch A(count), B(count);
+    std::vector<Matrix, Eigen::aligned_allocator<Matrix> > dense1(count);
+    std::vector<Matrix, Eigen::aligned_allocator<Matrix> > dense2(count);
+    for (int t = 0; t < count; ++t) {
+        dense1[t] = randomPositiveDefinite<Scalar, Dimension>();
+        dense2[t] = randomPositiveDefinite<Scalar, Dimension>();
+        A.set(t, Symmetric(dense1[t]));
+        B.set(t, Symmetric(dense2[t]));
+    }
+    const Eigen::Array<Scalar, Eigen::Dynamic, 1> traces = trace(A);
+    const Eigen::Array<Scalar, Eigen::Dynamic, 1> products
+        = traceOfProduct(A, B);
+    const Eigen::Array<Scalar, Eigen::Dynamic, 1> dots = frobeniusDot(A, B);
+    for (int t = 0; t < count; ++t) {
+        const Scalar precision = Eigen::NumTraits<Scalar>::dummy_precision()
+            * dense1[t].norm() * dense2[t].norm();
+        const Scalar product = (dense1[t] * dense2[t]).trace();
+        const Scalar kl = (dense1[t].inverse() * dense2[t]).trace();
+        Dynamic dyn1{Eigen::Matrix<Scalar, -1, -1>(dense1[t])};
+        Dynamic dyn2{Eigen::Matrix<Scalar, -1, -1>(dense2[t])};
+        if (std::abs(traces(t) - dense1[t].trace()) > precision
+            || std::abs(products(t) - product) > precision
+            || std::abs(dots(t) - product) > precision
+            || std::abs(dyn1.inverse().traceOfProduct(dyn2) - kl)
+               > precision * dense1[t].inverse().norm()) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main() {
+    std::cout << "Testing chi-square...\n";
+    std::cout << "[TEST_CHI2_SHARED][double][2]"
+              << ((!TEST_CHI2_SHARED<double, 2>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CHI2_SHARED][double][5]"
+              << ((!TEST_CHI2_SHARED<double, 5>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CHI2_SHARED][float][3]"
+              << ((!TEST_CHI2_SHARED<float, 3>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CHI2_BATCH][double][2]"
+              << ((!TEST_CHI2_BATCH<double, 2>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CHI2_BATCH][double][5]"
+              << ((!TEST_CHI2_BATCH<double, 5>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CHI2_BATCH][float][3]"
+              << ((!TEST_CHI2_BATCH<float, 3>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CHI2_MIXED][float/double][3]"
+              << ((!TEST_CHI2_MIXED())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing mixed precision...\n";
+    std::cout << "[TEST_MIXED_CAST][float/double][5]"
+              << ((!TEST_MIXED_CAST())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_MIXED_PRODUCT][float/double][6]"
+              << ((!TEST_MIXED_PRODUCT())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing positive definiteness, condition and determinant...\n";
+    std::cout << "[TEST_POSITIVE_DEFINITE][double][2]"
+              << ((!TEST_POSITIVE_DEFINITE<double, 2>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_POSITIVE_DEFINITE][double][5]"
+              << ((!TEST_POSITIVE_DEFINITE<double, 5>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_POSITIVE_DEFINITE][float][3]"
+              << ((!TEST_POSITIVE_DEFINITE<float, 3>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_RCOND][double][2]"
+              << ((!TEST_RCOND<double, 2>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_RCOND][double][5]"
+              << ((!TEST_RCOND<double, 5>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_RCOND][double][8]"
+              << ((!TEST_RCOND<double, 8>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_LOG_DETERMINANT][double][2]"
+              << ((!TEST_LOG_DETERMINANT<double, 2>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_LOG_DETERMINANT][double][5]"
+              << ((!TEST_LOG_DETERMINANT<double, 5>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_LOG_DETERMINANT][float][3]"
+              << ((!TEST_LOG_DETERMINANT<float, 3>())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing correlation...\n";
+    std::cout << "[TEST_CORRELATION][double][2]"
+              << ((!TEST_CORRELATION<double, 2, double>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CORRELATION][double][5]"
+              << ((!TEST_CORRELATION<double, 5, double>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CORRELATION][float/double][5]"
+              << ((!TEST_CORRELATION<float, 5, double>())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing traces...\n";
+    std::cout << "[TEST_TRACE][double][2]"
+              << ((!TEST_TRACE<double, 2, double>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_TRACE][double][5]"
+              << ((!TEST_TRACE<double, 5, double>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_TRACE][float/double][5]"
+              << ((!TEST_TRACE<float, 5, double>())?" => PASSED\n":" => FAIL\n");
+}
@@ -0,0 +1,684 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Test - Decomposition                                                       *
+ *  Factorizations and derived quantities computed in packed storage           *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <SymmetricMatrixDecomposition.h>
+#include <eigen3/Eigen/Eigen>
+
+#include "test_helpers.h"
+
+/**
+ * Schur complement S_aa - S_ab S_bb^-1 S_ba of the rows and columns keep
+ * evaluated with Eigen::Matrix
+ */
+template<typename Scalar, int Dimension>
+Eigen::Matrix<Scalar, -1, -1>
+denseSchurComplement(const Eigen::Matrix<Scalar, Dimension, Dimension>& mat,
+                     const std::vector<int>& keep) {
+    std::vector<int> elim;
+    for (int i = 0; i < mat.rows(); ++i) {
+        if (std::find(keep.begin(), keep.end(), i) == keep.end()) {
+            elim.push_back(i);
+        }
+    }
+    Eigen::Matrix<Scalar, -1, -1> aa(keep.size(), keep.size());
+    Eigen::Matrix<Scalar, -1, -1> ab(keep.size(), elim.size());
+    Eigen::Matrix<Scalar, -1, -1> bb(elim.size(), elim.size());
+    for (size_t i = 0; i < keep.size(); ++i) {
+        for (size_t j = 0; j < keep.size(); ++j) {
+            aa(i, j) = mat(keep[i], keep[j]);
+        }
+        for (size_t j = 0; j < elim.size(); ++j) {
+            ab(i, j) = mat(keep[i], elim[j]);
+        }
+    }
+    for (size_t i = 0; i < elim.size(); ++i) {
+        for (size_t j = 0; j < elim.size(); ++j) {
+            bb(i, j) = mat(elim[i], elim[j]);
+        }
+    }
+    if (elim.empty()) {
+        return aa;
+    }
+    return aa - ab * bb.llt().solve(ab.transpose());
+}
+
+/**
+ * Schur complement of a symmetric matrix of fixed size
+ */
+template<typename Scalar, int Dimension>
+int TEST_SCHUR_SYMF(const std::vector<int>& keep) {
+    Eigen::Matrix<Scalar, Dimension, Dimension> mat
+        = randomPositiveDefinite<Scalar, Dimension>();
+    SymmetricMatrix<Scalar, Dimension> sym(mat);
+    SymmetricMatrix<Scalar> result;
+    if (sym.schurComplement(keep, result) != Eigen::Success
+        || result.dim() != keep.size()) {
+        return 1;
+    }
+    return result.constructEigenMatrix().isApprox(
+        denseSchurComplement<Scalar, Dimension>(mat, keep),
+        Eigen::NumTraits<Scalar>::dummy_precision()) ? 0 : 1;
+}
+
+/**
+ * Marginalization of a symmetric matrix of dynamic size onto every third row
+ */
+template<typename Scalar, int Dimension>
+int TEST_SCHUR_SYMD() {
+    Eigen::Matrix<Scalar, -1, -1> mat
+        = randomPositiveDefinite<Scalar, -1>(Dimension);
+    SymmetricMatrix<Scalar> sym(mat);
+    std::vector<int> keep;
+    for (int i = Dimension - 1; i >= 0; i -= 3) {
+        keep.push_back(i);
+    }
+    SymmetricMatrix<Scalar> result;
+    if (sym.schurComplement(keep, result) != Eigen::Success) {
+        return 1;
+    }
+    return result.constructEigenMatrix().isApprox(
+        denseSchurComplement<Scalar, -1>(mat, keep),
+        Eigen::NumTraits<Scalar>::dummy_precision()) ? 0 : 1;
+}
+
+/**
+ * The eliminated block is not positive definite, the result is unchanged
+ */
+int TEST_SCHUR_FAIL() {
+    Eigen::Matrix<double, 5, 5> mat = randomPositiveDefinite<double, 5>();
+    mat(4, 4) = -mat(4, 4);
+    SymmetricMatrix<double, 5> sym(mat);
+    std::vector<int> keep(2);
+    keep[0] = 0;
+    keep[1] = 1;
+    SymmetricMatrix<double> result(Eigen::MatrixXd::Identity(3, 3));
+    return (sym.schurComplement(keep, result) == Eigen::NumericalIssue
+            && result.dim() == 3) ? 0 : 1;
+}
+
+/**
+ * Eigendecomposition of a symmetric matrix of fixed size
+ */
+template<typename Scalar, int Dimension>
+int TEST_EIGEN_SYMF() {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    Matrix mat = Matrix::Random();
+    mat = (mat + mat.transpose()).eval();
+    SymmetricMatrix<Scalar, Dimension> sym(mat);
+    SymmetricEigenSolver<Scalar> solver(sym);
+    Eigen::SelfAdjointEigenSolver<Matrix> reference(mat);
+    const Scalar precision = Eigen::NumTraits<Scalar>::dummy_precision();
+    const Matrix vectors = solver.eigenvectors();
+    if (solver.info() != Eigen::Success
+        || !solver.eigenvalues().isApprox(reference.eigenvalues(), precision)
+        || !(mat * vectors).isApprox(vectors
+            * solver.eigenvalues().asDiagonal(), precision)
+        || !(vectors.transpose() * vectors).isIdentity(precision)) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Eigenvalues and eigenvectors of a symmetric matrix of dynamic size that
+ * stores floats and computes in double precision
+ */
+template<typename Scalar, typename ComputeScalar, int Dimension>
+int TEST_EIGEN_SYMD() {
+    typedef Eigen::Matrix<ComputeScalar, -1, -1> Matrix;
+    Eigen::Matrix<Scalar, -1, -1> mat
+        = Eigen::Matrix<Scalar, -1, -1>::Random(Dimension, Dimension);
+    mat = (mat + mat.transpose()).eval();
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> sym(mat);
+    SymmetricEigenSolver<Scalar, ComputeScalar> values(sym,
+        Eigen::EigenvaluesOnly);
+    SymmetricEigenSolver<Scalar, ComputeScalar> solver(sym);
+    Matrix exact = mat.template cast<ComputeScalar>();
+    Eigen::SelfAdjointEigenSolver<Matrix> reference(exact);
+    const ComputeScalar precision
+        = Eigen::NumTraits<ComputeScalar>::dummy_precision();
+    const Matrix& vectors = solver.eigenvectors();
+    if (solver.info() != Eigen::Success || values.info() != Eigen::Success
+        || !values.eigenvalues().isApprox(reference.eigenvalues(), precision)
+        || !solver.eigenvalues().isApprox(reference.eigenvalues(), precision)
+        || !(exact * vectors).isApprox(vectors
+            * solver.eigenvalues().asDiagonal(), precision)
+        || !(vectors.transpose() * vectors).isIdentity(precision)) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Random symmetric matrices of dimension 2 or 3, some with repeated
+ * eigenvalues
+ */
+template<typename Scalar, int Dimension>
+std::vector<Eigen::Matrix<Scalar, Dimension, Dimension>,
+            Eigen::aligned_allocator<Eigen::Matrix<Scalar, Dimension,
+                                                   Dimension> > >
+directTestMatrices(int count) {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    std::vector<Matrix, Eigen::aligned_allocator<Matrix> > mats(count);
+    for (int t = 0; t < count; ++t) {
+        Matrix mat = Matrix::Random();
+        mats[t] = mat + mat.transpose();
+        if (t % 5 == 1) {
+            // All eigenvalues equal
+            mats[t] = Scalar(t) * Matrix::Identity();
+        } else if (t % 5 == 3) {
+            // Two equal eigenvalues
+            Eigen::Matrix<Scalar, Dimension, 1> diag
+                = Eigen::Matrix<Scalar, Dimension, 1>::Ones();
+            diag(Dimension - 1) = Scalar(3);
+            Matrix q = Eigen::HouseholderQR<Matrix>(mat).householderQ();
+            mats[t] = q * diag.asDiagonal() * q.transpose();
+            for (int i = 0; i < Dimension; ++i) {
+                for (int j = i; j < Dimension; ++j) {
+                    mats[t](i, j) = mats[t](j, i);
+                }
+            }
+        }
+    }
+    return mats;
+}
+
+/**
+ * Check an eigendecomposition against Eigen::SelfAdjointEigenSolver
+ */
+template<typename Scalar, int Dimension>
+bool checkEigen(const Eigen::Matrix<Scalar, Dimension, Dimension>& mat,
+                const Eigen::Matrix<Scalar, Dimension, 1>& values,
+                const Eigen::Matrix<Scalar, Dimension, Dimension>& vectors) {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    const Scalar precision = std::sqrt(Eigen::NumTraits<Scalar>::epsilon());
+    Eigen::SelfAdjointEigenSolver<Matrix> reference(mat);
+    const Scalar norm = std::max(mat.norm(), Scalar(1));
+    return (values - reference.eigenvalues()).norm() <= precision * norm
+        && (mat * vectors - vectors * values.asDiagonal()).norm()
+            <= precision * norm
+        && (vectors.transpose() * vectors - Matrix::Identity()).norm()
+            <= precision;
+}
+
+/**
+ * Closed-form eigendecomposition of single matrices
+ */
+template<typename Scalar, int Dimension>
+int TEST_EIGEN_DIRECT() {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    std::vector<Matrix, Eigen::aligned_allocator<Matrix> > mats
+        = directTestMatrices<Scalar, Dimension>(20);
+    for (size_t t = 0; t < mats.size(); ++t) {
+        SymmetricMatrix<Scalar, Dimension> sym(mats[t]);
+        DirectEigenSolver<Scalar, Dimension> solver(sym);
+        DirectEigenSolver<Scalar, Dimension> values(sym,
+                                                    Eigen::EigenvaluesOnly);
+        if (!checkEigen<Scalar, Dimension>(mats[t], solver.eigenvalues(),
+                                           solver.eigenvectors())
+            || values.eigenvalues() != solver.eigenvalues()) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Closed-form eigendecomposition of a batch, one matrix per SIMD lane
+ */
+template<typename Scalar, int Dimension>
+int TEST_EIGEN_DIRECT_BATCH() {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    const int count = 37;
+    std::vector<Matrix, Eigen::aligned_allocator<Matrix> > mats
+        = directTestMatrices<Scalar, Dimension>(count);
+    SymmetricMatrixBatch<Scalar, Dimension> batch(count);
+    for (int t = 0; t < count; ++t) {
+        batch.set(t, SymmetricMatrix<Scalar, Dimension>(mats[t]));
+    }
+    Eigen::Array<Scalar, Dimension, Eigen::Dynamic, Eigen::RowMajor> values;
+    Eigen::Array<Scalar, Dimension * Dimension, Eigen::Dynamic,
+                 Eigen::RowMajor> vectors;
+    eigenDirect(batch, values, &vectors);
+    for (int t = 0; t < count; ++t) {
+        Matrix v;
+        for (int i = 0; i < Dimension; ++i) {
+            for (int j = 0; j < Dimension; ++j) {
+                v(i, j) = vectors(i * Dimension + j, t);
+            }
+        }
+        if (!checkEigen<Scalar, Dimension>(mats[t], values.col(t), v)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Count the positive, negative and zero eigenvalues of a symmetric matrix
+ * with Eigen::SelfAdjointEigenSolver
+ */
+template<typename Scalar, int Dimension>
+void denseInertia(const Eigen::Matrix<Scalar, Dimension, Dimension>& mat,
+                  int& positive, int& negative, int& zero) {
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix<Scalar, Dimension, Dimension> >
+        solver(mat, Eigen::EigenvaluesOnly);
+    const Scalar tolerance = Eigen::NumTraits<Scalar>::dummy_precision()
+        * std::max(mat.norm(), Scalar(1));
+    positive = (solver.eigenvalues().array() > tolerance).count();
+    negative = (solver.eigenvalues().array() < -tolerance).count();
+    zero = mat.rows() - positive - negative;
+}
+
+/**
+ * Relative residual of a solution of A X = B
+ */
+template<typename MatrixType, typename Rhs, typename Solution>
+typename MatrixType::Scalar
+relativeResidual(const MatrixType& mat, const Rhs& b, const Solution& x) {
+    return (mat * x - b).norm() / (mat.norm() * x.norm() + b.norm());
+}
+
+/**
+ * Factorization, solve and inertia of an indefinite symmetric matrix of fixed
+ * size
+ */
+template<typename Scalar, int Dimension>
+int TEST_LDLT_SYMF() {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    Matrix mat = Matrix::Random();
+    mat = (mat + mat.transpose()).eval();
+    SymmetricMatrix<Scalar, Dimension> sym(mat);
+    SymmetricLDLT<Scalar> ldlt(sym);
+    const Eigen::Matrix<Scalar, Dimension, 1> b
+        = Eigen::Matrix<Scalar, Dimension, 1>::Random();
+    const Eigen::Matrix<Scalar, Dimension, 3> rhs
+        = Eigen::Matrix<Scalar, Dimension, 3>::Random();
+    const Scalar precision = Eigen::NumTraits<Scalar>::dummy_precision();
+    int positive, negative, zero;
+    int expPositive, expNegative, expZero;
+    ldlt.inertia(positive, negative, zero);
+    denseInertia<Scalar, Dimension>(mat, expPositive, expNegative, expZero);
+    if (ldlt.info() != Eigen::Success
+        || relativeResidual(mat, b, ldlt.solve(b)) > precision
+        || relativeResidual(mat, rhs, ldlt.solve(rhs)) > precision
+        || positive != expPositive || negative != expNegative
+        || zero != expZero) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * KKT matrix [H A^T; A 0] of a constrained fit with H positive definite and A
+ * of full rank, which has n positive and m negative eigenvalues. The zero
+ * block forces 2x2 pivots.
+ */
+template<typename Scalar, typename ComputeScalar, int N, int M>
+int TEST_LDLT_KKT() {
+    Eigen::Matrix<Scalar, -1, -1> mat(N + M, N + M);
+    mat.topLeftCorner(N, N) = randomPositiveDefinite<Scalar, -1>(N);
+    mat.bottomLeftCorner(M, N) = Eigen::Matrix<Scalar, -1, -1>::Random(M, N);
+    mat.topRightCorner(N, M) = mat.bottomLeftCorner(M, N).transpose();
+    mat.bottomRightCorner(M, M).setZero();
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> sym(mat);
+    SymmetricLDLT<Scalar, ComputeScalar> ldlt(sym);
+    const Eigen::Matrix<ComputeScalar, -1, 1> b
+        = Eigen::Matrix<ComputeScalar, -1, 1>::Random(N + M);
+    const Eigen::Matrix<ComputeScalar, -1, -1> exact
+        = mat.template cast<ComputeScalar>();
+    int positive, negative, zero;
+    ldlt.inertia(positive, negative, zero);
+    if (ldlt.info() != Eigen::Success
+        || relativeResidual(exact, b, ldlt.solve(b))
+           > Eigen::NumTraits<ComputeScalar>::dummy_precision()
+        || positive != N || negative != M || zero != 0) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * A zero row and column make the matrix singular, the zero eigenvalue shows up
+ * in the inertia
+ */
+int TEST_LDLT_SINGULAR() {
+    Eigen::Matrix<double, 6, 6> mat = Eigen::Matrix<double, 6, 6>::Random();
+    mat = (mat + mat.transpose()).eval();
+    mat.row(2).setZero();
+    mat.col(2).setZero();
+    SymmetricMatrix<double, 6> sym(mat);
+    SymmetricLDLT<double> ldlt(sym);
+    int positive, negative, zero;
+    int expPositive, expNegative, expZero;
+    ldlt.inertia(positive, negative, zero);
+    denseInertia<double, 6>(mat, expPositive, expNegative, expZero);
+    return (ldlt.info() == Eigen::NumericalIssue && zero == 1
+            && positive == expPositive && negative == expNegative) ? 0 : 1;
+}
+
+/**
+ * Normal equations of a fit with one outlier: The outlier is added by an
+ * update and removed again by a downdate. Both factors have to agree with
+ * Eigen::LLT of the same matrices.
+ */
+template<typename Scalar, typename ComputeScalar>
+int TEST_CHOLESKY_UPDATE(int dim) {
+    typedef Eigen::Matrix<ComputeScalar, -1, -1> Matrix;
+    typedef Eigen::Matrix<ComputeScalar, -1, 1> Vector;
+    const Eigen::Matrix<Scalar, -1, -1> mat
+        = randomPositiveDefinite<Scalar, -1>(dim);
+    const Matrix exact = mat.template cast<ComputeScalar>();
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> sym(mat);
+    SymmetricLLT<Scalar, ComputeScalar> llt(sym);
+    const Vector x = Vector::Random(dim);
+    const ComputeScalar sigma(4);
+    const ComputeScalar precision
+        = Eigen::NumTraits<ComputeScalar>::dummy_precision();
+
+    llt.choleskyUpdate(x, sigma);
+    const Matrix updated = exact + sigma * x * x.transpose();
+    Eigen::LLT<Matrix, Eigen::Upper> expected(updated);
+    const Vector b = Vector::Random(dim);
+    if (llt.info() != Eigen::Success
+        || !llt.matrixU().isApprox(Matrix(expected.matrixU()), precision)
+        || relativeResidual(updated, b, llt.solve(b)) > precision) {
+        return 1;
+    }
+
+    llt.choleskyUpdate(x, -sigma);
+    expected.compute(exact);
+    if (llt.info() != Eigen::Success
+        || !llt.matrixU().isApprox(Matrix(expected.matrixU()), precision)
+        || std::abs(llt.logDeterminant() - ComputeScalar(2)
+                    * Matrix(expected.matrixU()).diagonal().array().log().sum())
+           > precision * dim) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Downdating a positive definite matrix by more than its smallest eigenvalue
+ * in the direction of the eigenvector makes it indefinite
+ */
+int TEST_CHOLESKY_DOWNDATE_FAIL() {
+    Eigen::Matrix<double, 6, 6> mat = randomPositiveDefinite<double, 6>();
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix<double, 6, 6> > solver(mat);
+    SymmetricMatrix<double, 6> sym(mat);
+    SymmetricLLT<double> llt(sym);
+    llt.choleskyUpdate(solver.eigenvectors().col(0),
+                       -2.0 * solver.eigenvalues()(0));
+    return (llt.info() == Eigen::NumericalIssue) ? 0 : 1;
+}
+
+/**
+ * Repeated queries with a cached factorization agree with Eigen::Matrix, and
+ * every kind of write discards the factor so that the next query sees the
+ * modified matrix
+ */
+template<typename Scalar, typename ComputeScalar>
+int TEST_CACHED_FACTORIZATION(int dim) {
+    typedef Eigen::Matrix<ComputeScalar, -1, -1> Matrix;
+    typedef Eigen::Matrix<ComputeScalar, -1, 1> Vector;
+    const Eigen::Matrix<Scalar, -1, -1> mat
+        = randomPositiveDefinite<Scalar, -1>(dim);
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> sym(mat);
+    sym.cacheFactorization();
+    const Vector b = Vector::Random(dim);
+    const Eigen::Matrix<ComputeScalar, -1, 3> rhs
+        = Eigen::Matrix<ComputeScalar, -1, 3>::Random(dim, 3);
+    const ComputeScalar precision
+        = Eigen::NumTraits<ComputeScalar>::dummy_precision();
+    // inverse(), chi2() and logDeterminant() return Scalar
+    const ComputeScalar storagePrecision
+        = Eigen::NumTraits<Scalar>::dummy_precision();
+    Matrix exact = mat.template cast<ComputeScalar>();
+    const ComputeScalar chi2 = b.dot(exact.llt().solve(b));
+
+    if (sym.isFactorizationCached()
+        || relativeResidual(exact, b, sym.solve(b)) > precision
+        || !sym.isFactorizationCached()
+        || relativeResidual(exact, rhs, sym.solve(rhs)) > precision
+        || !sym.inverse().constructEigenMatrix().template cast<ComputeScalar>()
+            .isApprox(exact.inverse(), storagePrecision)
+        || std::abs(sym.chi2(b) - chi2) > storagePrecision * chi2
+        || std::abs(sym.logDeterminant() - std::log(exact.determinant()))
+           > dim * storagePrecision) {
+        return 1;
+    }
+
+    // Element access
+    sym(0, dim - 1) += Scalar(0.5);
+    exact = sym.constructEigenMatrix().template cast<ComputeScalar>();
+    if (sym.isFactorizationCached()
+        || relativeResidual(exact, b, sym.solve(b)) > precision) {
+        return 1;
+    }
+
+    // In-place addition
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> identity(
+        Eigen::Matrix<Scalar, -1, -1>::Identity(dim, dim));
+    sym += identity;
+    exact = sym.constructEigenMatrix().template cast<ComputeScalar>();
+    if (sym.isFactorizationCached()
+        || relativeResidual(exact, b, sym.solve(b)) > precision) {
+        return 1;
+    }
+
+    // Taking and reading views keeps the factor
+    std::vector<int> indices(2);
+    indices[0] = dim - 1;
+    indices[1] = 0;
+    sym.solve(b);
+    const Eigen::Matrix<Scalar, -1, -1> sub
+        = sym.principal(indices).constructEigenMatrix();
+    const Eigen::Matrix<Scalar, -1, -1> top
+        = sym.topLeftCorner(2).constructEigenMatrix();
+    if (!sym.isFactorizationCached()
+        || sub(0, 1) != sym.constructEigenMatrix()(dim - 1, 0)
+        || top(1, 0) != sym.constructEigenMatrix()(1, 0)) {
+        return 1;
+    }
+
+    // Writes through a view obtained before the last query
+    SymmetricMatrixView<Scalar, ComputeScalar> corner = sym.topLeftCorner(2);
+    sym.solve(b);
+    corner(1, 1) += Scalar(1);
+    exact = sym.constructEigenMatrix().template cast<ComputeScalar>();
+    if (sym.isFactorizationCached()
+        || relativeResidual(exact, b, sym.solve(b)) > precision) {
+        return 1;
+    }
+
+    // Copies keep their own cache, disabling releases it
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> copy(sym);
+    sym.cacheFactorization(false);
+    if (!copy.isFactorizationCached() || sym.isFactorizationCached()
+        || relativeResidual(exact, b, copy.solve(b)) > precision
+        || relativeResidual(exact, b, sym.solve(b)) > precision
+        || sym.isFactorizationCached()) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * The cache also remembers that a matrix is not positive definite. Solves
+ * return NaN while the determinant falls back to the expanded matrix.
+ */
+int TEST_CACHED_INDEFINITE() {
+    Eigen::MatrixXd mat = Eigen::MatrixXd::Random(8, 8);
+    mat = (mat + mat.transpose()).eval();
+    mat(0, 0) = -1.0;
+    SymmetricMatrix<double> sym(mat);
+    sym.cacheFactorization();
+    const Eigen::VectorXd b = Eigen::VectorXd::Random(8);
+    const bool positiveDefinite = sym.isPositiveDefinite();
+    return (!positiveDefinite && sym.isFactorizationCached()
+            && sym.solve(b).hasNaN() && std::isnan(sym.chi2(b))
+            && std::abs(sym.determinant() - mat.determinant())
+               < 1e-10 * std::abs(mat.determinant())) ? 0 : 1;
+}
+
+/**
+ * V f(L) V^T of a symmetric Eigen::Matrix with the function f applied to
+ * every eigenvalue
+ */
+template<typename Scalar, int Dimension, typename Op>
+Eigen::Matrix<Scalar, Dimension, Dimension>
+denseMatrixFunction(const Eigen::Matrix<Scalar, Dimension, Dimension>& mat,
+                    const Op& op) {
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix<Scalar, Dimension, Dimension> >
+        solver(mat);
+    return solver.eigenvectors()
+        * solver.eigenvalues().unaryExpr(op).asDiagonal()
+        * solver.eigenvectors().transpose();
+}
+
+/**
+ * Square root, inverse square root, exponential and logarithm of a positive
+ * definite matrix against the same functions of the dense eigendecomposition
+ */
+template<typename Scalar, int Dimension, typename ComputeScalar>
+int TEST_MATRIX_FUNCTIONS(int dim = Dimension) {
+    typedef Eigen::Matrix<ComputeScalar, -1, -1> Matrix;
+    const Eigen::Matrix<Scalar, Dimension, Dimension> stored
+        = randomPositiveDefinite<Scalar, Dimension>(dim);
+    const Matrix mat = stored.template cast<ComputeScalar>();
+    SymmetricMatrix<Scalar, Dimension, ComputeScalar> sym(stored);
+    const ComputeScalar precision
+        = std::sqrt(Eigen::NumTraits<Scalar>::epsilon());
+    const Matrix root = sym.sqrt().constructEigenMatrix()
+        .template cast<ComputeScalar>();
+    const Matrix inverseRoot = sym.inverseSqrt().constructEigenMatrix()
+        .template cast<ComputeScalar>();
+    const Matrix logarithm = sym.log().constructEigenMatrix()
+        .template cast<ComputeScalar>();
+    const Matrix exponential = sym.log().exp().constructEigenMatrix()
+        .template cast<ComputeScalar>();
+    if (!(root * root).isApprox(mat, precision)
+        || !(inverseRoot * mat * inverseRoot).isIdentity(precision)
+        || !logarithm.isApprox(denseMatrixFunction<ComputeScalar, -1>(mat,
+            Eigen::internal::scalar_log_op<ComputeScalar>()), precision)
+        || !exponential.isApprox(mat, precision)) {
+        return 1;
+    }
+    return 0;
+}
+
+int main() {
+    std::vector<int> position(3);
+    position[0] = 0;
+    position[1] = 1;
+    position[2] = 2;
+    std::vector<int> unsorted(2);
+    unsorted[0] = 4;
+    unsorted[1] = 1;
+    std::vector<int> all;
+    for (int i = 0; i < 5; ++i) {
+        all.push_back(i);
+    }
+
+    std::cout << "Testing Schur complement...\n";
+    std::cout << "[TEST_SCHUR_SYMF][double][6]"
+              << ((!TEST_SCHUR_SYMF<double, 6>(position))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_SCHUR_SYMF][float][5]"
+              << ((!TEST_SCHUR_SYMF<float, 5>(unsorted))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_SCHUR_SYMF][double][5]"
+              << ((!TEST_SCHUR_SYMF<double, 5>(all))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_SCHUR_SYMD][double][10]"
+              << ((!TEST_SCHUR_SYMD<double, 10>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_SCHUR_SYMD][double][100]"
+              << ((!TEST_SCHUR_SYMD<double, 100>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_SCHUR_FAIL][double][5]"
+              << ((!TEST_SCHUR_FAIL())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing eigendecomposition...\n";
+    std::cout << "[TEST_EIGEN_SYMF][double][2]"
+              << ((!TEST_EIGEN_SYMF<double, 2>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EIGEN_SYMF][double][6]"
+              << ((!TEST_EIGEN_SYMF<double, 6>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EIGEN_SYMF][float][5]"
+              << ((!TEST_EIGEN_SYMF<float, 5>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EIGEN_SYMD][double][1]"
+              << ((!TEST_EIGEN_SYMD<double, double, 1>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EIGEN_SYMD][double][100]"
+              << ((!TEST_EIGEN_SYMD<double, double, 100>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EIGEN_SYMD][float/double][50]"
+              << ((!TEST_EIGEN_SYMD<float, double, 50>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EIGEN_DIRECT][double][2]"
+              << ((!TEST_EIGEN_DIRECT<double, 2>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EIGEN_DIRECT][double][3]"
+              << ((!TEST_EIGEN_DIRECT<double, 3>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EIGEN_DIRECT][float][3]"
+              << ((!TEST_EIGEN_DIRECT<float, 3>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EIGEN_DIRECT_BATCH][double][2]"
+              << ((!TEST_EIGEN_DIRECT_BATCH<double, 2>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EIGEN_DIRECT_BATCH][double][3]"
+              << ((!TEST_EIGEN_DIRECT_BATCH<double, 3>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EIGEN_DIRECT_BATCH][float][3]"
+              << ((!TEST_EIGEN_DIRECT_BATCH<float, 3>())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing LDLT factorization...\n";
+    std::cout << "[TEST_LDLT_SYMF][double][2]"
+              << ((!TEST_LDLT_SYMF<double, 2>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_LDLT_SYMF][double][7]"
+              << ((!TEST_LDLT_SYMF<double, 7>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_LDLT_SYMF][float][5]"
+              << ((!TEST_LDLT_SYMF<float, 5>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_LDLT_KKT][double][10+4]"
+              << ((!TEST_LDLT_KKT<double, double, 10, 4>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_LDLT_KKT][double][100+30]"
+              << ((!TEST_LDLT_KKT<double, double, 100, 30>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_LDLT_KKT][float/double][50+10]"
+              << ((!TEST_LDLT_KKT<float, double, 50, 10>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_LDLT_SINGULAR][double][6]"
+              << ((!TEST_LDLT_SINGULAR())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing Cholesky update...\n";
+    std::cout << "[TEST_CHOLESKY_UPDATE][double][1]"
+              << ((!TEST_CHOLESKY_UPDATE<double, double>(1))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CHOLESKY_UPDATE][double][7]"
+              << ((!TEST_CHOLESKY_UPDATE<double, double>(7))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CHOLESKY_UPDATE][double][100]"
+              << ((!TEST_CHOLESKY_UPDATE<double, double>(100))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CHOLESKY_UPDATE][float/double][30]"
+              << ((!TEST_CHOLESKY_UPDATE<float, double>(30))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CHOLESKY_DOWNDATE_FAIL][double][6]"
+              << ((!TEST_CHOLESKY_DOWNDATE_FAIL())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing cached factorization...\n";
+    std::cout << "[TEST_CACHED_FACTORIZATION][double][5]"
+              << ((!TEST_CACHED_FACTORIZATION<double, double>(5))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CACHED_FACTORIZATION][double][60]"
+              << ((!TEST_CACHED_FACTORIZATION<double, double>(60))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CACHED_FACTORIZATION][float/double][20]"
+              << ((!TEST_CACHED_FACTORIZATION<float, double>(20))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CACHED_INDEFINITE][double][8]"
+              << ((!TEST_CACHED_INDEFINITE())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing matrix functions...\n";
+    std::cout << "[TEST_MATRIX_FUNCTIONS][double][2]"
+              << ((!TEST_MATRIX_FUNCTIONS<double, 2, double>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_MATRIX_FUNCTIONS][double][3]"
+              << ((!TEST_MATRIX_FUNCTIONS<double, 3, double>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_MATRIX_FUNCTIONS][float/double][3]"
+              << ((!TEST_MATRIX_FUNCTIONS<float, 3, double>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_MATRIX_FUNCTIONS][double][6]"
+              << ((!TEST_MATRIX_FUNCTIONS<double, 6, double>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_MATRIX_FUNCTIONS][double][50]"
+              << ((!TEST_MATRIX_FUNCTIONS<double, -1, double>(50))?" => PASSED\n":" => FAIL\n");
+}
@@ -0,0 +1,177 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Test - Expression                                                          *
+ *  Instances of SymmetricMatrix as operands of Eigen expressions              *
+ ******************************************************************************/
+
+#include <iostream>
+
+#include <SymmetricMatrix.h>
+#include <eigen3/Eigen/Eigen>
+
+/**
+ * Make an instance of Eigen::Matrix symmetric
+ */
+template<typename Scalar, int Dimension>
+void makeSymmetric(Eigen::Matrix<Scalar, Dimension, Dimension>& mat) {
+    for (int i = 0; i < mat.rows(); ++i) {
+        for (int j = i; j < mat.cols(); ++j) {
+            mat(i, j) = mat(j, i);
+        }
+    }
+}
+
+/**
+ * Assignment of symmetric matrices of fixed and dynamic size to
+ * Eigen::Matrix, which reads the packed storage through the evaluator
+ */
+template<typename Scalar, int Dimension>
+int TEST_EXPRESSION_ASSIGN() {
+    Eigen::Matrix<Scalar, Dimension, Dimension> mat
+        = Eigen::Matrix<Scalar, Dimension, Dimension>::Random();
+    makeSymmetric<Scalar, Dimension>(mat);
+    const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> dense = mat;
+    const SymmetricMatrix<Scalar, Dimension> fixed(mat);
+    const SymmetricMatrix<Scalar> dyn(dense);
+
+    Eigen::Matrix<Scalar, Dimension, Dimension> fromFixed = fixed;
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> fromDyn = dyn;
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> lower(Dimension,
+                                                                Dimension);
+    lower.setZero();
+    lower.template triangularView<Eigen::Lower>() = dyn;
+    if (fromFixed != mat || fromDyn != mat
+        || lower != Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>(
+               dense.template triangularView<Eigen::Lower>())) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Coefficient-wise expressions, blocks and reductions of a symmetric matrix
+ * of dynamic size
+ */
+template<typename Scalar, int Dimension>
+int TEST_EXPRESSION_SUM() {
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> Matrix;
+    Matrix mat = Matrix::Random(Dimension, Dimension);
+    makeSymmetric<Scalar, Eigen::Dynamic>(mat);
+    const Matrix other = Matrix::Random(Dimension, Dimension);
+    SymmetricMatrix<Scalar> sym(mat);
+    const SymmetricMatrix<Scalar>& csym = sym;
+
+    Matrix sum = other + sym;
+    Matrix diff = sym - Scalar(2) * other.transpose();
+    Matrix scaled = csym * Scalar(3) + other;
+    Matrix negated = -csym;
+    if (sum != other + mat
+        || diff != mat - Scalar(2) * other.transpose()
+        || scaled != mat * Scalar(3) + other
+        || negated != -mat
+        || Matrix(sym.block(1, 2, Dimension - 3, Dimension - 2))
+            != mat.block(1, 2, Dimension - 3, Dimension - 2)
+        || Matrix(sym.col(Dimension / 2)) != mat.col(Dimension / 2)
+        || Matrix(sym.diagonal()) != mat.diagonal()
+        || sym.trace() != mat.trace()
+        || sym.maxCoeff() != mat.maxCoeff()) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Products of a symmetric matrix of dynamic size with vectors and matrices
+ */
+template<typename Scalar, typename ComputeScalar>
+int TEST_EXPRESSION_PRODUCT(int dim) {
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> Matrix;
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> Vector;
+    typedef Eigen::Matrix<Scalar, 1, Eigen::Dynamic> RowVector;
+    const Scalar precision = Eigen::NumTraits<Scalar>::dummy_precision();
+    Matrix mat = Matrix::Random(dim, dim);
+    makeSymmetric<Scalar, Eigen::Dynamic>(mat);
+    const Matrix other = Matrix::Random(dim, 3);
+    const Vector x = Vector::Random(dim);
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> sym(mat);
+    const SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar>& csym = sym;
+
+    Vector y(dim);
+    y.noalias() = sym * x;
+    if (!y.isApprox(mat * x, precision)) {
+        return 1;
+    }
+    y.noalias() += Scalar(2) * (csym * x);
+    y.noalias() -= csym * other.col(1);
+    if (!y.isApprox(Scalar(3) * (mat * x) - mat * other.col(1), precision)) {
+        return 1;
+    }
+    const RowVector r = x.transpose() * sym;
+    const Matrix right = csym * other;
+    const Matrix left = other.transpose() * csym;
+    if (!r.isApprox(x.transpose() * mat, precision)
+        || !right.isApprox(mat * other, precision)
+        || !left.isApprox(other.transpose() * mat, precision)) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Products of a symmetric matrix of fixed size, which Eigen evaluates
+ * coefficient by coefficient
+ */
+template<typename Scalar, int Dimension>
+int TEST_EXPRESSION_PRODUCT_FIXED() {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    typedef Eigen::Matrix<Scalar, Dimension, 1> Vector;
+    const Scalar precision = Eigen::NumTraits<Scalar>::dummy_precision();
+    Matrix mat = Matrix::Random();
+    makeSymmetric<Scalar, Dimension>(mat);
+    const Matrix other = Matrix::Random();
+    const Vector x = Vector::Random();
+    SymmetricMatrix<Scalar, Dimension> sym(mat);
+    const SymmetricMatrix<Scalar, Dimension>& csym = sym;
+
+    const Vector y = sym * x;
+    const Matrix left = other * csym;
+    const Matrix right = csym * other;
+    if (!y.isApprox(mat * x, precision)
+        || !left.isApprox(other * mat, precision)
+        || !right.isApprox(mat * other, precision)) {
+        return 1;
+    }
+    return 0;
+}
+
+int main() {
+    std::cout << "Testing assignment to Eigen::Matrix...\n";
+    std::cout << "[TEST_EXPRESSION_ASSIGN][int][5]"
+              << ((!TEST_EXPRESSION_ASSIGN<int, 5>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EXPRESSION_ASSIGN][float][17]"
+              << ((!TEST_EXPRESSION_ASSIGN<float, 17>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EXPRESSION_ASSIGN][double][16]"
+              << ((!TEST_EXPRESSION_ASSIGN<double, 16>())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing coefficient-wise expressions...\n";
+    std::cout << "[TEST_EXPRESSION_SUM][int][10]"
+              << ((!TEST_EXPRESSION_SUM<int, 10>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EXPRESSION_SUM][double][33]"
+              << ((!TEST_EXPRESSION_SUM<double, 33>())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing products...\n";
+    std::cout << "[TEST_EXPRESSION_PRODUCT][double][1]"
+              << ((!TEST_EXPRESSION_PRODUCT<double, double>(1))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EXPRESSION_PRODUCT][double][101]"
+              << ((!TEST_EXPRESSION_PRODUCT<double, double>(101))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EXPRESSION_PRODUCT][float/double][100]"
+              << ((!TEST_EXPRESSION_PRODUCT<float, double>(100))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EXPRESSION_PRODUCT_FIXED][double][4]"
+              << ((!TEST_EXPRESSION_PRODUCT_FIXED<double, 4>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_EXPRESSION_PRODUCT_FIXED][float][7]"
+              << ((!TEST_EXPRESSION_PRODUCT_FIXED<float, 7>())?" => PASSED\n":" => FAIL\n");
+}
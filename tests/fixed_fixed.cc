@@ -10,6 +10,7 @@
 
 #include <iostream>
 #include <functional>
+#include <vector>
 
 #include <SymmetricMatrix.h>
 #include <eigen3/Eigen/Eigen>
@@ -66,6 +67,103 @@ int TEST_MULT_SYMF_SYMF(const Eigen::Matrix<Scalar, Dimension, Dimension>& mat1,
     return 1;
 }
 
+/**
+ * Square, powers and Gram matrix of symmetric matrices of fixed size, which
+ * are computed as packed results
+ */
+template<typename Scalar, int Dimension>
+int TEST_POW_SYMF(const Eigen::Matrix<Scalar, Dimension, Dimension>& mat1,
+                  const Eigen::Matrix<Scalar, Dimension, Dimension>& mat2) {
+    const typename Eigen::NumTraits<Scalar>::Real precision
+        = Eigen::NumTraits<Scalar>::dummy_precision();
+    SymmetricMatrix<Scalar, Dimension> symmat(mat1);
+    const Eigen::Matrix<Scalar, -1, -1> factor
+        = mat2.leftCols(Dimension / 2 + 1);
+    Eigen::Matrix<Scalar, Dimension, Dimension> square = symmat.square();
+    Eigen::Matrix<Scalar, Dimension, Dimension> cube = symmat.pow(3);
+    Eigen::Matrix<Scalar, Dimension, Dimension> power = symmat.pow(6);
+    Eigen::Matrix<Scalar, Dimension, Dimension> identity = symmat.pow(0);
+    Eigen::Matrix<Scalar, Dimension, Dimension> gram
+        = SymmetricMatrix<Scalar, Dimension>::gram(factor);
+
+    if (square.isApprox(mat1 * mat1, precision)
+        && cube.isApprox(mat1 * mat1 * mat1, precision)
+        && power.isApprox(mat1 * mat1 * mat1 * mat1 * mat1 * mat1, precision)
+        && identity.isIdentity()
+        && gram.isApprox(factor * factor.transpose(), precision)) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Scaled addition, damping and linear combinations of symmetric matrices of
+ * fixed size
+ */
+template<typename Scalar, int Dimension>
+int TEST_AXPBY_SYMF(const Eigen::Matrix<Scalar, Dimension, Dimension>& mat1,
+                   const Eigen::Matrix<Scalar, Dimension, Dimension>& mat2) {
+    const Scalar alpha(2);
+    const Scalar beta(3);
+    const Scalar lambda(5);
+    SymmetricMatrix<Scalar, Dimension> symmat1(mat1);
+    SymmetricMatrix<Scalar, Dimension> symmat2(mat2);
+    SymmetricMatrix<Scalar, Dimension> symres(mat1);
+    symres.axpby(alpha, symmat2, beta);
+    Eigen::Matrix<Scalar, Dimension, Dimension> axpby = symres.constructEigenMatrix();
+    symres.addDiagonal(lambda);
+    Eigen::Matrix<Scalar, Dimension, Dimension> damped = symres.constructEigenMatrix();
+
+    std::vector<Scalar> coefficients(3);
+    coefficients[0] = alpha;
+    coefficients[1] = -beta;
+    coefficients[2] = lambda;
+    std::vector<const SymmetricMatrix<Scalar, Dimension>*> matrices(3);
+    matrices[0] = &symmat1;
+    matrices[1] = &symmat2;
+    matrices[2] = &symmat1;
+    Eigen::Matrix<Scalar, Dimension, Dimension> combination
+        = SymmetricMatrix<Scalar, Dimension>::linearCombination(
+            coefficients, matrices).constructEigenMatrix();
+
+    Eigen::Matrix<Scalar, Dimension, Dimension> identity = Eigen::Matrix<Scalar, Dimension, Dimension>::Identity(Dimension, Dimension);
+    coefficients.clear();
+    matrices.clear();
+    SymmetricMatrix<Scalar, Dimension> empty
+        = SymmetricMatrix<Scalar, Dimension>::linearCombination(coefficients,
+                                                                matrices);
+    if (axpby == alpha * mat2 + beta * mat1
+        && damped == alpha * mat2 + beta * mat1 + lambda * identity
+        && combination == alpha * mat1 - beta * mat2 + lambda * mat1
+        && empty.constructEigenMatrix().isZero()) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Trace, trace of products and Frobenius inner product of symmetric matrices
+ * of fixed size
+ */
+template<typename Scalar, int Dimension>
+int TEST_TRACE_SYMF(const Eigen::Matrix<Scalar, Dimension, Dimension>& mat1,
+                    const Eigen::Matrix<Scalar, Dimension, Dimension>& mat2) {
+    const typename Eigen::NumTraits<Scalar>::Real precision
+        = Eigen::NumTraits<Scalar>::dummy_precision() * mat1.norm()
+          * mat2.norm();
+    SymmetricMatrix<Scalar, Dimension> symmat1(mat1);
+    SymmetricMatrix<Scalar, Dimension> symmat2(mat2);
+
+    if (std::abs(symmat1.trace() - mat1.trace()) <= precision
+        && std::abs(symmat1.traceOfProduct(symmat2) - (mat1 * mat2).trace())
+           <= precision
+        && std::abs(symmat1.frobeniusDot(symmat2)
+                    - (mat1.adjoint() * mat2).trace()) <= precision) {
+        return 0;
+    }
+    return 1;
+}
+
 /**
  * Make an instance of Eigen::Matrix symmetric
  */
@@ -203,6 +301,32 @@ int main() {
               << ((!runTest<std::complex<double>, 10>(TEST_MULT_SYMF_SYMF<std::complex<double>, 10>))?" => PASSED\n":" => FAIL\n");
     std::cout << "[TEST_MULT_SYMF_SYMF][std::complex<double>][50]"
               << ((!runTest<std::complex<double>, 50>(TEST_MULT_SYMF_SYMF<std::complex<double>, 50>))?" => PASSED\n":" => FAIL\n");
-}
 
+    std::cout << "Testing powers...\n";
+    std::cout << "[TEST_POW_SYMF][float][10]"
+              << ((!runTest<float, 10>(TEST_POW_SYMF<float, 10>))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_POW_SYMF][double][10]"
+              << ((!runTest<double, 10>(TEST_POW_SYMF<double, 10>))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_POW_SYMF][double][50]"
+              << ((!runTest<double, 50>(TEST_POW_SYMF<double, 50>))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_POW_SYMF][std::complex<double>][10]"
+              << ((!runTest<std::complex<double>, 10>(TEST_POW_SYMF<std::complex<double>, 10>))?" => PASSED\n":" => FAIL\n");
 
+    std::cout << "Testing scaled addition...\n";
+    std::cout << "[TEST_AXPBY_SYMF][int][10]"
+              << ((!runTest<int, 10>(TEST_AXPBY_SYMF<int, 10>))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_AXPBY_SYMF][int][50]"
+              << ((!runTest<int, 50>(TEST_AXPBY_SYMF<int, 50>))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_AXPBY_SYMF][std::complex<int>][10]"
+              << ((!runTest<std::complex<int>, 10>(TEST_AXPBY_SYMF<std::complex<int>, 10>))?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing traces...\n";
+    std::cout << "[TEST_TRACE_SYMF][float][10]"
+              << ((!runTest<float, 10>(TEST_TRACE_SYMF<float, 10>))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_TRACE_SYMF][double][10]"
+              << ((!runTest<double, 10>(TEST_TRACE_SYMF<double, 10>))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_TRACE_SYMF][double][50]"
+              << ((!runTest<double, 50>(TEST_TRACE_SYMF<double, 50>))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_TRACE_SYMF][std::complex<double>][10]"
+              << ((!runTest<std::complex<double>, 10>(TEST_TRACE_SYMF<std::complex<double>, 10>))?" => PASSED\n":" => FAIL\n");
+}
@@ -0,0 +1,393 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Test - Kalman                                                              *
+ *  Kalman filter kernels on packed covariances                                *
+*******************************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include <SymmetricMatrixKalman.h>
+#include <eigen3/Eigen/Eigen>
+
+#include "test_helpers.h"
+
+/**
+ * Measurement update on packed covariances compared with the dense formulas
+ */
+template<typename Scalar, int StateDim, int MeasDim>
+int TEST_KALMAN_UPDATE(KalmanUpdateForm form) {
+    typedef Eigen::Matrix<Scalar, StateDim, StateDim> StateMatrix;
+    typedef Eigen::Matrix<Scalar, MeasDim, MeasDim> MeasMatrix;
+    StateMatrix C = randomPositiveDefinite<Scalar, StateDim>();
+    MeasMatrix V = randomPositiveDefinite<Scalar, MeasDim>();
+    Eigen::Matrix<Scalar, MeasDim, StateDim> H
+        = Eigen::Matrix<Scalar, MeasDim, StateDim>::Random();
+    Eigen::Matrix<Scalar, StateDim, 1> x
+        = Eigen::Matrix<Scalar, StateDim, 1>::Random();
+    Eigen::Matrix<Scalar, MeasDim, 1> m
+        = Eigen::Matrix<Scalar, MeasDim, 1>::Random();
+
+    Eigen::Matrix<Scalar, MeasDim, 1> r = m - H * x;
+    MeasMatrix S = H * C * H.transpose() + V;
+    Eigen::Matrix<Scalar, StateDim, MeasDim> K
+        = C * H.transpose() * S.inverse();
+    Eigen::Matrix<Scalar, StateDim, 1> xUpdated = x + K * r;
+    StateMatrix CUpdated = C - K * H * C;
+    Scalar chi2 = r.dot(S.inverse() * r);
+
+    SymmetricMatrix<Scalar, StateDim> symC(C);
+    SymmetricMatrix<Scalar, MeasDim> symV(V);
+    KalmanUpdate<Scalar, StateDim, MeasDim> update(symC, x, H, symV, m, form);
+    SymmetricMatrix<Scalar, StateDim> symres = update.covariance();
+
+    if (update.info() == Eigen::Success
+        && update.gain().isApprox(K)
+        && update.state().isApprox(xUpdated)
+        && symres.constructEigenMatrix().isApprox(CUpdated)
+        && std::abs(update.chi2() - chi2)
+               <= Eigen::NumTraits<Scalar>::dummy_precision() * std::abs(chi2)) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Measurement update with a residual covariance that is not positive definite
+ */
+int TEST_KALMAN_UPDATE_FAIL() {
+    SymmetricMatrix<double, 5> C = SymmetricMatrix<double, 5>::Zero();
+    SymmetricMatrix<double, 2> V = SymmetricMatrix<double, 2>::Zero();
+    V(0, 0) = -1.0;
+    V(1, 1) = 1.0;
+    KalmanUpdate<double, 5, 2> update(C, Eigen::Matrix<double, 5, 1>::Zero(),
+                                      Eigen::Matrix<double, 2, 5>::Identity(),
+                                      V, Eigen::Matrix<double, 2, 1>::Zero());
+    return (update.info() == Eigen::NumericalIssue) ? 0 : 1;
+}
+
+/**
+ * Default constructed update that was never computed
+ */
+int TEST_KALMAN_UPDATE_EMPTY() {
+    KalmanUpdate<double, 5, 2> update;
+    return (update.info() == Eigen::InvalidInput && update.chi2() == 0.0)
+        ? 0 : 1;
+}
+
+/**
+ * Round trip of symmetric matrices through a structure of arrays batch
+ */
+int TEST_BATCH_ROUNDTRIP() {
+    std::vector<SymmetricMatrix<double, 5> > mats;
+    for (int i = 0; i < 7; ++i) {
+        mats.push_back(SymmetricMatrix<double, 5>(
+            randomPositiveDefinite<double, 5>()));
+    }
+    SymmetricMatrixBatch<double, 5> batch(mats);
+    std::vector<SymmetricMatrix<double, 5> > res = batch.toMatrices();
+    for (int i = 0; i < 7; ++i) {
+        if (res[i].constructEigenMatrix() != mats[i].constructEigenMatrix()
+            || batch.element(3)[i] != mats[i].data()[3]) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Prediction and update of many tracks at once compared with KalmanUpdate on
+ * every single track. The number of tracks is no multiple of the SIMD width
+ * so that both the vectorized blocks and the scalar tail are tested.
+ */
+template<typename Scalar, int StateDim, int MeasDim>
+int TEST_BATCH_KALMAN(KalmanUpdateForm form) {
+    typedef BatchKalmanFilter<Scalar, StateDim, MeasDim> Filter;
+    typedef Eigen::Matrix<Scalar, StateDim, StateDim> StateMatrix;
+    typedef Eigen::Matrix<Scalar, MeasDim, StateDim> ProjectionMatrix;
+    const size_t count = 37;
+
+    Filter filter(count);
+    typename Filter::JacobianBatch F(StateDim * StateDim, count);
+    typename Filter::CovarianceBatch Q(count);
+    typename Filter::ProjectionBatch H(MeasDim * StateDim, count);
+    typename Filter::MeasurementCovarianceBatch V(count);
+    typename Filter::MeasurementBatch m(MeasDim, count);
+    std::vector<StateMatrix> denseF(count);
+    std::vector<ProjectionMatrix> denseH(count);
+
+    for (size_t t = 0; t < count; ++t) {
+        filter.setTrack(t, Eigen::Matrix<Scalar, StateDim, 1>::Random(),
+                        SymmetricMatrix<Scalar, StateDim>(
+                            randomPositiveDefinite<Scalar, StateDim>()));
+        denseF[t] = StateMatrix::Identity()
+            + Scalar(0.1) * StateMatrix::Random();
+        denseH[t] = ProjectionMatrix::Random();
+        Q.set(t, SymmetricMatrix<Scalar, StateDim>(
+            randomPositiveDefinite<Scalar, StateDim>()));
+        V.set(t, SymmetricMatrix<Scalar, MeasDim>(
+            randomPositiveDefinite<Scalar, MeasDim>()));
+        m.col(t) = Eigen::Matrix<Scalar, MeasDim, 1>::Random();
+        for (int r = 0; r < StateDim; ++r) {
+            for (int c = 0; c < StateDim; ++c) {
+                F(r * StateDim + c, t) = denseF[t](r, c);
+            }
+        }
+        for (int a = 0; a < MeasDim; ++a) {
+            for (int k = 0; k < StateDim; ++k) {
+                H(a * StateDim + k, t) = denseH[t](a, k);
+            }
+        }
+    }
+
+    // Reference: predict with dense matrices, update with KalmanUpdate
+    std::vector<KalmanUpdate<Scalar, StateDim, MeasDim> > reference;
+    for (size_t t = 0; t < count; ++t) {
+        StateMatrix C = denseF[t] * filter.covariance(t).constructEigenMatrix()
+            * denseF[t].transpose() + Q.get(t).constructEigenMatrix();
+        Eigen::Matrix<Scalar, StateDim, 1> x = denseF[t] * filter.state(t);
+        SymmetricMatrix<Scalar, StateDim> symC(C);
+        SymmetricMatrix<Scalar, MeasDim> symV = V.get(t);
+        Eigen::Matrix<Scalar, MeasDim, 1> mt = m.col(t);
+        reference.push_back(KalmanUpdate<Scalar, StateDim, MeasDim>(
+            symC, x, denseH[t], symV, mt, form));
+    }
+
+    filter.predict(F, Q);
+    filter.update(H, V, m, form);
+
+    for (size_t t = 0; t < count; ++t) {
+        SymmetricMatrix<Scalar, StateDim> cov = filter.covariance(t);
+        SymmetricMatrix<Scalar, StateDim> refCov = reference[t].covariance();
+        if (filter.info(t) != Eigen::Success
+            || !filter.state(t).isApprox(reference[t].state())
+            || !cov.constructEigenMatrix().isApprox(
+                   refCov.constructEigenMatrix())
+            || std::abs(filter.chi2()(t) - reference[t].chi2())
+                   > Eigen::NumTraits<Scalar>::dummy_precision()
+                     * std::abs(reference[t].chi2())) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Tracks whose residual covariance is not positive definite keep their
+ * predicted values while all other tracks are updated
+ */
+int TEST_BATCH_KALMAN_FAIL() {
+    typedef BatchKalmanFilter<double, 5, 2> Filter;
+    const size_t count = 11;
+    Filter filter(count);
+    Filter::ProjectionBatch H(10, count);
+    Filter::MeasurementCovarianceBatch V(count);
+    Filter::MeasurementBatch m = Filter::MeasurementBatch::Ones(2, count);
+    H.setZero();
+    H.row(0).setOnes();
+    H.row(6).setOnes();
+    for (size_t t = 0; t < count; ++t) {
+        filter.setTrack(t, Eigen::Matrix<double, 5, 1>::Zero(),
+                        SymmetricMatrix<double, 5>(
+                            Eigen::Matrix<double, 5, 5>(
+                                Eigen::Matrix<double, 5, 5>::Identity())));
+        SymmetricMatrix<double, 2> v = SymmetricMatrix<double, 2>::Zero();
+        v(0, 0) = (t % 3 == 0) ? -2.0 : 1.0;
+        v(1, 1) = 1.0;
+        V.set(t, v);
+    }
+    filter.update(H, V, m);
+    for (size_t t = 0; t < count; ++t) {
+        bool failed = (t % 3 == 0);
+        if ((filter.info(t) == Eigen::NumericalIssue) != failed
+            || (filter.state(t).isZero() != failed)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Weighted mean of two estimates compared with the formula using inverses
+ */
+template<typename Scalar, int Dimension>
+int TEST_COMBINE() {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    typedef Eigen::Matrix<Scalar, Dimension, 1> Vector;
+    Matrix C1 = randomPositiveDefinite<Scalar, Dimension>();
+    Matrix C2 = randomPositiveDefinite<Scalar, Dimension>();
+    Vector x1 = Vector::Random();
+    Vector x2 = Vector::Random();
+
+    Matrix C = (C1.inverse() + C2.inverse()).inverse();
+    Vector x = C * (C1.inverse() * x1 + C2.inverse() * x2);
+    Scalar chi2 = (x2 - x1).dot((C1 + C2).inverse() * (x2 - x1));
+
+    SymmetricMatrix<Scalar, Dimension> symC1(C1);
+    SymmetricMatrix<Scalar, Dimension> symC2(C2);
+    KalmanCombination<Scalar, Dimension> comb = combine(symC1, x1, symC2, x2);
+    SymmetricMatrix<Scalar, Dimension> symres = comb.covariance();
+
+    if (comb.info() == Eigen::Success
+        && comb.state().isApprox(x)
+        && symres.constructEigenMatrix().isApprox(C)
+        && std::abs(comb.chi2() - chi2)
+               <= Eigen::NumTraits<Scalar>::dummy_precision() * std::abs(chi2)) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Default constructed combination that was never computed
+ */
+int TEST_COMBINE_EMPTY() {
+    KalmanCombination<double, 5> comb;
+    return (comb.info() == Eigen::InvalidInput && comb.chi2() == 0.0)
+        ? 0 : 1;
+}
+
+/**
+ * Propagation through a chain of Jacobians compared with dense products
+ */
+template<typename Scalar, int Dimension>
+int TEST_PROPAGATE(int steps) {
+    typedef Eigen::Matrix<Scalar, Dimension, Dimension> Matrix;
+    Matrix C = randomPositiveDefinite<Scalar, Dimension>();
+    std::vector<Matrix> jacobians;
+    Matrix res = C;
+    for (int i = 0; i < steps; ++i) {
+        jacobians.push_back(Matrix::Identity()
+                            + Scalar(0.1) * Matrix::Random());
+        res = jacobians.back() * res * jacobians.back().transpose();
+    }
+
+    SymmetricMatrix<Scalar, Dimension> symC(C);
+    SymmetricMatrix<Scalar, Dimension> symres = propagate(symC, jacobians);
+    return symres.constructEigenMatrix().isApprox(res) ? 0 : 1;
+}
+
+/**
+ * Propagation of a covariance with float storage and double accumulation
+ */
+int TEST_PROPAGATE_MIXED() {
+    typedef Eigen::Matrix<double, 5, 5> Matrix;
+    SymmetricMatrix<float, 5, double> C
+        = SymmetricMatrix<double, 5>(randomPositiveDefinite<double, 5>())
+              .cast<float, double>();
+    std::vector<Matrix> jacobians;
+    Matrix res = C.constructEigenMatrix().cast<double>();
+    for (int i = 0; i < 4; ++i) {
+        jacobians.push_back(Matrix::Identity() + 0.1 * Matrix::Random());
+        res = jacobians.back() * res * jacobians.back().transpose();
+    }
+    SymmetricMatrix<float, 5, double> symres = propagate(C, jacobians);
+    return symres.constructEigenMatrix().isApprox(res.cast<float>(), 1e-6f)
+        ? 0 : 1;
+}
+
+/**
+ * Batched Kalman filter that stores floats and computes in double compared
+ * with the same filter on doubles
+ */
+int TEST_BATCH_KALMAN_MIXED() {
+    typedef BatchKalmanFilter<double, 5, 2> Filter;
+    typedef BatchKalmanFilter<float, 5, 2, double> MixedFilter;
+    const size_t count = 21;
+    Filter filter(count);
+    MixedFilter mixed(count);
+    Filter::MeasurementCovarianceBatch V(count);
+    Filter::ProjectionBatch H = Filter::ProjectionBatch::Random(10, count);
+    Filter::MeasurementBatch m = Filter::MeasurementBatch::Random(2, count);
+    for (size_t t = 0; t < count; ++t) {
+        SymmetricMatrix<float, 5, double> C
+            = SymmetricMatrix<double, 5>(randomPositiveDefinite<double, 5>())
+                  .cast<float, double>();
+        Eigen::Matrix<float, 5, 1> x = Eigen::Matrix<float, 5, 1>::Random();
+        mixed.setTrack(t, x, C);
+        filter.setTrack(t, x.cast<double>(), C.cast<double>());
+        V.set(t, SymmetricMatrix<double, 2>(
+            randomPositiveDefinite<double, 2>()));
+    }
+    // Use inputs that are exactly representable in single precision
+    V = V.cast<float>().cast<double>();
+    H = H.cast<float>().cast<double>();
+    m = m.cast<float>().cast<double>();
+
+    filter.update(H, V, m);
+    mixed.update(H.cast<float>(), V.cast<float, double>(), m.cast<float>());
+
+    for (size_t t = 0; t < count; ++t) {
+        SymmetricMatrix<double, 5> cov = filter.covariance(t);
+        SymmetricMatrix<float, 5, double> mixedCov = mixed.covariance(t);
+        if (mixed.info(t) != Eigen::Success
+            || !mixed.state(t).isApprox(filter.state(t).cast<float>(), 1e-6f)
+            || !mixedCov.constructEigenMatrix().isApprox(
+                   cov.constructEigenMatrix().cast<float>(), 1e-6f)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main() {
+    std::cout << "Testing measurement update...\n";
+    std::cout << "[TEST_KALMAN_UPDATE][double][5][1][Standard]"
+              << ((!TEST_KALMAN_UPDATE<double, 5, 1>(StandardForm))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_KALMAN_UPDATE][double][5][2][Standard]"
+              << ((!TEST_KALMAN_UPDATE<double, 5, 2>(StandardForm))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_KALMAN_UPDATE][double][5][2][Joseph]"
+              << ((!TEST_KALMAN_UPDATE<double, 5, 2>(JosephForm))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_KALMAN_UPDATE][double][6][3][Joseph]"
+              << ((!TEST_KALMAN_UPDATE<double, 6, 3>(JosephForm))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_KALMAN_UPDATE][float][5][2][Standard]"
+              << ((!TEST_KALMAN_UPDATE<float, 5, 2>(StandardForm))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_KALMAN_UPDATE_FAIL][double][5][2]"
+              << ((!TEST_KALMAN_UPDATE_FAIL())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_KALMAN_UPDATE_EMPTY][double][5][2]"
+              << ((!TEST_KALMAN_UPDATE_EMPTY())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing combination of estimates...\n";
+    std::cout << "[TEST_COMBINE][double][5]"
+              << ((!TEST_COMBINE<double, 5>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_COMBINE][double][6]"
+              << ((!TEST_COMBINE<double, 6>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_COMBINE][float][5]"
+              << ((!TEST_COMBINE<float, 5>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_COMBINE][double][3]"
+              << ((!TEST_COMBINE<double, 3>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_COMBINE_EMPTY][double][5]"
+              << ((!TEST_COMBINE_EMPTY())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing propagation through Jacobian chains...\n";
+    std::cout << "[TEST_PROPAGATE][double][5][0]"
+              << ((!TEST_PROPAGATE<double, 5>(0))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_PROPAGATE][double][5][1]"
+              << ((!TEST_PROPAGATE<double, 5>(1))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_PROPAGATE][double][5][8]"
+              << ((!TEST_PROPAGATE<double, 5>(8))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_PROPAGATE][float][6][3]"
+              << ((!TEST_PROPAGATE<float, 6>(3))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_PROPAGATE_MIXED][float/double][5][4]"
+              << ((!TEST_PROPAGATE_MIXED())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing batched Kalman filter...\n";
+    std::cout << "[TEST_BATCH_ROUNDTRIP][double][5]"
+              << ((!TEST_BATCH_ROUNDTRIP())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_BATCH_KALMAN][double][5][2][Standard]"
+              << ((!TEST_BATCH_KALMAN<double, 5, 2>(StandardForm))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_BATCH_KALMAN][double][5][2][Joseph]"
+              << ((!TEST_BATCH_KALMAN<double, 5, 2>(JosephForm))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_BATCH_KALMAN][float][5][2][Standard]"
+              << ((!TEST_BATCH_KALMAN<float, 5, 2>(StandardForm))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_BATCH_KALMAN][double][6][3][Joseph]"
+              << ((!TEST_BATCH_KALMAN<double, 6, 3>(JosephForm))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_BATCH_KALMAN_FAIL][double][5][2]"
+              << ((!TEST_BATCH_KALMAN_FAIL())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_BATCH_KALMAN_MIXED][float/double][5][2]"
+              << ((!TEST_BATCH_KALMAN_MIXED())?" => PASSED\n":" => FAIL\n");
+}
@@ -0,0 +1,313 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Test - Parallel                                                            *
+ *  Concurrent accumulation into instances of SymmetricMatrix                  *
+*******************************************************************************/
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <SymmetricMatrixParallel.h>
+#include <eigen3/Eigen/Eigen>
+
+#include "test_helpers.h"
+
+/**
+ * Indices of the k-th contribution of a thread. If disjoint is set, every
+ * thread only touches its own range of rows and columns.
+ */
+std::vector<int> contributionIndices(int dim, int thread, int nThreads, int k,
+                                     bool disjoint) {
+    std::vector<int> indices;
+    int offset = disjoint ? thread * (dim / nThreads) : 0;
+    int range = disjoint ? dim / nThreads : dim;
+    for (int i = 0; i < 5; ++i) {
+        indices.push_back(offset + (k * 7 + i * (range / 5)) % range);
+    }
+    return indices;
+}
+
+/**
+ * Sum up small symmetric contributions from several threads and compare the
+ * result with a serial sum
+ */
+template<typename Scalar>
+int TEST_ACCUMULATE(int dim, int nThreads, AccumulationMode mode,
+                    bool disjoint) {
+    const int nContributions = 200;
+    Eigen::Matrix<Scalar, 5, 5> block;
+    block << 1, 2, 3, 4, 5,
+             2, 6, 7, 8, 9,
+             3, 7, 10, 11, 12,
+             4, 8, 11, 13, 14,
+             5, 9, 12, 14, 15;
+
+    Eigen::Matrix<Scalar, -1, -1> res
+        = Eigen::Matrix<Scalar, -1, -1>::Zero(dim, dim);
+    for (int thread = 0; thread < nThreads; ++thread) {
+        for (int k = 0; k < nContributions; ++k) {
+            std::vector<int> indices
+                = contributionIndices(dim, thread, nThreads, k, disjoint);
+            for (int a = 0; a < 5; ++a) {
+                for (int b = 0; b < 5; ++b) {
+                    res(indices[a], indices[b]) += block(a, b);
+                }
+            }
+        }
+    }
+
+    SymmetricMatrixAccumulator<Scalar> acc(dim, nThreads, mode);
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < nThreads; ++thread) {
+        threads.push_back(std::thread([&, thread]() {
+            for (int k = 0; k < nContributions; ++k) {
+                acc.local(thread).addBlock(
+                    contributionIndices(dim, thread, nThreads, k, disjoint),
+                    block);
+            }
+        }));
+    }
+    for (int thread = 0; thread < nThreads; ++thread) {
+        threads[thread].join();
+    }
+    SymmetricMatrix<Scalar> symres = acc.reduce();
+
+    if (symres.constructEigenMatrix() == res) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Scatter small symmetric contributions from several threads into one shared
+ * matrix and compare the result with a serial sum
+ */
+template<typename Scalar>
+int TEST_SCATTER(int dim, int nThreads, ScatterMode mode) {
+    const int nContributions = 200;
+    Eigen::Matrix<Scalar, 5, 5> block;
+    block << 1, 2, 3, 4, 5,
+             2, 6, 7, 8, 9,
+             3, 7, 10, 11, 12,
+             4, 8, 11, 13, 14,
+             5, 9, 12, 14, 15;
+
+    Eigen::Matrix<Scalar, -1, -1> res
+        = Eigen::Matrix<Scalar, -1, -1>::Zero(dim, dim);
+    for (int thread = 0; thread < nThreads; ++thread) {
+        for (int k = 0; k < nContributions; ++k) {
+            std::vector<int> indices
+                = contributionIndices(dim, thread, nThreads, k, false);
+            for (int a = 0; a < 5; ++a) {
+                for (int b = 0; b < 5; ++b) {
+                    res(indices[a], indices[b]) += block(a, b);
+                }
+            }
+        }
+    }
+
+    SymmetricMatrix<Scalar> symres = SymmetricMatrix<Scalar>::Zero(dim);
+    SymmetricMatrixScatter<Scalar> scatter(symres, mode, 8);
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < nThreads; ++thread) {
+        threads.push_back(std::thread([&, thread]() {
+            for (int k = 0; k < nContributions; ++k) {
+                scatter.scatterAdd(
+                    contributionIndices(dim, thread, nThreads, k, false),
+                    block);
+            }
+        }));
+    }
+    for (int thread = 0; thread < nThreads; ++thread) {
+        threads[thread].join();
+    }
+
+    if (symres.constructEigenMatrix() == res) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Run several operations asynchronously on the shared pool and compare them
+ * with the synchronous operators
+ */
+template<typename Scalar, int Dimension>
+int TEST_ASYNC(const Eigen::Matrix<Scalar, Dimension, Dimension>& mat1,
+               const Eigen::Matrix<Scalar, Dimension, Dimension>& mat2) {
+    SymmetricMatrix<Scalar, Dimension> symmat1(mat1);
+    SymmetricMatrix<Scalar, Dimension> symmat2(mat2);
+
+    // Start everything before waiting for any result
+    auto sum = addAsync(symmat1, symmat2);
+    auto diff = subtractAsync(symmat1, mat2);
+    auto prod = multiplyAsync(symmat1, symmat2);
+    auto llt = factorizeAsync(symmat1);
+    auto inv = inverseAsync(symmat1);
+    auto trace = runAsync([symmat2]() mutable {
+        return symmat2.constructEigenMatrix().trace();
+    });
+
+    Eigen::Matrix<Scalar, Dimension, Dimension> identity = mat1 * mat1;
+    identity.setIdentity();
+    if (sum.get().constructEigenMatrix() != mat1 + mat2
+        || diff.get() != mat1 - mat2
+        || !Eigen::Matrix<Scalar, Dimension, Dimension>(prod.get())
+               .isApprox(mat1 * mat2)
+        || llt.get().info() != Eigen::Success
+        || !(inv.get().constructEigenMatrix() * mat1).isApprox(identity)
+        || trace.get() != mat2.trace()) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Asynchronous sums and products with Eigen vectors and matrices, which are
+ * evaluated on the pool
+ */
+template<typename Scalar>
+int TEST_ASYNC_EIGEN(int dim) {
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> Matrix;
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> Vector;
+    const Matrix mat = randomPositiveDefinite<Scalar, -1>(dim);
+    const Matrix other = Matrix::Random(dim, dim);
+    const Vector x = Vector::Random(dim);
+    const Vector three = Vector::Constant(1, Scalar(3));
+    const SymmetricMatrix<Scalar> symmat(mat);
+    const SymmetricMatrix<Scalar> scalar(Matrix::Constant(1, 1, Scalar(2)));
+
+    auto prodVector = multiplyAsync(symmat, x);
+    auto prodMatrix = multiplyAsync(symmat, other);
+    auto sumVector = addAsync(scalar, three);
+    auto sumMatrix = addAsync(symmat, other);
+
+    const Vector y = prodVector.get();
+    const Matrix p = prodMatrix.get();
+    const Matrix s = sumMatrix.get();
+    if (!y.isApprox(mat * x) || !p.isApprox(mat * other)
+        || sumVector.get()(0, 0) != Scalar(5) || s != mat + other) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Multithreaded product of a packed symmetric matrix with a vector, directly
+ * and through the lazy product Eigen's iterative solvers use
+ */
+template<typename Scalar, typename ComputeScalar>
+int TEST_OPERATOR_PRODUCT(int dim, int nThreads) {
+    typedef Eigen::Matrix<ComputeScalar, -1, 1> Vector;
+    Eigen::Matrix<Scalar, -1, -1> mat
+        = Eigen::Matrix<Scalar, -1, -1>::Random(dim, dim);
+    mat = (mat + mat.transpose()).eval();
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> sym(mat);
+    SymmetricMatrixOperator<Scalar, ComputeScalar> op(sym, nThreads);
+    const Vector x = Vector::Random(dim);
+    const Vector expected = mat.template cast<ComputeScalar>() * x;
+    Vector y;
+    op.multiply(x, y);
+    const Vector z = op * x;
+    const ComputeScalar precision
+        = Eigen::NumTraits<ComputeScalar>::dummy_precision();
+    return (y.isApprox(expected, precision) && z.isApprox(expected, precision)
+            && op.diagonal().isApprox(mat.diagonal()
+                .template cast<ComputeScalar>())) ? 0 : 1;
+}
+
+/**
+ * Eigen::ConjugateGradient on a badly scaled positive definite matrix in
+ * packed storage. The Jacobi preconditioner removes the scaling, so it
+ * converges in fewer iterations than without preconditioning.
+ */
+template<typename Scalar, typename ComputeScalar>
+int TEST_CONJUGATE_GRADIENT(int dim, int nThreads) {
+    typedef Eigen::Matrix<ComputeScalar, -1, 1> Vector;
+    typedef SymmetricMatrixOperator<Scalar, ComputeScalar> Operator;
+    Eigen::Matrix<Scalar, -1, -1> mat
+        = randomPositiveDefinite<Scalar, -1>(dim, Scalar(dim));
+    for (int i = 0; i < dim; ++i) {
+        const Scalar scale = Scalar(1 + i % 10 * 10);
+        mat.row(i) *= scale;
+        mat.col(i) *= scale;
+    }
+    SymmetricMatrix<Scalar, Eigen::Dynamic, ComputeScalar> sym(mat);
+    Operator op(sym, nThreads);
+    const Vector b = Vector::Random(dim);
+
+    Eigen::ConjugateGradient<Operator, Eigen::Lower | Eigen::Upper,
+                             SymmetricJacobiPreconditioner<ComputeScalar> >
+        jacobi;
+    Eigen::ConjugateGradient<Operator, Eigen::Lower | Eigen::Upper,
+                             Eigen::IdentityPreconditioner> identity;
+    jacobi.setTolerance(ComputeScalar(1e-10));
+    identity.setTolerance(ComputeScalar(1e-10));
+    jacobi.compute(op);
+    identity.compute(op);
+    const Vector x = jacobi.solve(b);
+    const Vector unpreconditioned = identity.solve(b);
+    const ComputeScalar residual
+        = (mat.template cast<ComputeScalar>() * x - b).norm() / b.norm();
+    return (jacobi.info() == Eigen::Success && residual < ComputeScalar(1e-8)
+            && jacobi.iterations() < identity.iterations()) ? 0 : 1;
+}
+
+int main() {
+    std::cout << "Testing accumulation...\n";
+    std::cout << "[TEST_ACCUMULATE][int][Dense][1000][1]"
+              << ((!TEST_ACCUMULATE<int>(1000, 1, DenseAccumulation, false))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_ACCUMULATE][int][Dense][1000][7]"
+              << ((!TEST_ACCUMULATE<int>(1000, 7, DenseAccumulation, false))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_ACCUMULATE][double][Dense][1000][8]"
+              << ((!TEST_ACCUMULATE<double>(1000, 8, DenseAccumulation, false))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_ACCUMULATE][int][SparseTouch][1000][7]"
+              << ((!TEST_ACCUMULATE<int>(1000, 7, SparseTouchAccumulation, false))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_ACCUMULATE][double][SparseTouch][1000][8][disjoint]"
+              << ((!TEST_ACCUMULATE<double>(1000, 8, SparseTouchAccumulation, true))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_ACCUMULATE][float][SparseTouch][50][3]"
+              << ((!TEST_ACCUMULATE<float>(50, 3, SparseTouchAccumulation, false))?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing scatter-add...\n";
+    std::cout << "[TEST_SCATTER][int][StripedLock][1000][7]"
+              << ((!TEST_SCATTER<int>(1000, 7, StripedLockScatter))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_SCATTER][double][StripedLock][1000][8]"
+              << ((!TEST_SCATTER<double>(1000, 8, StripedLockScatter))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_SCATTER][int][Atomic][1000][7]"
+              << ((!TEST_SCATTER<int>(1000, 7, AtomicScatter))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_SCATTER][double][Atomic][1000][8]"
+              << ((!TEST_SCATTER<double>(1000, 8, AtomicScatter))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_SCATTER][float][Atomic][50][3]"
+              << ((!TEST_SCATTER<float>(50, 3, AtomicScatter))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_SCATTER][std::complex<double>][Atomic][50][3]"
+              << ((!TEST_SCATTER<std::complex<double> >(50, 3, AtomicScatter))?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing asynchronous operations...\n";
+    std::cout << "[TEST_ASYNC][double][5]"
+              << ((!TEST_ASYNC<double, 5>(randomPositiveDefinite<double, 5>(5), randomPositiveDefinite<double, 5>(5)))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_ASYNC][double][Dynamic][100]"
+              << ((!TEST_ASYNC<double, -1>(randomPositiveDefinite<double, -1>(100), randomPositiveDefinite<double, -1>(100)))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_ASYNC][float][Dynamic][50]"
+              << ((!TEST_ASYNC<float, -1>(randomPositiveDefinite<float, -1>(50), randomPositiveDefinite<float, -1>(50)))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_ASYNC_EIGEN][double][Dynamic][100]"
+              << ((!TEST_ASYNC_EIGEN<double>(100))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_ASYNC_EIGEN][float][Dynamic][20]"
+              << ((!TEST_ASYNC_EIGEN<float>(20))?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing matrix-free operator...\n";
+    std::cout << "[TEST_OPERATOR_PRODUCT][double][1000][8]"
+              << ((!TEST_OPERATOR_PRODUCT<double, double>(1000, 8))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_OPERATOR_PRODUCT][float][101][4]"
+              << ((!TEST_OPERATOR_PRODUCT<float, float>(101, 4))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_OPERATOR_PRODUCT][float/double][1000][3]"
+              << ((!TEST_OPERATOR_PRODUCT<float, double>(1000, 3))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CONJUGATE_GRADIENT][double][1000][8]"
+              << ((!TEST_CONJUGATE_GRADIENT<double, double>(1000, 8))?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CONJUGATE_GRADIENT][float/double][500][4]"
+              << ((!TEST_CONJUGATE_GRADIENT<float, double>(500, 4))?" => PASSED\n":" => FAIL\n");
+}
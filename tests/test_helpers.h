@@ -0,0 +1,38 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Test helpers                                                               *
+ *  Random input shared by the tests                                           *
+*******************************************************************************/
+
+#ifndef GSOC_SYMMAT_TEST_HELPERS_H
+#define GSOC_SYMMAT_TEST_HELPERS_H
+
+#include <eigen3/Eigen/Eigen>
+
+/**
+ * Make an instance of Eigen::Matrix symmetric and positive definite
+ *
+ * \param dim Dimension, only needed if Dimension is Eigen::Dynamic
+ * \param shift Value added to the diagonal of M M^T for a random M, a larger
+ * shift gives a better conditioned matrix
+ */
+template<typename Scalar, int Dimension>
+Eigen::Matrix<Scalar, Dimension, Dimension>
+randomPositiveDefinite(int dim = Dimension, Scalar shift = Scalar(1)) {
+    Eigen::Matrix<Scalar, Dimension, Dimension> mat
+        = Eigen::Matrix<Scalar, Dimension, Dimension>::Random(dim, dim);
+    mat = mat * mat.transpose();
+    mat.diagonal().array() += shift;
+    for (int i = 0; i < mat.rows(); ++i) {
+        for (int j = i; j < mat.cols(); ++j) {
+            mat(i, j) = mat(j, i);
+        }
+    }
+    return mat;
+}
+
+#endif /* GSOC_SYMMAT_TEST_HELPERS_H */
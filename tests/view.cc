@@ -0,0 +1,148 @@
+/*******************************************************************************
+ *  This file is part of the evaluation test of the Google Summer of Code 2018 *
+ *  project "Faster Matrix Algebra for ATLAS".                                 *
+ *                                                                             *
+ *  David A. Tellenbach <tellenbach@cip.ifi.lmu.de>                            *
+ *                                                                             *
+ *  Test - View                                                                *
+ *  Principal submatrix views of instances of SymmetricMatrix                  *
+ ******************************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include <SymmetricMatrix.h>
+#include <eigen3/Eigen/Eigen>
+
+/**
+ * Make an instance of Eigen::Matrix symmetric
+ */
+template<typename Scalar, int Dimension>
+void makeSymmetric(Eigen::Matrix<Scalar, Dimension, Dimension>& mat) {
+    for (int i = 0; i < mat.rows(); ++i) {
+        for (int j = i; j < mat.cols(); ++j) {
+            mat(i, j) = mat(j, i);
+        }
+    }
+}
+
+/**
+ * Principal submatrix of an Eigen::Matrix
+ */
+template<typename Scalar, int Dimension>
+Eigen::Matrix<Scalar, -1, -1>
+principal(const Eigen::Matrix<Scalar, Dimension, Dimension>& mat,
+          const std::vector<int>& indices) {
+    Eigen::Matrix<Scalar, -1, -1> ret(indices.size(), indices.size());
+    for (size_t a = 0; a < indices.size(); ++a) {
+        for (size_t b = 0; b < indices.size(); ++b) {
+            ret(a, b) = mat(indices[a], indices[b]);
+        }
+    }
+    return ret;
+}
+
+/**
+ * Top left corner of a symmetric matrix of fixed size copied into symmetric
+ * matrices of fixed and dynamic size
+ */
+template<typename Scalar, int Dimension, int Corner>
+int TEST_CORNER_SYMF() {
+    Eigen::Matrix<Scalar, Dimension, Dimension> mat
+        = Eigen::Matrix<Scalar, Dimension, Dimension>::Random();
+    makeSymmetric<Scalar, Dimension>(mat);
+    const SymmetricMatrix<Scalar, Dimension> sym(mat);
+    SymmetricMatrix<Scalar, Corner> fixed(sym.topLeftCorner(Corner));
+    SymmetricMatrix<Scalar> dyn(sym.topLeftCorner(Corner));
+    Eigen::Matrix<Scalar, Corner, Corner> expected
+        = mat.template topLeftCorner<Corner, Corner>();
+    if (fixed.constructEigenMatrix() != expected
+        || dyn.constructEigenMatrix() != Eigen::Matrix<Scalar, -1, -1>(expected)
+        || sym.topLeftCorner(Corner).constructEigenMatrix()
+            != Eigen::Matrix<Scalar, -1, -1>(expected)) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Principal submatrix of unsorted rows and columns of a symmetric matrix of
+ * dynamic size
+ */
+template<typename Scalar, int Dimension>
+int TEST_PRINCIPAL_SYMD() {
+    Eigen::Matrix<Scalar, -1, -1> mat
+        = Eigen::Matrix<Scalar, -1, -1>::Random(Dimension, Dimension);
+    makeSymmetric<Scalar, -1>(mat);
+    SymmetricMatrix<Scalar> sym(mat);
+    std::vector<int> indices;
+    for (int i = Dimension - 1; i >= 0; i -= 3) {
+        indices.push_back(i);
+    }
+    for (int i = 0; i < Dimension; i += 3) {
+        indices.push_back(i);
+    }
+    SymmetricMatrix<Scalar> sub(sym.principal(indices));
+    if (sub.constructEigenMatrix() != principal<Scalar, -1>(mat, indices)
+        || sym.principal(indices).eval().constructEigenMatrix()
+            != principal<Scalar, -1>(mat, indices)) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Writing through views of a symmetric matrix of fixed size
+ */
+template<typename Scalar, int Dimension>
+int TEST_ASSIGN_VIEW() {
+    Eigen::Matrix<Scalar, Dimension, Dimension> mat
+        = Eigen::Matrix<Scalar, Dimension, Dimension>::Random();
+    makeSymmetric<Scalar, Dimension>(mat);
+    Eigen::Matrix<Scalar, 3, 3> block = Eigen::Matrix<Scalar, 3, 3>::Random();
+    makeSymmetric<Scalar, 3>(block);
+    SymmetricMatrix<Scalar, Dimension> sym(mat);
+    SymmetricMatrix<Scalar, 3> symBlock(block);
+    std::vector<int> indices;
+    indices.push_back(Dimension - 1);
+    indices.push_back(0);
+    indices.push_back(2);
+
+    sym.principal(indices) += symBlock;
+    sym.principal(indices)(0, 1) = Scalar(7);
+    sym.topLeftCorner(2) = sym.principal(indices).eval().topLeftCorner(2)
+        .eval();
+    for (int a = 0; a < 3; ++a) {
+        for (int b = 0; b < 3; ++b) {
+            mat(indices[a], indices[b]) += block(a, b);
+        }
+    }
+    mat(Dimension - 1, 0) = mat(0, Dimension - 1) = Scalar(7);
+    Eigen::Matrix<Scalar, 2, 2> corner;
+    corner << mat(Dimension - 1, Dimension - 1), mat(Dimension - 1, 0),
+              mat(0, Dimension - 1), mat(0, 0);
+    mat.template topLeftCorner<2, 2>() = corner;
+    return sym.constructEigenMatrix() != mat;
+}
+
+int main() {
+    std::cout << "Testing top left corner...\n";
+    std::cout << "[TEST_CORNER_SYMF][int][5][2]"
+              << ((!TEST_CORNER_SYMF<int, 5, 2>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CORNER_SYMF][double][6][3]"
+              << ((!TEST_CORNER_SYMF<double, 6, 3>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_CORNER_SYMF][float][10][10]"
+              << ((!TEST_CORNER_SYMF<float, 10, 10>())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing principal submatrix...\n";
+    std::cout << "[TEST_PRINCIPAL_SYMD][int][10]"
+              << ((!TEST_PRINCIPAL_SYMD<int, 10>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_PRINCIPAL_SYMD][double][100]"
+              << ((!TEST_PRINCIPAL_SYMD<double, 100>())?" => PASSED\n":" => FAIL\n");
+
+    std::cout << "Testing assignment to views...\n";
+    std::cout << "[TEST_ASSIGN_VIEW][int][5]"
+              << ((!TEST_ASSIGN_VIEW<int, 5>())?" => PASSED\n":" => FAIL\n");
+    std::cout << "[TEST_ASSIGN_VIEW][double][6]"
+              << ((!TEST_ASSIGN_VIEW<double, 6>())?" => PASSED\n":" => FAIL\n");
+}